@@ -43,6 +43,179 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 ClassImp(Config)
 
+namespace
+{
+  /// Identifier at the start of every compiled configuration file.
+  const std::string compiledConfigTag = "REBDSIMCOMPILEDCONFIG";
+  /// Version of the binary layout. Increment when the layout changes.
+  const int compiledConfigVersion = 1;
+  /// Extension expected for compiled configuration files.
+  const std::string compiledConfigExtension = ".rbdscfg";
+
+  template <typename T>
+  void WriteBinary(std::ostream& out, const T& value)
+  {out.write(reinterpret_cast<const char*>(&value), sizeof(T));}
+
+  void WriteBinary(std::ostream& out, const std::string& value)
+  {
+    WriteBinary(out, (unsigned long long)value.size());
+    out.write(value.data(), (std::streamsize)value.size());
+  }
+
+  void WriteBinary(std::ostream& out, const std::vector<std::string>& values)
+  {
+    WriteBinary(out, (unsigned long long)values.size());
+    for (const auto& value : values)
+      {WriteBinary(out, value);}
+  }
+
+  template <typename T>
+  void ReadBinary(std::istream& in, T& value)
+  {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!in)
+      {throw RBDSException("Config::LoadCompiledConfig>", "compiled configuration file is truncated");}
+  }
+
+  void ReadBinary(std::istream& in, std::string& value)
+  {
+    unsigned long long size = 0;
+    ReadBinary(in, size);
+    value.resize(size);
+    in.read(&value[0], (std::streamsize)size);
+    if (!in)
+      {throw RBDSException("Config::LoadCompiledConfig>", "compiled configuration file is truncated");}
+  }
+
+  void ReadBinary(std::istream& in, std::vector<std::string>& values)
+  {
+    unsigned long long size = 0;
+    ReadBinary(in, size);
+    values.resize(size);
+    for (auto& value : values)
+      {ReadBinary(in, value);}
+  }
+
+  /// Bin edges are always stored when present so edges files are not needed again.
+  void WriteBinary(std::ostream& out, const BinSpecification& binning)
+  {
+    WriteBinary(out, binning.low);
+    WriteBinary(out, binning.high);
+    WriteBinary(out, binning.n);
+    WriteBinary(out, binning.isLogSpaced);
+    WriteBinary(out, binning.edgesFileName);
+    bool hasEdges = binning.edges != nullptr;
+    WriteBinary(out, hasEdges);
+    if (hasEdges)
+      {
+        WriteBinary(out, (unsigned long long)binning.edges->size());
+        out.write(reinterpret_cast<const char*>(binning.edges->data()),
+                  (std::streamsize)(binning.edges->size() * sizeof(double)));
+      }
+  }
+
+  void ReadBinary(std::istream& in, BinSpecification& binning)
+  {
+    ReadBinary(in, binning.low);
+    ReadBinary(in, binning.high);
+    ReadBinary(in, binning.n);
+    ReadBinary(in, binning.isLogSpaced);
+    ReadBinary(in, binning.edgesFileName);
+    bool hasEdges = false;
+    ReadBinary(in, hasEdges);
+    if (hasEdges)
+      {
+        unsigned long long size = 0;
+        ReadBinary(in, size);
+        auto edges = new std::vector<double>(size);
+        in.read(reinterpret_cast<char*>(edges->data()), (std::streamsize)(size * sizeof(double)));
+        if (!in)
+          {
+            delete edges;
+            throw RBDSException("Config::LoadCompiledConfig>", "compiled configuration file is truncated");
+          }
+        binning.edges = edges;
+      }
+  }
+
+  void WriteHistogramDef(std::ostream& out, const HistogramDef* def)
+  {
+    if (def->nDimensions < 1 || def->nDimensions > 3)
+      {throw RBDSException("Config::WriteCompiledConfig>", "unsupported histogram dimension for \"" + def->histName + "\"");}
+    WriteBinary(out, def->nDimensions);
+    WriteBinary(out, def->treeName);
+    WriteBinary(out, def->histName);
+    WriteBinary(out, def->variable);
+    WriteBinary(out, def->selection);
+    WriteBinary(out, def->perEntry);
+    WriteBinary(out, static_cast<const HistogramDef1D*>(def)->xBinning);
+    if (def->nDimensions > 1)
+      {WriteBinary(out, static_cast<const HistogramDef2D*>(def)->yBinning);}
+    if (def->nDimensions > 2)
+      {WriteBinary(out, static_cast<const HistogramDef3D*>(def)->zBinning);}
+  }
+
+  HistogramDef* ReadHistogramDef(std::istream& in)
+  {
+    int nDim = 0;
+    std::string treeName;
+    std::string histName;
+    std::string variable;
+    std::string selection;
+    bool perEntry = true;
+    ReadBinary(in, nDim);
+    ReadBinary(in, treeName);
+    ReadBinary(in, histName);
+    ReadBinary(in, variable);
+    ReadBinary(in, selection);
+    ReadBinary(in, perEntry);
+
+    BinSpecification xBinning;
+    BinSpecification yBinning;
+    BinSpecification zBinning;
+    switch (nDim)
+      {
+      case 1:
+        {
+          ReadBinary(in, xBinning);
+          return new HistogramDef1D(treeName, histName, xBinning, variable, selection, perEntry);
+        }
+      case 2:
+        {
+          ReadBinary(in, xBinning);
+          ReadBinary(in, yBinning);
+          return new HistogramDef2D(treeName, histName, xBinning, yBinning, variable, selection, perEntry);
+        }
+      case 3:
+        {
+          ReadBinary(in, xBinning);
+          ReadBinary(in, yBinning);
+          ReadBinary(in, zBinning);
+          return new HistogramDef3D(treeName, histName, xBinning, yBinning, zBinning, variable, selection, perEntry);
+        }
+      default:
+        {throw RBDSException("Config::LoadCompiledConfig>", "invalid histogram dimension in compiled configuration file");}
+      }
+  }
+
+  /// Simple FNV-1a hash of a text file's contents used to spot a compiled
+  /// configuration that is out of date with respect to its source. 0 if unreadable.
+  unsigned long long FileFingerprint(const std::string& fileName)
+  {
+    std::ifstream f(fileName.c_str(), std::ios::binary);
+    if (!f)
+      {return 0;}
+    unsigned long long hash = 14695981039346656037ULL;
+    char c;
+    while (f.get(c))
+      {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+      }
+    return hash;
+  }
+}
+
 Config* Config::instance = nullptr;
 
 std::vector<std::string> Config::treeNames = {"Beam.", "Options.", "Model.", "Run.", "Event."};
@@ -77,7 +250,10 @@ Config::Config(const std::string& fileNameIn,
                const std::string& defaultOutputFileSuffix)
 {
   InitialiseOptions(fileNameIn);
-  ParseInputFile();
+  if (IsCompiledConfigFileName(fileNameIn))
+    {LoadCompiledConfig();}
+  else
+    {ParseInputFile();}
 
   if (!inputFilePathIn.empty())
     {optionsString["inputfilepath"] = inputFilePathIn;}
@@ -131,15 +307,19 @@ void Config::InitialiseOptions(const std::string& analysisFile)
   optionsBool["processsamplers"]   = false;
   optionsBool["backwardscompatible"] = false; // ignore file types for old data
   optionsBool["verbosespectra"]    = false;
+  optionsBool["validatedatasetonce"] = false; // only check the first file of the input
 
   optionsString["inputfilepath"]  = "";
   optionsString["outputfilename"] = "";
   optionsString["opticsfilename"] = "";
   optionsString["gdmlfilename"]   = "";
+  optionsString["compiledconfigfilename"] = "";
 
   optionsNumber["printmodulofraction"] = 0.01;
   optionsNumber["eventstart"]          = 0;
   optionsNumber["eventend"]            = -1;
+  optionsNumber["nthreads"]            = 1;
+  optionsNumber["eventsperblock"]      = 1000;
 
   // ensure keys exist for all trees.
   for (const auto& name : treeNames)
@@ -244,6 +424,201 @@ void Config::ParseInputFile()
   if (eS < 0 || eS > eE)
     {throw RBDSException("Invalid starting event number " + std::to_string(eS));}
 
+  if (optionsNumber.at("nthreads") < 0)
+    {throw RBDSException("Invalid number of threads " + std::to_string(optionsNumber.at("nthreads")));}
+  if (optionsNumber.at("eventsperblock") < 1)
+    {throw RBDSException("Invalid number of events per block " + std::to_string(optionsNumber.at("eventsperblock")));}
+
+  if (optionsBool.at("verbosespectra"))
+    {PrintHistogramSetDefinitions();}
+
+  const std::string& compiledFileName = optionsString.at("compiledconfigfilename");
+  if (!compiledFileName.empty())
+    {WriteCompiledConfig(compiledFileName);}
+}
+
+bool Config::IsCompiledConfigFileName(const std::string& fileName)
+{
+  std::size_t n = compiledConfigExtension.size();
+  return fileName.size() > n && fileName.compare(fileName.size() - n, n, compiledConfigExtension) == 0;
+}
+
+void Config::WriteCompiledConfig(const std::string& fileName) const
+{
+  if (!IsCompiledConfigFileName(fileName))
+    {throw RBDSException("Config::WriteCompiledConfig>", "compiled configuration file name \"" + fileName + "\" must end in \"" + compiledConfigExtension + "\"");}
+  
+  std::ofstream out(fileName.c_str(), std::ios::binary);
+  if (!out)
+    {throw RBDSException("Config::WriteCompiledConfig>", "could not open \"" + fileName + "\" for writing");}
+
+  const std::string& analysisFile = optionsString.at("analysisfile");
+  WriteBinary(out, compiledConfigTag);
+  WriteBinary(out, compiledConfigVersion);
+  WriteBinary(out, analysisFile);
+  WriteBinary(out, FileFingerprint(analysisFile));
+
+  WriteBinary(out, (unsigned long long)optionsBool.size());
+  for (const auto& kv : optionsBool)
+    {WriteBinary(out, kv.first); WriteBinary(out, kv.second);}
+  WriteBinary(out, (unsigned long long)optionsString.size());
+  for (const auto& kv : optionsString)
+    {// don't propagate the request to write so loading never writes a copy of itself
+      WriteBinary(out, kv.first);
+      WriteBinary(out, kv.first == "compiledconfigfilename" ? std::string() : kv.second);
+    }
+  WriteBinary(out, (unsigned long long)optionsNumber.size());
+  for (const auto& kv : optionsNumber)
+    {WriteBinary(out, kv.first); WriteBinary(out, kv.second);}
+
+  // histoDefs always has a key for every tree name, in the same order
+  for (const auto& treeName : treeNames)
+    {
+      const auto& defs = histoDefs.at(treeName);
+      WriteBinary(out, (unsigned long long)defs.size());
+      for (const auto* def : defs)
+        {WriteHistogramDef(out, def);}
+    }
+
+  for (const auto* sets : {&eventHistoDefSetsSimple, &eventHistoDefSetsPerEntry})
+    {
+      WriteBinary(out, (unsigned long long)sets->size());
+      for (const auto* set : *sets)
+        {
+          WriteBinary(out, set->branchName);
+          WriteHistogramDef(out, set->baseDefinition);
+          WriteBinary(out, set->particleSpecification);
+          WriteBinary(out, set->definitionLine);
+          WriteBinary(out, (unsigned long long)set->definitions.size());
+          for (const auto& kv : set->definitions)
+            {
+              WriteBinary(out, kv.first.first);
+              WriteBinary(out, (int)kv.first.second);
+            }
+        }
+    }
+
+  WriteBinary(out, eventParticleSetBranches);
+  WriteBinary(out, eventParticleSetSimpleBranches);
+
+  for (const auto& treeName : treeNames)
+    {WriteBinary(out, branches.at(treeName));}
+
+  if (!out)
+    {throw RBDSException("Config::WriteCompiledConfig>", "problem writing \"" + fileName + "\"");}
+  std::cout << "Config::WriteCompiledConfig> written compiled configuration to \"" << fileName << "\"" << std::endl;
+}
+
+void Config::LoadCompiledConfig()
+{
+  std::string fn = optionsString.at("analysisfile");
+  std::ifstream in(fn.c_str(), std::ios::binary);
+  if (!in)
+    {throw RBDSException("Config::LoadCompiledConfig>", "could not open compiled configuration file \"" + fn + "\"");}
+
+  // check the tag without reading an arbitrary length from a file that may be anything
+  std::string tag(compiledConfigTag.size() + sizeof(unsigned long long), '\0');
+  in.read(&tag[0], (std::streamsize)tag.size());
+  if (!in || tag.compare(sizeof(unsigned long long), std::string::npos, compiledConfigTag) != 0)
+    {throw RBDSException("Config::LoadCompiledConfig>", "\"" + fn + "\" is not a compiled rebdsim configuration file");}
+  int version = 0;
+  ReadBinary(in, version);
+  if (version != compiledConfigVersion)
+    {
+      std::string err = "\"" + fn + "\" was written with compiled configuration version " + std::to_string(version);
+      err += " but this version of rebdsim uses version " + std::to_string(compiledConfigVersion) + " - recompile it from the text configuration";
+      throw RBDSException("Config::LoadCompiledConfig>", err);
+    }
+
+  std::string sourceFile;
+  unsigned long long sourceFingerprint = 0;
+  ReadBinary(in, sourceFile);
+  ReadBinary(in, sourceFingerprint);
+  // the source is often not present (e.g. on a farm node) so only check if it is
+  unsigned long long currentFingerprint = FileFingerprint(sourceFile);
+  if (currentFingerprint != 0 && currentFingerprint != sourceFingerprint)
+    {std::cout << "Config::LoadCompiledConfig> WARNING: \"" << sourceFile << "\" has changed since \"" << fn << "\" was compiled from it" << std::endl;}
+
+  unsigned long long n = 0;
+  ReadBinary(in, n);
+  for (unsigned long long i = 0; i < n; ++i)
+    {
+      std::string key;
+      bool value = false;
+      ReadBinary(in, key);
+      ReadBinary(in, value);
+      optionsBool[key] = value;
+    }
+  ReadBinary(in, n);
+  for (unsigned long long i = 0; i < n; ++i)
+    {
+      std::string key;
+      std::string value;
+      ReadBinary(in, key);
+      ReadBinary(in, value);
+      optionsString[key] = value;
+    }
+  ReadBinary(in, n);
+  for (unsigned long long i = 0; i < n; ++i)
+    {
+      std::string key;
+      double value = 0;
+      ReadBinary(in, key);
+      ReadBinary(in, value);
+      optionsNumber[key] = value;
+    }
+  optionsString["analysisfile"] = fn;
+
+  for (const auto& treeName : treeNames)
+    {
+      ReadBinary(in, n);
+      for (unsigned long long i = 0; i < n; ++i)
+        {
+          HistogramDef* def = ReadHistogramDef(in);
+          histoDefs[treeName].push_back(def);
+          if (def->perEntry)
+            {histoDefsPerEntry[treeName].push_back(def);}
+          else
+            {histoDefsSimple[treeName].push_back(def);}
+          histogramNames.insert(def->histName);
+        }
+    }
+
+  for (auto* sets : {&eventHistoDefSetsSimple, &eventHistoDefSetsPerEntry})
+    {
+      ReadBinary(in, n);
+      for (unsigned long long i = 0; i < n; ++i)
+        {
+          std::string branchName;
+          std::string particleSpecification;
+          std::string definitionLine;
+          ReadBinary(in, branchName);
+          HistogramDef* def = ReadHistogramDef(in);
+          ReadBinary(in, particleSpecification);
+          ReadBinary(in, definitionLine);
+          unsigned long long nParticles = 0;
+          ReadBinary(in, nParticles);
+          std::set<ParticleSpec> particles;
+          for (unsigned long long j = 0; j < nParticles; ++j)
+            {
+              long long int id = 0;
+              int which = 0;
+              ReadBinary(in, id);
+              ReadBinary(in, which);
+              particles.insert(ParticleSpec(id, static_cast<RBDS::SpectraParticles>(which)));
+            }
+          sets->push_back(new HistogramDefSet(branchName, def, particles, particleSpecification, definitionLine));
+          delete def; // copied by the set
+        }
+    }
+
+  ReadBinary(in, eventParticleSetBranches);
+  ReadBinary(in, eventParticleSetSimpleBranches);
+
+  for (const auto& treeName : treeNames)
+    {ReadBinary(in, branches[treeName]);}
+
+  std::cout << "Config::LoadCompiledConfig> loaded configuration compiled from \"" << sourceFile << "\"" << std::endl;
   if (optionsBool.at("verbosespectra"))
     {PrintHistogramSetDefinitions();}
 }
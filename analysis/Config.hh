@@ -81,6 +81,14 @@ public:
 
   void ParseInputFile();
 
+  /// Write the fully parsed configuration (options, histogram definitions including
+  /// all bin edges, spectra and particle sets and the branches to activate) to a binary
+  /// file that can be given to rebdsim instead of the text file and loaded without parsing.
+  void WriteCompiledConfig(const std::string& fileName) const;
+
+  /// Whether a file name has the extension used for compiled configuration files.
+  static bool IsCompiledConfigFileName(const std::string& fileName);
+
   /// @{ General accessor for option.
   inline std::string GetOptionString(const std::string& key) const {return optionsString.at(key);}
   inline bool        GetOptionBool(const std::string& key)   const {return optionsBool.at(key);}
@@ -130,6 +138,7 @@ public:
   inline bool   EmittanceOnTheFly() const         {return optionsBool.at("emittanceonthefly");}
   inline bool   ProcessSamplers() const           {return optionsBool.at("processsamplers");}
   inline bool   PrintOut() const                  {return optionsBool.at("printout");}
+  inline bool   ValidateDatasetOnce() const       {return optionsBool.at("validatedatasetonce");}
   inline double PrintModuloFraction() const       {return optionsNumber.at("printmodulofraction");}
   /// @}
   /// @{ Whether per entry loading is needed. Alternative is only TTree->Draw().
@@ -169,6 +178,10 @@ public:
   /// always be accessed.
   void InitialiseOptions(const std::string& analysisFile);
 
+  /// Load the configuration from a compiled configuration file written by
+  /// WriteCompiledConfig() instead of parsing a text file.
+  void LoadCompiledConfig();
+
   /// Parse a line beginning with histogram. Uses other functions if appropriately defined.
   void ParseHistogramLine(const std::string& line);
 
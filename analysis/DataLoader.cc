@@ -49,12 +49,14 @@ DataLoader::DataLoader(const std::string& fileName,
                        bool        processSamplersIn,
                        bool        allBranchesOnIn,
                        const RBDS::BranchMap* branchesToTurnOnIn,
-                       bool        backwardsCompatibleIn):
+                       bool        backwardsCompatibleIn,
+                       bool        validateDatasetOnceIn):
   debug(debugIn),
   processSamplers(processSamplersIn),
   allBranchesOn(allBranchesOnIn),
   branchesToTurnOn(branchesToTurnOnIn),
   backwardsCompatible(backwardsCompatibleIn),
+  validateDatasetOnce(validateDatasetOnceIn),
   parChain(nullptr),
   dataVersion(BDSIM_DATA_VERSION)
 {
@@ -160,6 +162,8 @@ void DataLoader::BuildInputFileList(std::string inputPath)
     {
       if (backwardsCompatible)
         {fileNames.push_back(fn);} // don't check if header -> old files don't have this
+      else if (validateDatasetOnce && !fileNames.empty())
+        {fileNames.push_back(fn);} // first file checked and the dataset is assumed to be uniform
       else if (RBDS::IsBDSIMOutputFile(fn, fileDataVersion))
         {
           int value = fileDataVersion ? *fileDataVersion : -1;
@@ -171,6 +175,8 @@ void DataLoader::BuildInputFileList(std::string inputPath)
         {std::cout << fn << " is not a BDSIM output file - skipping!" << std::endl;}
     }
   delete fileDataVersion;
+  if (validateDatasetOnce && !backwardsCompatible && fileNames.size() > 1)
+    {std::cout << "Loading> " << fileNames.size() - 1 << " further files assumed to match \"" << fileNames[0] << "\"" << std::endl;}
   
   if (fileNames.empty())
     {throw RBDSException("DataLoader - No valid files found - check input file path / name");}
@@ -52,14 +52,17 @@ public:
 	     bool        processSamplersIn = true,
 	     bool        allBranchesOn     = true,
 	     const RBDS::BranchMap* branchesToTurnOn = nullptr,
-	     bool        backwardsCompatibleIn = true);
+	     bool        backwardsCompatibleIn = true,
+	     bool        validateDatasetOnceIn = false);
   virtual ~DataLoader();
 
   /// Create an instance of each class in the file to be overlaid by loading
   /// the ROOT file.
   void CommonCtor(const std::string& fileName);
 
-  /// Build up the input file list.
+  /// Build up the input file list. Each file is checked to be a BDSIM output file
+  /// unless validateDatasetOnce is true, in which case only the first valid one is
+  /// and the rest are assumed to be the same.
   void BuildInputFileList(std::string inputPath);
 
   /// Open the first file in the file list and map the trees in it.
@@ -112,6 +115,7 @@ private:
   bool allBranchesOn;
   const RBDS::BranchMap* branchesToTurnOn;
   bool backwardsCompatible;
+  bool validateDatasetOnce;
 
   Header*     hea;
   ParticleData* par;
@@ -148,7 +152,7 @@ private:
 
   int dataVersion; ///< Integer version of data loaded.
 
-  ClassDef(DataLoader, 2);
+  ClassDef(DataLoader, 3);
 };
 
 #endif
@@ -21,6 +21,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSOutputROOTEventLoss.hh"
 #include "BDSOutputROOTEventTrajectory.hh"
 #include "Config.hh"
+#include "DataLoader.hh"
 #include "Event.hh"
 #include "EventAnalysis.hh"
 #include "HistogramMeanFromFile.hh"
@@ -35,11 +36,19 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "TChain.h"
 #include "TDirectory.h"
 #include "TFile.h"
+#include "TROOT.h"
 
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <exception>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <typeinfo>
 #include <vector>
 
 ClassImp(EventAnalysis)
@@ -53,7 +62,10 @@ EventAnalysis::EventAnalysis():
   emittanceOnTheFly(false),
   eventStart(0),
   eventEnd(-1),
-  nEventsToProcess(0)
+  nEventsToProcess(0),
+  nThreads(1),
+  eventsPerBlock(1000),
+  master(nullptr)
 {;}
 
 EventAnalysis::EventAnalysis(Event*   eventIn,
@@ -66,7 +78,9 @@ EventAnalysis::EventAnalysis(Event*   eventIn,
                              bool     emittanceOnTheFlyIn,
                              long int eventStartIn,
                              long int eventEndIn,
-                             const std::string& primaryParticleName):
+                             const std::string& primaryParticleName,
+                             int      nThreadsIn,
+                             long int eventsPerBlockIn):
   Analysis("Event.", chainIn, "EventHistogramsMerged", perEntryAnalysis, debugIn),
   event(eventIn),
   printOut(printOutIn),
@@ -75,8 +89,16 @@ EventAnalysis::EventAnalysis(Event*   eventIn,
   emittanceOnTheFly(emittanceOnTheFlyIn),
   eventStart(eventStartIn),
   eventEnd(eventEndIn),
-  nEventsToProcess(eventEndIn - eventStartIn)
+  nEventsToProcess(eventEndIn - eventStartIn),
+  nThreads(nThreadsIn),
+  eventsPerBlock(eventsPerBlockIn),
+  master(nullptr)
 {
+  if (nThreads < 1) // 0 means all available
+    {nThreads = std::max(1, (int)std::thread::hardware_concurrency());}
+  if (eventsPerBlock < 1)
+    {throw RBDSException("The number of events per block must be at least 1");}
+
   // check we get this right for print out normalisation
   if (eventEndIn == -1)
     {nEventsToProcess = (long int)chainIn->GetEntries();}
@@ -116,6 +138,51 @@ EventAnalysis::EventAnalysis(Event*   eventIn,
   SetPrintModuloFraction(printModuloFraction);
 }
 
+EventAnalysis::EventAnalysis(const EventAnalysis* masterIn,
+                             Event*               eventIn,
+                             TChain*              chainIn):
+  Analysis("Event.", chainIn, "EventHistogramsMerged", masterIn->perEntry, false),
+  event(eventIn),
+  printOut(false),
+  printModulo(1),
+  processSamplers(masterIn->processSamplers),
+  emittanceOnTheFly(masterIn->emittanceOnTheFly),
+  eventStart(0),
+  eventEnd(0),
+  nEventsToProcess(0),
+  nThreads(1),
+  eventsPerBlock(masterIn->eventsPerBlock),
+  master(masterIn)
+{
+  CreateSamplerAnalysesFromMaster();
+  PreparePerEntryHistograms();
+  PreparePerEntryHistogramSets();
+}
+
+EventAnalysis::BlockEntries::~BlockEntries()
+{
+  delete histoSum;
+  for (auto h : perEntryHistograms)
+    {delete h;}
+  for (auto s : perEntryHistogramSets)
+    {delete s;}
+  for (auto sa : samplerAnalyses)
+    {delete sa;}
+}
+
+void EventAnalysis::CreateSamplerAnalysesFromMaster()
+{
+  if (!processSamplers)
+    {return;}
+  // same order as the master so they can be merged by index
+  if (event->UsePrimaries())
+    {samplerAnalyses.push_back(new SamplerAnalysis(event->GetPrimaries()));}
+  for (const auto& sampler : event->Samplers)
+    {samplerAnalyses.push_back(new SamplerAnalysis(sampler));}
+  for (std::size_t i = 0; i < samplerAnalyses.size(); i++)
+    {samplerAnalyses[i]->SetOffsets(master->samplerAnalyses[i]->Offsets());}
+}
+
 void EventAnalysis::Execute()
 {
   std::cout << "Analysis on \"" << treeName << "\" beginning" << std::endl;
@@ -167,6 +234,13 @@ void EventAnalysis::Process()
                 << ") in file(s) -> curtailing to # of entries!" << std::endl;
       eventEnd = entries;
     }
+
+  if (!master && CanProcessInParallel())
+    {
+      ProcessParallel();
+      return;
+    }
+
   bool firstLoop = true;
   for (auto i = (Long64_t)eventStart; i < (Long64_t)eventEnd; ++i)
     {
@@ -210,14 +284,206 @@ void EventAnalysis::Process()
           std::cout << __METHOD_NAME__ << "ntrajectory=" << event->Trajectory->n << std::endl;
         }
       
+      // a block uses the offsets of the master so must not reset them
       if (processSamplers)
-        {ProcessSamplers(firstLoop);}
+        {ProcessSamplers(firstLoop && !master);}
       if (firstLoop)
         {firstLoop = false;} // set to false on first pass of loop
     }
+  if (!master)
+    {std::cout << "\rSampler analysis complete                           " << std::endl;}
+}
+
+bool EventAnalysis::CanProcessInParallel() const
+{
+  if (!Config::Instance() || typeid(*this) != typeid(EventAnalysis))
+    {return false;}
+  for (const auto h : perEntryHistograms)
+    {
+      if (!h->Compiled())
+        {return false;}
+    }
+  for (const auto s : perEntryHistogramSets)
+    {
+      if (s && !s->Compiled())
+        {return false;}
+    }
+  return true;
+}
+
+void EventAnalysis::ProcessParallel()
+{
+  ROOT::EnableThreadSafety();
+
+  // Histograms made in the threads must not be attached to the current directory as
+  // it is shared. The results are attached to the output file when they are written.
+  Bool_t addDirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+
+  // fix the offsets for the power sums from the first event so that the sums
+  // from each block can be merged by addition
+  if (processSamplers)
+    {
+      event->Flush();
+      chain->GetEntry(eventStart);
+      for (auto s : samplerAnalyses)
+        {s->SetOffsetsFromCurrentEntry();}
+    }
+
+  const long int nBlocks  = (eventEnd - eventStart + eventsPerBlock - 1) / eventsPerBlock;
+  const int      nWorkers = (int)std::min((long int)nThreads, nBlocks);
+  std::cout << __METHOD_NAME__ << nBlocks << " blocks of " << eventsPerBlock << " events on "
+            << nWorkers << " threads" << std::endl;
+
+  // each thread loads the data into its own event object from its own chain, even if
+  // there is only one, so the blocks are analysed the same way for any number of threads
+  auto config = Config::Instance();
+  std::vector<DataLoader*> loaders;
+  for (int i = 0; i < nWorkers; i++)
+    {
+      loaders.push_back(new DataLoader(config->InputFilePath(),
+                                       false,
+                                       processSamplers,
+                                       config->AllBranchesToBeActivated(),
+                                       &(config->BranchesToBeActivated()),
+                                       config->GetOptionBool("backwardscompatible"),
+                                       config->ValidateDatasetOnce()));
+    }
+
+  // Finished blocks wait here until all previous ones have been merged. The number
+  // waiting is limited so the memory used does not grow with the number of events.
+  std::vector<BlockEntries*> blocks((std::size_t)nBlocks, nullptr);
+  const long int maxPending = 2 * (long int)nWorkers;
+  long int nextBlock = 0;
+  long int nMerged   = 0;
+  std::exception_ptr error = nullptr;
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  auto worker = [&](DataLoader* dl)
+  {
+    try
+      {
+        // the per entry expressions are compiled once for all the blocks of this thread
+        std::unique_ptr<EventAnalysis> analysis(new EventAnalysis(this, dl->GetEvent(), dl->GetEventTree()));
+        while (true)
+          {
+            long int b = 0;
+            {
+              std::unique_lock<std::mutex> lock(mutex);
+              condition.wait(lock, [&]{return error || nextBlock >= nBlocks || nextBlock < nMerged + maxPending;});
+              if (error || nextBlock >= nBlocks)
+                {return;}
+              b = nextBlock++;
+            }
+            long int blockStart = eventStart + b * eventsPerBlock;
+            long int blockEnd   = std::min(blockStart + eventsPerBlock, eventEnd);
+            BlockEntries* block = analysis->ProcessBlock(blockStart, blockEnd);
+            {
+              std::lock_guard<std::mutex> lock(mutex);
+              blocks[(std::size_t)b] = block;
+            }
+            condition.notify_all();
+          }
+      }
+    catch (...)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error)
+            {error = std::current_exception();}
+        }
+        condition.notify_all();
+      }
+  };
+
+  std::vector<std::thread> threads;
+  for (auto dl : loaders)
+    {threads.emplace_back(worker, dl);}
+
+  // merge strictly in block order so the result is independent of the number of threads
+  for (long int b = 0; b < nBlocks; b++)
+    {
+      BlockEntries* block = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]{return error || blocks[(std::size_t)b];});
+        if (error)
+          {break;}
+        std::swap(block, blocks[(std::size_t)b]);
+      }
+      Merge(block);
+      long int blockEnd = block->blockEnd;
+      delete block;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        nMerged++;
+      }
+      condition.notify_all();
+
+      if (printOut)
+        {
+          std::cout << "\rEvent #" << std::setw(8) << blockEnd << " of " << entries;
+          std::cout.flush();
+        }
+    }
+
+  for (auto& t : threads)
+    {t.join();}
+  for (auto block : blocks)
+    {delete block;} // only left if there was an error
+  for (auto dl : loaders)
+    {delete dl;}
+  TH1::AddDirectory(addDirectory);
+
+  if (error)
+    {std::rethrow_exception(error);}
   std::cout << "\rSampler analysis complete                           " << std::endl;
 }
 
+EventAnalysis::BlockEntries* EventAnalysis::ProcessBlock(long int blockStart,
+                                                        long int blockEnd)
+{
+  eventStart       = blockStart;
+  eventEnd         = blockEnd;
+  nEventsToProcess = blockEnd - blockStart;
+  Process();
+
+  auto block = new BlockEntries();
+  block->blockEnd = blockEnd;
+  std::swap(block->histoSum, histoSum); // made again from the first event of the next block
+  for (auto h : perEntryHistograms)
+    {block->perEntryHistograms.push_back(h->TakeEntries());}
+  for (auto s : perEntryHistogramSets)
+    {block->perEntryHistogramSets.push_back(s ? s->TakeEntries() : nullptr);}
+  std::swap(block->samplerAnalyses, samplerAnalyses);
+  CreateSamplerAnalysesFromMaster();
+  return block;
+}
+
+void EventAnalysis::Merge(BlockEntries* block)
+{
+  if (block->histoSum)
+    {
+      if (!histoSum)
+        {// take the first one rather than merging into an empty copy
+          histoSum = block->histoSum;
+          block->histoSum = nullptr;
+        }
+      else
+        {histoSum->Merge(block->histoSum);}
+    }
+  for (std::size_t i = 0; i < perEntryHistograms.size(); i++)
+    {perEntryHistograms[i]->Merge(block->perEntryHistograms[i]);}
+  for (std::size_t i = 0; i < perEntryHistogramSets.size(); i++)
+    {
+      if (perEntryHistogramSets[i])
+        {perEntryHistogramSets[i]->Merge(block->perEntryHistogramSets[i]);}
+    }
+  for (std::size_t i = 0; i < samplerAnalyses.size(); i++)
+    {samplerAnalyses[i]->Merge(block->samplerAnalyses[i]);}
+}
+
 void EventAnalysis::CheckSpectraBranches()
 {
   for (auto s : perEntryHistogramSets)
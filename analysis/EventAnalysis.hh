@@ -27,7 +27,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 class Event;
 class HistogramDefSet;
+class HistogramMeanFromFile;
+class PerEntryHistogram;
 class PerEntryHistogramSet;
+struct PerEntryHistogramSetEntries;
 class SamplerAnalysis;
 class TChain;
 class TFile;
@@ -57,7 +60,9 @@ public:
                 bool     emittanceOnTheFlyIn = false,
                 long int eventStartIn        = 0,
                 long int eventEndIn          = -1,
-                const std::string& primaryParticleName = "");
+                const std::string& primaryParticleName = "",
+                int      nThreadsIn          = 1,
+                long int eventsPerBlockIn    = 1000);
 
   virtual ~EventAnalysis() noexcept;
 
@@ -65,7 +70,9 @@ public:
   /// have to process the samplers on whether to call Process().
   virtual void Execute();
 
-  /// Operate on each entry in the event tree.
+  /// Operate on each entry in the event tree. If the analysis permits it, the entries
+  /// are processed in blocks on nThreads threads (even if 1) and merged in order, so
+  /// the result is the same for any number of threads.
   virtual void Process();
 
   virtual void SimpleHistograms();
@@ -91,6 +98,49 @@ protected:
   void FillHistogram(HistogramDefSet* definition);
 
 private:
+  /// Entries accumulated for one block of events, taken from the analysis of a thread
+  /// so they can wait to be merged in order while the thread continues.
+  struct BlockEntries
+  {
+    ~BlockEntries();
+
+    long int                                  blockEnd = 0;
+    HistogramMeanFromFile*                    histoSum = nullptr;
+    std::vector<PerEntryHistogram*>           perEntryHistograms;
+    std::vector<PerEntryHistogramSetEntries*> perEntryHistogramSets;
+    std::vector<SamplerAnalysis*>             samplerAnalyses;
+  };
+
+  /// Construct the analysis used by one thread for parallel processing. The per entry
+  /// expressions are compiled once here and used for every block the thread analyses.
+  /// The event and chain must belong to the thread. Settings and the sampler offsets
+  /// are copied from the master.
+  EventAnalysis(const EventAnalysis* masterIn,
+                Event*               eventIn,
+                TChain*              chainIn);
+
+  /// Whether the event loop can be split across threads. TChain::Draw finds histograms
+  /// by name in the current directory so all per entry expressions must be compiled.
+  /// UserProcess() is not called for blocks, so derived classes are always serial.
+  bool CanProcessInParallel() const;
+
+  /// Split the events into blocks of eventsPerBlock that are analysed by nThreads
+  /// threads, each with their own chain. The blocks are merged in order so the result
+  /// does not depend on the number of threads.
+  void ProcessParallel();
+
+  /// Analyse the events [blockStart, blockEnd) with this thread analysis and take
+  /// the entries accumulated, leaving it ready for the next block.
+  BlockEntries* ProcessBlock(long int blockStart,
+                             long int blockEnd);
+
+  /// Make the sampler analyses for a thread with the offsets of the master.
+  void CreateSamplerAnalysesFromMaster();
+
+  /// Combine the accumulated per entry histograms, merged histograms and sampler
+  /// power sums of a block into this analysis. May take ownership of parts of it.
+  void Merge(BlockEntries* block);
+
   /// Set how often to print out information about the event.
   void SetPrintModuloFraction(double fraction);
 
@@ -114,6 +164,9 @@ private:
   long int eventStart;    ///< Event index to start analysis from.
   long int eventEnd;      ///< Event index to end analysis at.
   long int nEventsToProcess; ///< Difference between start and stop.
+  int      nThreads;         ///< Number of threads to process entries with.
+  long int eventsPerBlock;   ///< Number of events per block when processing in parallel.
+  const EventAnalysis* master; //! Analysis this is merged into if used by a thread.
 
   /// Cache of all per entry histogram sets.
   std::vector<PerEntryHistogramSet*> perEntryHistogramSets;
@@ -121,7 +174,7 @@ private:
   /// Map of simple histograms created per histogram set for writing out.
   std::map<HistogramDefSet*, std::vector<TH1*> > simpleSetHistogramOutputs;
   
-  ClassDef(EventAnalysis,2);
+  ClassDef(EventAnalysis,3);
 };
 
 #endif
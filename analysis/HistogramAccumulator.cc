@@ -22,8 +22,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TH3D.h"
+#include "TArrayD.h"
 #include "BDSBH4DBase.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
@@ -130,7 +132,10 @@ HistogramAccumulator::~HistogramAccumulator()
   // deleting histograms removes them from currently open output file
   delete mean;
   delete variance;
-  // leak result here as ROOT annoyingly requires this to be left
+  // leak result here as ROOT annoyingly requires this to be left unless it was
+  // never finished and never attached to a file (e.g. a per-thread accumulator)
+  if (!terminated && nDimensions < 4 && result && !result->GetDirectory())
+    {delete result;}
 }
 
 void HistogramAccumulator::Accumulate(TH1* newValue)
@@ -337,9 +342,155 @@ TH1* HistogramAccumulator::Terminate()
   else
     {result->SetEntries((double)n);}
 
+  terminated = true;
   return result;
 }
 
+void HistogramAccumulator::MergeBinArrays(double*       meanA,
+                                          double*       variA,
+                                          const double* meanB,
+                                          const double* variB,
+                                          int           size,
+                                          double        fraction,
+                                          double        product)
+{
+  if (!meanB || !variB)
+    {// the other entries are all zero
+      for (int i = 0; i < size; ++i)
+        {
+          double delta = -meanA[i];
+          meanA[i] = meanA[i] + delta * fraction;
+          variA[i] = variA[i] + delta * delta * product;
+        }
+      return;
+    }
+  for (int i = 0; i < size; ++i)
+    {
+      double delta = meanB[i] - meanA[i];
+      meanA[i] = meanA[i] + delta * fraction;
+      variA[i] = variA[i] + variB[i] + delta * delta * product;
+    }
+}
+
+void HistogramAccumulator::Merge(const HistogramAccumulator* other)
+{
+  if (!other)
+    {return;}
+  if (other->nDimensions != nDimensions)
+    {throw std::domain_error("Cannot merge accumulators with different numbers of dimensions");}
+  MergeMoments(other->mean, other->variance, other->n);
+}
+
+void HistogramAccumulator::MergeNEmptyEntries(unsigned long i)
+{
+  MergeMoments(nullptr, nullptr, i);
+}
+
+void HistogramAccumulator::MergeMoments(TH1*          otherMean,
+                                        TH1*          otherVari,
+                                        unsigned long nOther)
+{
+  if (nOther == 0)
+    {return;}
+
+  // 'variance' holds the sum of squared deviations from the mean so
+  // for two sets a and b (Chan et al.):
+  // mean = mean_a + delta * n_b / n
+  // vari = vari_a + vari_b + delta^2 * n_a * n_b / n
+  const unsigned long nTotal = n + nOther;
+  const double fraction = (double)nOther / (double)nTotal;
+  const double product  = (double)n * fraction;
+  const bool empty = n == 0; // take other exactly rather than with rounding
+  bool zero = !otherMean || !otherVari;
+
+  auto combine = [&](double mA, double vA, double mB, double vB, double& mOut, double& vOut)
+  {
+    if (empty)
+      {mOut = mB; vOut = vB; return;}
+    double delta = mB - mA;
+    mOut = mA + delta * fraction;
+    vOut = vA + vB + delta * delta * product;
+  };
+
+  double mn = 0;
+  double vr = 0;
+  switch (nDimensions)
+    {
+    case 1:
+    case 2:
+    case 3:
+      {
+        // TH1D, TH2D and TH3D store their bins in one contiguous array so operate on
+        // that directly where possible, which allows the loop to be vectorised
+        TArrayD* mA = dynamic_cast<TArrayD*>(mean);
+        TArrayD* vA = dynamic_cast<TArrayD*>(variance);
+        TArrayD* mB = zero ? nullptr : dynamic_cast<TArrayD*>(otherMean);
+        TArrayD* vB = zero ? nullptr : dynamic_cast<TArrayD*>(otherVari);
+        if (mA && vA && (zero || (mB && vB)) && mA->GetSize() == vA->GetSize())
+          {
+            if (empty && !zero)
+              {
+                std::copy(mB->GetArray(), mB->GetArray() + mA->GetSize(), mA->GetArray());
+                std::copy(vB->GetArray(), vB->GetArray() + vA->GetSize(), vA->GetArray());
+              }
+            else if (!empty)
+              {
+                MergeBinArrays(mA->GetArray(), vA->GetArray(),
+                               zero ? nullptr : mB->GetArray(),
+                               zero ? nullptr : vB->GetArray(),
+                               mA->GetSize(), fraction, product);
+              }
+            break;
+          }
+        
+        // the global bin number covers all dimensions including under and overflow
+        for (int i = 0; i < mean->GetNcells(); ++i)
+          {
+            combine(mean->GetBinContent(i),
+                    variance->GetBinContent(i),
+                    zero ? 0 : otherMean->GetBinContent(i),
+                    zero ? 0 : otherVari->GetBinContent(i),
+                    mn, vr);
+            mean->SetBinContent(i, mn);
+            variance->SetBinContent(i, vr);
+          }
+        break;
+      }
+    case 4:
+      {
+#ifdef USE_BOOST
+        BDSBH4DBase* h1  = dynamic_cast<BDSBH4DBase*>(mean);
+        BDSBH4DBase* h1e = dynamic_cast<BDSBH4DBase*>(variance);
+        BDSBH4DBase* h2  = zero ? nullptr : dynamic_cast<BDSBH4DBase*>(otherMean);
+        BDSBH4DBase* h2e = zero ? nullptr : dynamic_cast<BDSBH4DBase*>(otherVari);
+        for (int j = -1; j <= h1->GetNbinsX(); ++j)
+          {
+            for (int k = -1; k <= h1->GetNbinsY(); ++k)
+              {
+                for (int l = -1; l <= h1->GetNbinsZ(); ++l)
+                  {
+                    for (int e = -1; e <= h1->GetNbinsE(); ++e)
+                      {
+                        combine(h1->At(j,k,l,e),
+                                h1e->At(j,k,l,e),
+                                zero ? 0 : h2->At(j,k,l,e),
+                                zero ? 0 : h2e->At(j,k,l,e),
+                                mn, vr);
+                        h1->Set_BDSBH4D(j,k,l,e, mn);
+                        h1e->Set_BDSBH4D(j,k,l,e, vr);
+                      }
+                  }
+              }
+          }
+        break;
+#endif
+      }
+    default:
+      {break;}
+    }
+  n = nTotal;
+}
+
 void HistogramAccumulator::AccumulateSingleValue(double         oldMean,
                                                  double         oldVari,
                                                  double         x,
@@ -88,9 +88,25 @@ public:
   /// on the mean from the variance for the error in each bin.
   virtual TH1* Terminate();
 
+  /// Combine the means and variances of another accumulator of the same histogram
+  /// and type into this one as if all of its entries had been accumulated here. This
+  /// uses the pairwise update of Chan et al., so that sets of entries accumulated
+  /// separately (e.g. in different threads) may be combined. Derived classes that
+  /// store something different override this.
+  virtual void Merge(const HistogramAccumulator* other);
+
+  /// Combine i entries that are zero in every bin. Unlike AddNEmptyEntries(),
+  /// this is valid even when non-zero entries have already been accumulated.
+  void MergeNEmptyEntries(unsigned long i);
+
   /// Accessor.
   inline TH1* Result() const {return result;}
 
+  /// @{ Accessor.
+  inline const std::string& ResultHistName()  const {return resultHistName;}
+  inline const std::string& ResultHistTitle() const {return resultHistTitle;}
+  /// @}
+
   /// Permit the number of recorded entries to be incremented with zero values,
   /// ie just increment n.
   inline void AddNEmptyEntries(unsigned long i){n += i;}
@@ -113,6 +129,22 @@ protected:
 				     double&       newMean,
 				     double&       newVari) const;
 
+  /// Pairwise combination of contiguous arrays of bins with fraction = n_b / n and
+  /// product = n_a * n_b / n. If meanB or variB is nullptr, the other entries are zero.
+  static void MergeBinArrays(double*       meanA,
+			     double*       variA,
+			     const double* meanB,
+			     const double* variB,
+			     int           size,
+			     double        fraction,
+			     double        product);
+
+  /// Combine nOther entries described by otherMean and otherVari into this
+  /// accumulator. If either is nullptr, the entries are taken to be zero.
+  void MergeMoments(TH1*          otherMean,
+		    TH1*          otherVari,
+		    unsigned long nOther);
+
   int               nDimensions;     ///< Number of dimensions
   unsigned long     n;               ///< Counter.
   bool              terminated;      ///< Whether this instance has been finished.
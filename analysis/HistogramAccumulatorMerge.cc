@@ -22,6 +22,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TH3D.h"
+#include "TArrayD.h"
 #include "BDSBH4DBase.hh"
 
 #include <cmath>
@@ -71,8 +72,11 @@ void HistogramAccumulatorMerge::Accumulate(TH1* newValue)
   unsigned long newTotalEntries = oldEntries + newEntries;
   const double nD     = (double)newEntries;
   const double factor = nD * (nD - 1);
+
+  // skip the bin by bin loops below if the arrays could be used directly
+  bool accumulatedArrays = nDimensions < 4 && AccumulateBinArrays(newValue, oldEntries, newEntries, factor);
   
-  switch (nDimensions)
+  switch (accumulatedArrays ? 0 : nDimensions)
     {
     case 1:
       {
@@ -186,6 +190,54 @@ void HistogramAccumulatorMerge::Accumulate(TH1* newValue)
   n = newTotalEntries; // updated to Terminate() works correctly
 }
 
+bool HistogramAccumulatorMerge::AccumulateBinArrays(TH1*          newValue,
+						    unsigned long nEntriesAccumulated,
+						    unsigned long nEntriesToAccumulate,
+						    double        factor)
+{
+  TArrayD* meanArray = dynamic_cast<TArrayD*>(mean);
+  TArrayD* variArray = dynamic_cast<TArrayD*>(variance);
+  TArrayD* newArray  = dynamic_cast<TArrayD*>(newValue);
+  const TArrayD* newErr2 = newValue->GetSumw2();
+  if (!meanArray || !variArray || !newArray || !newErr2)
+    {return false;}
+  const int size = meanArray->GetSize();
+  if (variArray->GetSize() != size || newArray->GetSize() != size || newErr2->GetSize() != size)
+    {return false;}
+
+  // same as AccumulateSingleValue for each bin
+  double*       m  = meanArray->GetArray();
+  double*       v  = variArray->GetArray();
+  const double* x  = newArray->GetArray();
+  const double* e2 = newErr2->GetArray();
+  const double nA  = (double)nEntriesAccumulated;
+  const double nB  = (double)nEntriesToAccumulate;
+  const double nT  = nA + nB;
+  const double nAB = nA * nB;
+  for (int i = 0; i < size; ++i)
+    {
+      double dMean = x[i] - m[i];
+      m[i] = m[i] + nB * (dMean / nT);
+      v[i] = v[i] + e2[i] * factor + nAB * (dMean * dMean / nT);
+    }
+  return true;
+}
+
+void HistogramAccumulatorMerge::Merge(const HistogramAccumulator* other)
+{
+  HistogramAccumulator::Merge(other);
+  if (nDimensions == 4)
+    {
+      dynamic_cast<BDSBH4DBase*>(mean)->SetEntries_BDSBH4D(n);
+      dynamic_cast<BDSBH4DBase*>(variance)->SetEntries_BDSBH4D(n);
+    }
+  else
+    {
+      mean->SetEntries((double)n);
+      variance->SetEntries((double)n);
+    }
+}
+
 void HistogramAccumulatorMerge::AccumulateSingleValue(double        oldMean,
 						      double        oldVari,
 						      double        x,
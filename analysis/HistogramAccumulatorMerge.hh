@@ -59,6 +59,10 @@ public:
   /// AccumualteSingleValue is different.
   virtual void Accumulate(TH1* newValue);
 
+  /// Combine another partial merge (e.g. of a different set of files) into this one.
+  /// The entries of the mean and variance histograms are updated to the number of events.
+  virtual void Merge(const HistogramAccumulator* other);
+
 protected:
 
   /// This implements a different method from the base class that is used
@@ -73,6 +77,14 @@ protected:
 				     double&       newMean,
 				     double&       newVari) const;
 
+  /// Accumulate directly on the contiguous bin arrays of TH1D, TH2D and TH3D so the loop
+  /// can be vectorised. The squared errors are taken from the sum of weights squared.
+  /// Returns false if the histograms do not have these arrays.
+  bool AccumulateBinArrays(TH1*          newValue,
+			   unsigned long nEntriesAccumulated,
+			   unsigned long nEntriesToAccumulate,
+			   double        factor);
+
   ClassDef(HistogramAccumulatorMerge,1);
 };
 
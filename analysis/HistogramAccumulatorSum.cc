@@ -43,5 +43,14 @@ void HistogramAccumulatorSum::Accumulate(TH1* newValue)
   result->Add(newValue);
 }
 
+void HistogramAccumulatorSum::Merge(const HistogramAccumulator* other)
+{
+  if (other)
+    {result->Add(other->Result());}
+}
+
 TH1* HistogramAccumulatorSum::Terminate()
-{return result;}
+{
+  terminated = true;
+  return result;
+}
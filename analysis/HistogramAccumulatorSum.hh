@@ -52,6 +52,9 @@ public:
   /// Use TH1::Add which works on 1,2 and 3D histograms.
   virtual void Accumulate(TH1* newValue);
 
+  /// Add the result of another partial sum to this one.
+  virtual void Merge(const HistogramAccumulator* other);
+
   /// Simply return the result as it's already the correct result.
   virtual TH1* Terminate();
 
@@ -37,6 +37,7 @@ HistogramDefSet::HistogramDefSet(const std::string&  branchNameIn,
   dynamicallyStoreParticles(particlesSpecs.empty()),
   what(writewhat::all),
   topN(1),
+  particleSpecification(particleSpecificationIn),
   definitionLine(definitionLineIn),
   samplerType(samplertype::plane)
 {
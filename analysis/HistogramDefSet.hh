@@ -69,6 +69,7 @@ public:
   writewhat     what;
   int           topN;
 
+  std::string   particleSpecification; ///< Original particle specification, e.g. {11,-11} or top10.
   std::string   definitionLine; ///< Original definition line purely for print out.
   samplertype samplerType;
 };
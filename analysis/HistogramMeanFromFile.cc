@@ -99,6 +99,20 @@ void HistogramMeanFromFile::Accumulate(BDSOutputROOTEventHistograms* hNew)
     {histograms4d[i]->Accumulate(h4i[i]);}
 }
 
+void HistogramMeanFromFile::Merge(const HistogramMeanFromFile* other)
+{
+  if (!other)
+    {return;}
+  for (unsigned int i = 0; i < (unsigned int)histograms1d.size(); ++i)
+    {histograms1d[i]->Merge(other->histograms1d[i]);}
+  for (unsigned int i = 0; i < (unsigned int)histograms2d.size(); ++i)
+    {histograms2d[i]->Merge(other->histograms2d[i]);}
+  for (unsigned int i = 0; i < (unsigned int)histograms3d.size(); ++i)
+    {histograms3d[i]->Merge(other->histograms3d[i]);}
+  for (unsigned int i = 0; i < (unsigned int)histograms4d.size(); ++i)
+    {histograms4d[i]->Merge(other->histograms4d[i]);}
+}
+
 void HistogramMeanFromFile::Terminate()
 {
   // terminate each accumulator
@@ -53,6 +53,10 @@ public:
   /// exact same structure in BDSOutputROOTEventHistogams input.
   void Accumulate(BDSOutputROOTEventHistograms* hNew);
 
+  /// Combine the entries accumulated by another instance made from the same
+  /// structure of histograms (e.g. in another thread).
+  void Merge(const HistogramMeanFromFile* other);
+
   /// Finish calculation.
   void Terminate();
 
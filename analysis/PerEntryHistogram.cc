@@ -32,9 +32,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TH3D.h"
+#include "TTreeFormula.h"
+#include "TTreeFormulaManager.h"
 #include "BDSBH4DBase.hh"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 ClassImp(PerEntryHistogram)
 
@@ -44,7 +48,11 @@ PerEntryHistogram::PerEntryHistogram():
   selection(""),
   temp(nullptr),
   result(nullptr),
-  command("")
+  command(""),
+  nDimensions(0),
+  selectionFormula(nullptr),
+  formulaManager(nullptr),
+  treeNumber(-1)
 {;}
 
 PerEntryHistogram::PerEntryHistogram(const HistogramDef* definition,
@@ -54,9 +62,12 @@ PerEntryHistogram::PerEntryHistogram(const HistogramDef* definition,
   selection(definition->selection),
   temp(nullptr),
   result(nullptr),
-  command("")
+  command(""),
+  nDimensions(definition->nDimensions),
+  selectionFormula(nullptr),
+  formulaManager(nullptr),
+  treeNumber(-1)
 {
-  int nDimensions = definition->nDimensions;
   TH1* baseHist = nullptr;
   std::string histName = definition->histName;
   std::string baseName = histName + "_base";
@@ -105,12 +116,102 @@ PerEntryHistogram::PerEntryHistogram(const HistogramDef* definition,
     }
   
   accumulator = new HistogramAccumulator(baseHist, nDimensions, histName, histName);
+  delete baseHist; // only needed as a template for the clones
+
+  if (nDimensions < 4 && temp)
+    {CompileFormulae(definition->variable);}
 }
 
 PerEntryHistogram::~PerEntryHistogram()
 {
   delete temp; // this removes it from the current ROOT file
   delete accumulator;
+  for (auto f : variableFormulae)
+    {delete f;}
+  delete selectionFormula;
+  delete formulaManager;
+}
+
+PerEntryHistogram* PerEntryHistogram::TakeEntries()
+{
+  auto taken = new PerEntryHistogram();
+  taken->nDimensions = nDimensions;
+  taken->accumulator = accumulator;
+  // temp has the same binning as the original base histogram and is emptied by the accumulator
+  accumulator = new HistogramAccumulator(temp, nDimensions,
+                                         taken->accumulator->ResultHistName(),
+                                         taken->accumulator->ResultHistTitle());
+  return taken;
+}
+
+std::vector<std::string> PerEntryHistogram::SplitVariable(const std::string& variable)
+{
+  std::vector<std::string> result;
+  std::string current;
+  int depth = 0;
+  for (std::size_t i = 0; i < variable.size(); i++)
+    {
+      char c = variable[i];
+      if (c == '(' || c == '[')
+        {depth++;}
+      else if (c == ')' || c == ']')
+        {depth--;}
+      bool doubleColon = (i + 1 < variable.size() && variable[i+1] == ':') || (i > 0 && variable[i-1] == ':');
+      if (c == ':' && depth == 0 && !doubleColon)
+        {
+          result.push_back(current);
+          current.clear();
+        }
+      else
+        {current += c;}
+    }
+  result.push_back(current);
+  // TTree::Draw syntax is "z:y:x" so reverse to x,y,z order
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+void PerEntryHistogram::CompileFormulae(const std::string& variable)
+{
+  std::vector<std::string> components = SplitVariable(variable);
+  if ((int)components.size() != nDimensions)
+    {return;} // leave to TTree::Draw to interpret
+
+  // formulae are bound to the tree currently loaded in the chain
+  if (chain->GetTreeNumber() < 0)
+    {chain->LoadTree(0);}
+  
+  formulaManager = new TTreeFormulaManager();
+  bool valid = true;
+  for (std::size_t i = 0; i < components.size(); i++)
+    {
+      std::string name = std::string(temp->GetName()) + "_var" + std::to_string(i);
+      auto f = new TTreeFormula(name.c_str(), components[i].c_str(), chain);
+      valid = valid && f->GetNdim() > 0;
+      variableFormulae.push_back(f);
+      formulaManager->Add(f);
+    }
+  if (!selection.empty())
+    {
+      std::string name = std::string(temp->GetName()) + "_sel";
+      selectionFormula = new TTreeFormula(name.c_str(), selection.c_str(), chain);
+      valid = valid && selectionFormula->GetNdim() > 0;
+      formulaManager->Add(selectionFormula);
+    }
+
+  if (!valid)
+    {// fall back to TTree::Draw which will report the problem
+      for (auto f : variableFormulae)
+        {delete f;}
+      variableFormulae.clear();
+      delete selectionFormula;
+      selectionFormula = nullptr;
+      delete formulaManager;
+      formulaManager = nullptr;
+      return;
+    }
+  formulaManager->Sync();
+  treeNumber = chain->GetTreeNumber();
 }
 
 void PerEntryHistogram::AccumulateCurrentEntry(long int entryNumber)
@@ -120,10 +221,78 @@ void PerEntryHistogram::AccumulateCurrentEntry(long int entryNumber)
   // or singly valued - therefore we don't need to keep a map of
   // which variables to loop over and which not to.
   temp->Reset();
-  chain->Draw(command.c_str(), selection.c_str(), "goff", 1, entryNumber);
+  if (formulaManager)
+    {FillFromFormulae(entryNumber);}
+  else
+    {chain->Draw(command.c_str(), selection.c_str(), "goff", 1, entryNumber);}
   accumulator->Accumulate(temp);
 }
 
+void PerEntryHistogram::FillFromFormulae(long int entryNumber)
+{
+  Long64_t localEntry = chain->LoadTree(entryNumber);
+  if (localEntry < 0)
+    {return;}
+  if (chain->GetTreeNumber() != treeNumber)
+    {// new file in the chain so the leaves have changed
+      for (auto f : variableFormulae)
+        {f->UpdateFormulaLeaves();}
+      if (selectionFormula)
+        {selectionFormula->UpdateFormulaLeaves();}
+      formulaManager->UpdateFormulaLeaves();
+      treeNumber = chain->GetTreeNumber();
+    }
+
+  // same logic as TSelectorDraw - the selection is a weight, scaled by the weight
+  // of the tree or chain, and instance 0 of every formula must always be evaluated
+  // first to load the branches
+  int nData = formulaManager->GetNdata();
+  if (nData <= 0)
+    {return;}
+  bool selectionMultiple = selectionFormula && selectionFormula->GetMultiplicity();
+  double treeWeight = chain->GetWeight();
+  double weight = treeWeight;
+  if (selectionFormula)
+    {
+      weight = treeWeight * selectionFormula->EvalInstance(0);
+      if (weight == 0 && !selectionMultiple)
+        {return;} // single valued selection rejects the whole entry
+    }
+  double values[3] = {0, 0, 0};
+  for (int d = 0; d < nDimensions; d++)
+    {values[d] = variableFormulae[d]->EvalInstance(0);}
+  if (weight != 0)
+    {FillTemp(values, weight);}
+
+  for (int i = 1; i < nData; i++)
+    {
+      if (selectionMultiple)
+        {
+          weight = treeWeight * selectionFormula->EvalInstance(i);
+          if (weight == 0)
+            {continue;}
+        }
+      for (int d = 0; d < nDimensions; d++)
+        {values[d] = variableFormulae[d]->EvalInstance(i);}
+      FillTemp(values, weight);
+    }
+}
+
+void PerEntryHistogram::FillTemp(const double* values, double weight)
+{
+  switch (nDimensions)
+    {
+    case 1:
+      {temp->Fill(values[0], weight); break;}
+    case 2:
+      {static_cast<TH2D*>(temp)->Fill(values[0], values[1], weight); break;}
+    case 3:
+      {static_cast<TH3D*>(temp)->Fill(values[0], values[1], values[2], weight); break;}
+    default:
+      {break;}
+    }
+}
+
 void PerEntryHistogram::Terminate()
 {
   result = accumulator->Terminate();
@@ -21,6 +21,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "HistogramAccumulator.hh"
 
 #include <string>
+#include <vector>
 
 #include "Rtypes.h" // for classdef
 
@@ -29,6 +30,8 @@ class HistogramDef;
 class TChain;
 class TDirectory;
 class TH1;
+class TTreeFormula;
+class TTreeFormulaManager;
 
 /**
  * @brief Holder for information to calculate per entry histograms.
@@ -39,6 +42,11 @@ class TH1;
  * 
  * This uses a HistogramAccumulator object rather than inheritance as this
  * class has to prepare the base histogram in the constructor first.
+ *
+ * The variable and selection are compiled once into TTreeFormulae bound to
+ * the chain and evaluated for each entry in the same way as TTree::Draw but
+ * without parsing them again for every entry. If they cannot be compiled,
+ * e.g. for 4D histograms, TChain::Draw is used for each entry instead.
  * 
  * @author Laurie Nevay
  */
@@ -69,18 +77,53 @@ public:
   /// ie just increment n.
   inline void AddNEmptyEntries(unsigned long i){accumulator->AddNEmptyEntries(i);}
 
+  /// Combine the entries accumulated by another instance made from the same
+  /// definition (e.g. in another thread) into this one.
+  inline void Merge(const PerEntryHistogram* other){accumulator->Merge(other->accumulator);}
+
+  /// Combine i entries that are all zero even if entries have already been accumulated.
+  inline void MergeNEmptyEntries(unsigned long i){accumulator->MergeNEmptyEntries(i);}
+
+  /// Move the entries accumulated so far into a new instance that can only be merged
+  /// and restart this one with none. The compiled formulae stay with this instance
+  /// so further entries can be accumulated without compiling them again.
+  PerEntryHistogram* TakeEntries();
+
+  /// Whether the expressions are compiled. If not, TChain::Draw is used which
+  /// finds the temporary histogram by name in the current directory.
+  virtual bool Compiled() const {return formulaManager != nullptr;}
+
   /// Get the Integral() from the result member histogram if it exists, otherwise 0.
   double Integral() const;
 
 protected:
+  /// Split a TTree::Draw variable "z:y:x" into its components in x,y,z order
+  /// ignoring "::" and any colons inside brackets.
+  static std::vector<std::string> SplitVariable(const std::string& variable);
+
+  /// Compile the variable and selection into formulae. Leaves them empty if not possible.
+  void CompileFormulae(const std::string& variable);
+
+  /// Fill temp with the current entry using the compiled formulae.
+  void FillFromFormulae(long int entryNumber);
+
+  /// Fill temp with one set of values (in x,y,z order) and a weight.
+  void FillTemp(const double* values, double weight);
+
   HistogramAccumulator* accumulator;
   TChain*       chain;        ///< Cache of chain pointer that provides data.
   std::string   selection;    ///< Selection command.
   TH1*          temp;         ///< Histogram for temporary 1 event data.
   TH1*          result;       ///< Final result with errors as the error on the mean.
   std::string   command;      ///< Draw command.
+  int           nDimensions;  ///< Number of dimensions of the histogram.
+
+  std::vector<TTreeFormula*> variableFormulae; //! Formula for each dimension in x,y,z order.
+  TTreeFormula*        selectionFormula;       //! Selection (weight) formula if any.
+  TTreeFormulaManager* formulaManager;         //! Synchronises the lengths of the formulae.
+  int                  treeNumber;             //! Tree in the chain the formulae are bound to.
   
-  ClassDef(PerEntryHistogram, 1);
+  ClassDef(PerEntryHistogram, 2);
 };
 
 #endif
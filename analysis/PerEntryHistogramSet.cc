@@ -38,7 +38,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 PerEntryHistogramSet::PerEntryHistogramSet(const HistogramDefSet* definitionIn,
                                            Event*                 eventIn,
                                            TChain*                chainIn):
-  baseDefinition(definitionIn->baseDefinition),
+  baseDefinition(definitionIn->baseDefinition->Clone()), // owned by the set as there may be several
   event(eventIn),
   chain(chainIn),
   branchName(definitionIn->branchName),
@@ -126,6 +126,53 @@ void PerEntryHistogramSet::AccumulateCurrentEntry(long int entryNumber)
     {hist->AccumulateCurrentEntry(entryNumber);}
 }
 
+PerEntryHistogramSetEntries::~PerEntryHistogramSetEntries()
+{
+  for (auto& specHist : histograms)
+    {delete specHist.second;}
+}
+
+PerEntryHistogramSetEntries* PerEntryHistogramSet::TakeEntries()
+{
+  auto taken = new PerEntryHistogramSetEntries();
+  taken->allPDGIDs = allPDGIDs;
+  taken->nEntries  = nEntries;
+  for (auto& specHist : histograms)
+    {taken->histograms[specHist.first] = specHist.second->TakeEntries();}
+  nEntries = 0;
+  return taken;
+}
+
+void PerEntryHistogramSet::Merge(const PerEntryHistogramSetEntries* other)
+{
+  if (!other)
+    {return;}
+
+  // histograms for particles first seen in the other set
+  std::vector<long long int> missing;
+  std::set_difference(other->allPDGIDs.begin(), other->allPDGIDs.end(),
+                      allPDGIDs.begin(), allPDGIDs.end(),
+                      std::back_inserter(missing));
+  for (auto pdgID : missing)
+    {CreatePerEntryHistogram(pdgID);}
+
+  for (auto& specHist : histograms)
+    {
+      auto search = other->histograms.find(specHist.first);
+      if (search != other->histograms.end())
+        {specHist.second->Merge(search->second);}
+      else
+        {specHist.second->MergeNEmptyEntries((unsigned long)other->nEntries);}
+    }
+  nEntries += other->nEntries;
+}
+
+bool PerEntryHistogramSet::Compiled() const
+{
+  return std::all_of(allPerEntryHistograms.begin(), allPerEntryHistograms.end(),
+                     [](const PerEntryHistogram* h){return h->Compiled();});
+}
+
 void PerEntryHistogramSet::Terminate()
 {
   for (auto hist : allPerEntryHistograms)
@@ -52,6 +52,21 @@ namespace BDS
   }
 }
 
+/**
+ * @brief Entries taken from a PerEntryHistogramSet that can only be merged.
+ *
+ * @author L. Nevay
+ */
+
+struct PerEntryHistogramSetEntries
+{
+  ~PerEntryHistogramSetEntries();
+
+  std::set<long long int>                    allPDGIDs;
+  std::map<ParticleSpec, PerEntryHistogram*> histograms;
+  long long int                              nEntries = 0;
+};
+
 /**
  * @brief Histogram over a set of integers not number line.
  *
@@ -69,6 +84,19 @@ public:
   virtual void AccumulateCurrentEntry(long int entryNumber);
   virtual void Terminate();
   virtual void Write(TDirectory* dir = nullptr);
+
+  /// Combine the entries taken from another set made from the same definition
+  /// (e.g. in another thread). Any particle histograms only in one of the sets are
+  /// created in this one and treated as zero for the entries of the other set.
+  void Merge(const PerEntryHistogramSetEntries* other);
+
+  /// Move the entries accumulated so far into a new object that can only be merged
+  /// and restart this set with none. The particle histograms made so far and their
+  /// compiled formulae are kept.
+  PerEntryHistogramSetEntries* TakeEntries();
+
+  /// Whether all the histograms in the set so far have compiled expressions.
+  virtual bool Compiled() const;
   
   /// Ensure sampler is setup even if it wasn't on at the beginning when
   /// we inspected the model tree. We need this to build up unique PDG IDs
@@ -177,19 +177,8 @@ void SamplerAnalysis::Process(bool firstTime)
   {
     if (i == 0)
       {S = s->S;} // update sampler on first round - do here so not to load default data
-    if (s->parentID[i] != 0)
-      {continue;} // select only primary particles
-    if (s->turnNumber[i] > 1)
-      {continue;} // only use first turn particles
-    if (s->zp[i] <= 0)
-      {continue;} // only forward going particles - sampler can intercept backwards particles
-
-    coordinates[0] = s->x[i];
-    coordinates[1] = s->xp[i];
-    coordinates[2] = s->y[i];
-    coordinates[3] = s->yp[i];
-    coordinates[4] = std::sqrt(std::pow(s->energy[i],2) - m2); // p = sqrt(E^2 - M^2)
-    coordinates[5] = s->T[i];
+    if (!FillCoordinates(i, m2))
+      {continue;}
 
     if (firstTime)
       {offsets = coordinates;}
@@ -212,6 +201,57 @@ void SamplerAnalysis::Process(bool firstTime)
   }
 }
 
+bool SamplerAnalysis::FillCoordinates(int i, double m2)
+{
+  if (s->parentID[i] != 0)
+    {return false;} // select only primary particles
+  if (s->turnNumber[i] > 1)
+    {return false;} // only use first turn particles
+  if (s->zp[i] <= 0)
+    {return false;} // only forward going particles - sampler can intercept backwards particles
+
+  coordinates[0] = s->x[i];
+  coordinates[1] = s->xp[i];
+  coordinates[2] = s->y[i];
+  coordinates[3] = s->yp[i];
+  coordinates[4] = std::sqrt(std::pow(s->energy[i],2) - m2); // p = sqrt(E^2 - M^2)
+  coordinates[5] = s->T[i];
+  return true;
+}
+
+void SamplerAnalysis::SetOffsetsFromCurrentEntry()
+{
+  double m2 = std::pow(particleMass,2);
+  for(int i=0;i<s->n;++i)
+    {
+      if (FillCoordinates(i, m2))
+        {
+          offsets = coordinates;
+          return;
+        }
+    }
+}
+
+void SamplerAnalysis::Merge(const SamplerAnalysis* other)
+{
+  if (!other)
+    {return;}
+  if (other->S != 0)
+    {S = other->S;} // only set once the other has loaded any data
+  npart += other->npart;
+  for(int a=0;a<6;++a)
+    {
+      for(int b=0;b<6;++b)
+        {
+          for (int j = 0; j <= 4; ++j)
+            {
+              for (int k = 0; k <= 4; ++k)
+                {powSums[a][b][j][k] += other->powSums[a][b][j][k];}
+            }
+        }
+    }
+}
+
 std::vector<double> SamplerAnalysis::Terminate(std::vector<double> emittance,
 					       bool useEmittanceFromFirstSampler)
 {
@@ -50,6 +50,20 @@ public:
   /// Loop over all entries in the sampler and accumulate power sums over variuos moments.
   void Process(bool firstTime = false);
 
+  /// Combine the power sums accumulated by another analysis of the same sampler
+  /// (e.g. in another thread). Both must use the same offsets.
+  void Merge(const SamplerAnalysis* other);
+
+  /// Set the offsets used for the assumed mean subtraction from the first selected
+  /// particle in the currently loaded entry so that the power sums accumulated by
+  /// separate analyses of the same sampler can be merged by addition.
+  void SetOffsetsFromCurrentEntry();
+
+  /// @{ Accessor for the offsets used for mean subtraction.
+  inline const std::vector<double>& Offsets() const {return offsets;}
+  inline void SetOffsets(const std::vector<double>& offsetsIn) {offsets = offsetsIn;}
+  /// @}
+
   /// Calculate optical functions based on combinations of moments already accumulated.
   std::vector<double>  Terminate(std::vector<double> emittance,
 				 bool useEmittanceFromFirstSampler = true);
@@ -100,6 +114,10 @@ protected:
 
 
 
+  /// Fill coordinates from entry i of the sampler. Returns false if the particle is
+  /// not selected (only forward going first turn primaries are used).
+  bool FillCoordinates(int i, double m2);
+
   /// Returns a central moment calculated from the corresponding coordinate power sums.
   /// Arguments:
   ///    powSums: array contatining the coordinate power sums
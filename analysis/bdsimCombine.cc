@@ -21,30 +21,214 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "FileMapper.hh"
 #include "Header.hh"
+#include "Run.hh"
 
+#include "BDSBH4DBase.hh"
 #include "BDSOutputROOTEventHeader.hh"
+#include "BDSOutputROOTEventHistograms.hh"
+#include "BDSOutputROOTEventRunInfo.hh"
 
-#include "TChain.h"
 #include "TFile.h"
+#include "TFileMerger.h"
+#include "TROOT.h"
 #include "TTree.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <exception>
 #include <glob.h>
+#include <iomanip>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
+/// Add each histogram in other to the one with the same index in combined. Returns
+/// false if the number of histograms differs.
+template <class T>
+bool AddHistograms(std::vector<T*>& combined,
+                   const std::vector<T*>& other)
+{
+  if (combined.size() != other.size())
+    {return false;}
+  for (std::size_t i = 0; i < combined.size(); i++)
+    {combined[i]->Add(other[i]);}
+  return true;
+}
+
+/// Add the information and histograms of every entry (i.e. run) of a Run tree to the
+/// combined ones, which are created from the first run found. The histograms are summed,
+/// the durations are summed and the start and stop times span all runs. Returns false if
+/// the histograms are not the same as the ones already combined.
+bool AccumulateRuns(TTree* runTree,
+                    int    dataVersion,
+                    BDSOutputROOTEventRunInfo*&    summary,
+                    BDSOutputROOTEventHistograms*& histos)
+{
+  Run* run = new Run(false, dataVersion);
+  run->SetBranchAddress(runTree);
+  bool compatible = true;
+  for (Long64_t i = 0; i < runTree->GetEntries() && compatible; i++)
+    {
+      runTree->GetEntry(i);
+      const BDSOutputROOTEventRunInfo* info = dataVersion < 4 ? run->Info : run->Summary;
+      if (!summary)
+        {summary = new BDSOutputROOTEventRunInfo(*info);}
+      else
+        {
+          summary->startTime     = std::min(summary->startTime, info->startTime);
+          summary->stopTime      = std::max(summary->stopTime,  info->stopTime);
+          summary->durationWall += info->durationWall;
+          summary->durationCPU  += info->durationCPU;
+        }
+
+      if (!histos)
+        {
+          histos = new BDSOutputROOTEventHistograms(*run->Histos); // copies the histograms
+          continue;
+        }
+      compatible = AddHistograms(histos->Get1DHistograms(), run->Histos->Get1DHistograms());
+      compatible = compatible && AddHistograms(histos->Get2DHistograms(), run->Histos->Get2DHistograms());
+      compatible = compatible && AddHistograms(histos->Get3DHistograms(), run->Histos->Get3DHistograms());
+      auto& combined4D = histos->Get4DHistograms();
+      const auto& other4D = run->Histos->Get4DHistograms();
+      compatible = compatible && combined4D.size() == other4D.size();
+      for (std::size_t j = 0; compatible && j < combined4D.size(); j++)
+        {*combined4D[j] += *other4D[j];} // not TH1::Add as the data isn't in the TH1 bins
+    }
+  delete run;
+  return compatible;
+}
+
+/// Merge the Event trees of the input files in order into a new output file.
+/// At most maxOpenFiles inputs are open at once so the memory used does not depend on
+/// the number of files. With fast merging, the compressed baskets are copied without
+/// being decompressed and recompressed.
+bool MergeTrees(const std::vector<std::string>& inputFiles,
+                const std::string& outputFile,
+                int  compressionSettings,
+                bool fast,
+                int  maxOpenFiles)
+{
+  TFileMerger merger(kFALSE, kFALSE);
+  merger.SetPrintLevel(0);
+  merger.SetFastMethod(fast);
+  merger.SetMaxOpenedFiles(maxOpenFiles);
+  if (!merger.OutputFile(outputFile.c_str(), "RECREATE", compressionSettings))
+    {
+      std::cerr << "Problem opening output file \"" << outputFile << "\"" << std::endl;
+      return false;
+    }
+  for (const auto& filename : inputFiles)
+    {
+      if (!merger.AddFile(filename.c_str(), kFALSE))
+        {
+          std::cerr << "Problem opening file \"" << filename << "\" to merge" << std::endl;
+          return false;
+        }
+    }
+  merger.AddObjectNames("Event");
+  return merger.PartialMerge(TFileMerger::kAll | TFileMerger::kRegular | TFileMerger::kOnlyListed);
+}
+
+/// Merge consecutive groups of the input files in parallel into temporary files next
+/// to the output and then merge those into the output. The order of the events is kept.
+bool MergeTreesParallel(const std::vector<std::string>& inputFiles,
+                        const std::string& outputFile,
+                        int  compressionSettings,
+                        bool fast,
+                        int  maxOpenFiles,
+                        int  nThreads)
+{
+  int nGroups = std::min(nThreads, (int)inputFiles.size());
+  if (nGroups < 2)
+    {return MergeTrees(inputFiles, outputFile, compressionSettings, fast, maxOpenFiles);}
+
+  ROOT::EnableThreadSafety();
+  std::vector<std::vector<std::string> > groups((std::size_t)nGroups);
+  std::vector<std::string> partialFiles;
+  std::size_t nPerGroup = inputFiles.size() / (std::size_t)nGroups;
+  std::size_t remainder = inputFiles.size() % (std::size_t)nGroups;
+  auto it = inputFiles.begin();
+  for (int g = 0; g < nGroups; g++)
+    {
+      std::size_t n = nPerGroup + ((std::size_t)g < remainder ? 1 : 0);
+      groups[(std::size_t)g].assign(it, it + (long)n);
+      it += (long)n;
+      partialFiles.push_back(outputFile + ".part" + std::to_string(g) + ".root");
+    }
+
+  // the memory per thread is bounded by the files open at once
+  int maxOpenPerThread = std::max(2, maxOpenFiles / nGroups);
+  std::atomic<bool> success(true);
+  std::vector<std::thread> threads;
+  for (int g = 0; g < nGroups; g++)
+    {
+      threads.emplace_back([&, g]()
+                           {
+                             if (!MergeTrees(groups[(std::size_t)g], partialFiles[(std::size_t)g],
+                                             compressionSettings, fast, maxOpenPerThread))
+                               {success = false;}
+                           });
+    }
+  for (auto& t : threads)
+    {t.join();}
+
+  // the partial files were all written with the same compression so can always be fast merged
+  if (success)
+    {success = MergeTrees(partialFiles, outputFile, compressionSettings, true, maxOpenFiles);}
+  for (const auto& filename : partialFiles)
+    {std::remove(filename.c_str());}
+  return success;
+}
+
+/// Print the command line usage.
+void Usage()
+{
+  std::cout << "usage: bdsimCombine (--nthreads=N) (--maxopenfiles=M) result.root file1.root file2.root ..." << std::endl;
+  std::cout << " --nthreads=N     (optional) - merge with N threads, 0 for all available (default 1)" << std::endl;
+  std::cout << " --maxopenfiles=M (optional) - maximum number of files open at once (default 100)" << std::endl;
+}
+
 int main(int argc, char* argv[])
 {
-  if (argc < 3)
+  // optional arguments come first
+  int nThreads     = 1;
+  int maxOpenFiles = 100;
+  int firstArg     = 1;
+  for (; firstArg < argc; ++firstArg)
     {
-      std::cout << "usage: bdsimCombine result.root file1.root file2.root ..." << std::endl;
+      std::string arg = std::string(argv[firstArg]);
+      try
+        {
+          if (arg.rfind("--nthreads=", 0) == 0)
+            {nThreads = std::stoi(arg.substr(11));}
+          else if (arg.rfind("--maxopenfiles=", 0) == 0)
+            {maxOpenFiles = std::stoi(arg.substr(15));}
+          else
+            {break;}
+        }
+      catch (const std::exception&)
+        {
+          std::cerr << "bdsimCombine> invalid number in \"" << arg << "\"" << std::endl;
+          Usage();
+          exit(1);
+        }
+    }
+  if (nThreads < 1) // 0 means all available
+    {nThreads = std::max(1, (int)std::thread::hardware_concurrency());}
+
+  if (argc - firstArg < 2 || maxOpenFiles < 2)
+    {
+      Usage();
       exit(1);
     }
 
   // build input file list
   std::vector<std::string> inputFiles;
-  for (int i = 2; i < argc; ++i)
+  for (int i = firstArg + 1; i < argc; ++i)
     {inputFiles.emplace_back(std::string(argv[i]));}
   // see if we're globbing files
   if (inputFiles[0].find('*') != std::string::npos)
@@ -65,7 +249,7 @@ int main(int argc, char* argv[])
       exit(1);
     }
   // check for wrong order of arguments which is common mistake
-  std::string outputFile = std::string(argv[1]);
+  std::string outputFile = std::string(argv[firstArg]);
   if (outputFile.find('*') != std::string::npos)
     {
       std::cerr << "First argument for output file \"" << outputFile << "\" contains an *." << std::endl;
@@ -73,20 +257,6 @@ int main(int argc, char* argv[])
       exit(1);
     }
 
-  // merge event trees - this is done by ROOT and it writes the output file and closes it
-  TChain* eventsMerged = new TChain("Event");
-  for (const auto& filename : inputFiles)
-    {eventsMerged->Add(filename.c_str());}
-  std::cout << "Beginning merge of Event Tree" << std::endl;
-  Long64_t operationCode = eventsMerged->Merge(outputFile.c_str());
-  if (operationCode == 0)
-    {// from inspection of ROOT TChain.cxx ~line 1866, it returns 0 if there's a problem
-      std::cerr << "Problem in TTree::Merge opening output file \"" << outputFile << "\"" << std::endl;
-      return 1;
-    }
-  else
-    {std::cout << "Finished merge of Event Tree" << std::endl;}
-  
   // loop over input files loading headers to accumulate number of original events and
   // the number of input events from an optional distribution file
   unsigned long long int nOriginalEvents = 0;
@@ -98,6 +268,12 @@ int main(int argc, char* argv[])
   unsigned long int i = 0;
   std::cout << "Counting number of original events from headers of files" << std::endl;
   std::vector<unsigned long long int> nEventsPerTree;
+  std::vector<std::string> validFiles;
+  int  compressionSettings = 0;
+  bool sameCompression     = true;
+  Long64_t nBytesInput     = 0;
+  BDSOutputROOTEventRunInfo*    runSummary = nullptr;
+  BDSOutputROOTEventHistograms* runHistos  = nullptr;
   for (const auto& filename : inputFiles)
     {
       TFile* f = new TFile(filename.c_str(), "READ");
@@ -126,7 +302,13 @@ int main(int argc, char* argv[])
       // We also want to explicitly copy the skim variables that might only be known in the 2nd instance.
       BDSOutputROOTEventHeader* h = headerLocal->header;
       if (i == 0) // take only from the first file and assume the same for all
-        {distrFileLoopNTimes = h->distrFileLoopNTimes;}
+        {
+          distrFileLoopNTimes = h->distrFileLoopNTimes;
+          compressionSettings = f->GetCompressionSettings();
+        }
+      // baskets can only be copied without recompression if the compression is the same
+      sameCompression = sameCompression && f->GetCompressionSettings() == compressionSettings;
+      nBytesInput += f->GetSize();
 
       nOriginalEvents += h->nOriginalEvents;
       nEventsRequested += h->nEventsRequested;
@@ -139,6 +321,14 @@ int main(int argc, char* argv[])
       if (eventTree)
         {nEventsThisFile = (unsigned long long int)eventTree->GetEntries();}
       nEventsPerTree.push_back(nEventsThisFile);
+      validFiles.push_back(filename);
+
+      TTree* runTree = dynamic_cast<TTree*>(f->Get("Run"));
+      if (runTree && !AccumulateRuns(runTree, h->dataVersion, runSummary, runHistos))
+        {
+          std::cerr << "Run histograms in file " << filename << " differ from those in previous files" << std::endl;
+          return 1;
+        }
 
       delete headerLocal;
       f->Close();
@@ -149,27 +339,36 @@ int main(int argc, char* argv[])
   // checks
   if (i == 0)
     {std::cerr << "No valid files found" << std::endl; return 1;}
+
+  // merge event trees - this writes the output file and closes it
+  std::cout << "Beginning merge of Event Trees";
+  if (nThreads > 1)
+    {std::cout << " with " << nThreads << " threads";}
+  if (!sameCompression)
+    {std::cout << " (files have different compression so baskets are recompressed)";}
+  std::cout << std::endl;
+  auto startTime = std::chrono::steady_clock::now();
+  if (!MergeTreesParallel(validFiles, outputFile, compressionSettings, sameCompression, maxOpenFiles, nThreads))
+    {
+      std::cerr << "Problem merging Event Trees into output file \"" << outputFile << "\"" << std::endl;
+      return 1;
+    }
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+  double sizeMB = (double)nBytesInput / (1024.0*1024.0);
+  std::cout << "Finished merge of Event Trees: " << std::fixed << std::setprecision(1) << sizeMB
+            << " MB in " << duration.count() << " s (" << sizeMB / std::max(duration.count(), 1e-9)
+            << " MB/s)" << std::defaultfloat << std::endl;
   
   // now we produce a new header and update the file as well as copy over the other trees from the first valid
   // input file in the list (i.e. tolerate the odd zombie file from a big run)
-  TFile* input = nullptr;
-  bool validFile = false;
-  i = 0;
-  while (!validFile)
-    {// assume we have one valid file from check above
-      if (i > (unsigned long int)inputFiles.size())
-        {return 1;}
-      input = new TFile(inputFiles[i].c_str(), "READ");
-      validFile = RBDS::IsBDSIMOutputFile(input);
-      i++;
-    }
+  TFile* input = new TFile(validFiles[0].c_str(), "READ");
   
   TFile* output = new TFile(outputFile.c_str(), "UPDATE");
   if (output->IsZombie())
     {std::cerr << "Could not reopen output file to add other trees"; return 1;}
   output->cd();
   BDSOutputROOTEventHeader* headerOut = new BDSOutputROOTEventHeader();
-  headerOut->Fill(std::vector<std::string>(), inputFiles); // updates time stamp
+  headerOut->Fill(std::vector<std::string>(), validFiles); // updates time stamp
   headerOut->SetFileType("BDSIM");
   headerOut->skimmedFile = skimmedFile;
   headerOut->nOriginalEvents = nOriginalEvents;
@@ -183,7 +382,7 @@ int main(int argc, char* argv[])
 
   // go over all other trees and copy them (in the original order) from the first file to the output
   std::cout << "Merging rest of file contents" << std::endl;
-  std::vector<std::string> treeNames = {"ParticleData", "Beam", "Options", "Model", "Run"};
+  std::vector<std::string> treeNames = {"ParticleData", "Beam", "Options", "Model"};
   for (const auto& tn : treeNames)
     {
       TTree* original = dynamic_cast<TTree*>(input->Get(tn.c_str()));
@@ -197,6 +396,16 @@ int main(int argc, char* argv[])
       original->CloneTree();
     }
 
+  // one run with the summed histograms of all runs
+  if (!runSummary)
+    {runSummary = new BDSOutputROOTEventRunInfo();}
+  if (!runHistos)
+    {runHistos = new BDSOutputROOTEventHistograms();}
+  TTree* runTreeOut = new TTree("Run", "BDSIM run histograms/information");
+  runTreeOut->Branch("Histos.",  "BDSOutputROOTEventHistograms", runHistos,  32000, 1);
+  runTreeOut->Branch("Summary.", "BDSOutputROOTEventRunInfo",    runSummary, 32000, 1);
+  runTreeOut->Fill();
+
   TTree* eventCombineInfoTree = new TTree("EventCombineInfo", "EventCombineInfo");
   UInt_t originalID = 0;
   eventCombineInfoTree->Branch("combinedFileIndex", &originalID);
@@ -220,7 +429,6 @@ int main(int argc, char* argv[])
   output->Close();
   delete output;
   
-  std::cout << "Combined result of " << inputFiles.size() << " files written to: " << outputFile << std::endl;
-  std::cout << "Run histograms are not summed" << std::endl; // TODO
+  std::cout << "Combined result of " << validFiles.size() << " files written to: " << outputFile << std::endl;
   return 0;
 }
@@ -58,10 +58,10 @@ int main(int argc, char *argv[])
 
   std::string configFilePath = std::string(argv[1]); //create a string from arguments so able to use find_last_of and substr  methods
   std::string configFileExtension = configFilePath.substr(configFilePath.find_last_of('.') + 1) ;
-  if (configFileExtension != "txt")
+  if (configFileExtension != "txt" && !Config::IsCompiledConfigFileName(configFilePath))
     {
       std::cerr << "Unrecognised extension for file: " << configFilePath << ".  Extension: " << configFileExtension << std::endl;
-      std::cerr << "Make sure the config file is plain text with the .txt extension!" << std::endl;
+      std::cerr << "Make sure the config file is plain text with the .txt extension or a compiled .rbdscfg file!" << std::endl;
       exit(1);
     }
 
@@ -91,7 +91,8 @@ int main(int argc, char *argv[])
                                       config->ProcessSamplers(),
                                       allBranches,
                                       branchesToActivate,
-                                      config->GetOptionBool("backwardscompatible"));
+                                      config->GetOptionBool("backwardscompatible"),
+                                      config->ValidateDatasetOnce());
 
       config->FixCylindricalAndSphericalSamplerVariablesInSets(dl->GetAllCylindricalSamplerNames(),
                                                                dl->GetAllSphericalSamplerNames());
@@ -124,7 +125,10 @@ int main(int argc, char *argv[])
                                       config->PrintModuloFraction(),
                                       config->EmittanceOnTheFly(),
                                       (long int) config->GetOptionNumber("eventstart"),
-                                      (long int) config->GetOptionNumber("eventend"));
+                                      (long int) config->GetOptionNumber("eventend"),
+                                      "",
+                                      (int) config->GetOptionNumber("nthreads"),
+                                      (long int) config->GetOptionNumber("eventsperblock"));
       
       RunAnalysis* runAnalysis = new RunAnalysis(dl->GetRun(),
                                                  dl->GetRunTree(),
@@ -32,28 +32,161 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "TH1.h"
 #include "TH2.h"
 #include "TH3.h"
+#include "TROOT.h"
 #include "BDSBH4D.hh"
+#include "BDSBH4DBase.hh"
 #include "TTree.h"
 
+#include <algorithm>
 #include <exception>
+#include <future>
 #include <iostream>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
+/// Combination of a consecutive range of the input files.
+struct PartialCombination
+{
+  std::vector<HistogramAccumulator*> accumulators; ///< One for each histogram in the map.
+  unsigned long long int nOriginalEvents      = 0;
+  unsigned long long int nEventsInFile        = 0;
+  unsigned long long int nEventsInFileSkipped = 0;
+  unsigned long long int nEventsRequested     = 0;
+};
+
+/// Make an empty accumulator of the same type as the one in the map that is not
+/// attached to any directory so it can be used in another thread.
+HistogramAccumulator* NewPartialAccumulator(const RBDS::HistogramPath& hist)
+{
+  TH1* base = hist.accumulator->Result();
+  int nDim = hist.BDSBH4Dtype ? 4 : RBDS::DetermineDimensionality(base);
+  std::string title = std::string(base->GetTitle());
+  if (dynamic_cast<HistogramAccumulatorSum*>(hist.accumulator))
+    {return new HistogramAccumulatorSum(base, nDim, hist.name, title);}
+  else
+    {return new HistogramAccumulatorMerge(base, nDim, hist.name, title);}
+}
+
+/// Accumulate the histograms and header of one open file.
+void AccumulateFile(TFile* f,
+                    const std::string& file,
+                    const std::vector<RBDS::HistogramPath>& histograms,
+                    PartialCombination& partial,
+                    std::mutex& printMutex)
+{
+  if (!RBDS::IsREBDSIMOrCombineOutputFile(f))
+    {
+      std::lock_guard<std::mutex> lock(printMutex);
+      std::cout << "Skipping " << file << " as not a rebdsim output file" << std::endl;
+      return;
+    }
+  {
+    std::lock_guard<std::mutex> lock(printMutex);
+    std::cout << "Accumulating> " << file << std::endl;
+  }
+  for (std::size_t i = 0; i < histograms.size(); i++)
+    {
+      const auto& hist = histograms[i];
+      std::string histPath = hist.path + hist.name; // histPath has trailing '/'
+
+      TH1* h = dynamic_cast<TH1*>(f->Get(histPath.c_str()));
+
+      if (!h)
+        {
+          std::lock_guard<std::mutex> lock(printMutex);
+          RBDS::WarningMissingHistogram(histPath, file);
+          continue;
+        }
+      partial.accumulators[i]->Accumulate(h);
+      delete h; // not owned by the file as histograms are not added to directories here
+    }
+
+  Header* h = new Header();
+  TTree* ht = (TTree*)f->Get("Header");
+  h->SetBranchAddress(ht);
+  ht->GetEntry(0);
+  partial.nOriginalEvents += h->header->nOriginalEvents;
+  // Here we exploit the fact that the 0th entry of the header tree has no data for these
+  // two variables. There may however, only ever be 1 entry for older data. We add it up anyway.
+  for (int i = 0; i < (int)ht->GetEntries(); i++)
+    {
+      ht->GetEntry(i);
+      partial.nEventsInFile += h->header->nEventsInFile;
+      partial.nEventsInFileSkipped += h->header->nEventsInFileSkipped;
+      partial.nEventsRequested += h->header->nEventsRequested;
+    }
+  delete h;
+}
+
+/// Accumulate the files [begin, end) in order. The next file is opened in the
+/// background while the current one is accumulated.
+void AccumulateFiles(const std::vector<std::string>& inputFiles,
+                     std::size_t begin,
+                     std::size_t end,
+                     const std::vector<RBDS::HistogramPath>& histograms,
+                     PartialCombination& partial,
+                     std::mutex& printMutex)
+{
+  auto openFile = [](const std::string& file){return new TFile(file.c_str());};
+  std::future<TFile*> next;
+  if (begin < end)
+    {next = std::async(std::launch::async, openFile, inputFiles[begin]);}
+  for (std::size_t i = begin; i < end; i++)
+    {
+      TFile* f = next.get();
+      if (i + 1 < end)
+        {next = std::async(std::launch::async, openFile, inputFiles[i + 1]);}
+      AccumulateFile(f, inputFiles[i], histograms, partial, printMutex);
+      f->Close();
+      delete f;
+    }
+}
+
+/// Print the command line usage.
+void Usage()
+{
+  std::cout << "usage: rebdsimCombine (--nthreads=N) result.root file1.root file2.root ..." << std::endl;
+  std::cout << " --nthreads=N (optional) - combine with N threads, 0 for all available (default 1)" << std::endl;
+}
+
 int main(int argc, char* argv[])
 {
-  if (argc < 3)
+  // optional arguments come first
+  int nThreads = 1;
+  int firstArg = 1;
+  for (; firstArg < argc; ++firstArg)
     {
-      std::cout << "usage: rebdsimCombine result.root file1.root file2.root ..." << std::endl;
+      std::string arg = std::string(argv[firstArg]);
+      if (arg.rfind("--nthreads=", 0) == 0)
+        {
+          try
+            {nThreads = std::stoi(arg.substr(11));}
+          catch (const std::exception&)
+            {
+              std::cerr << "rebdsimCombine> invalid number of threads in \"" << arg << "\"" << std::endl;
+              Usage();
+              return 1;
+            }
+        }
+      else
+        {break;}
+    }
+  if (nThreads < 1) // 0 means all available
+    {nThreads = std::max(1, (int)std::thread::hardware_concurrency());}
+
+  if (argc - firstArg < 2)
+    {
+      Usage();
       return 1;
     }
 
   // build input file list
   std::vector<std::string> inputFiles;
-  for (int i = 2; i < argc; ++i)
+  for (int i = firstArg + 1; i < argc; ++i)
     {inputFiles.emplace_back(std::string(argv[i]));}
-
   // checks
   if (inputFiles.size() == 1)
     {
@@ -68,7 +201,7 @@ int main(int argc, char* argv[])
   if (inputFiles.size() > inputFilesSet.size())
     {std::cout << "Warning: at least 1 duplicate name in list of files provided to combine." << std::endl;}
 
-  std::string outputFile = std::string(argv[1]);
+  std::string outputFile = std::string(argv[firstArg]);
   if (outputFile.find('*') != std::string::npos)
     {
       std::cerr << "First argument for output file \"" << outputFile << "\" contains an *." << std::endl;
@@ -125,51 +258,75 @@ int main(int argc, char* argv[])
 
   std::vector<RBDS::HistogramPath> histograms = histMap->Histograms();
 
-  unsigned long long int nOriginalEvents = 0;
-  unsigned long long int nEventsInFile = 0;
-  unsigned long long int nEventsInFileSkipped = 0;
-  unsigned long long int nEventsRequested = 0;
-  
-  std::cout << "Combination of " << inputFiles.size() << " files beginning" << std::endl;
-  // loop over files and accumulate
-  for (const auto& file : inputFiles)
+  // Each thread combines a consecutive range of the files into its own partial
+  // accumulators. These are not attached to the output file as it is shared.
+  ROOT::EnableThreadSafety();
+  TH1::AddDirectory(false);
+  BDSBH4DBase::AddDirectory(false);
+  int nPartials = std::min(nThreads, (int)inputFiles.size());
+  std::vector<PartialCombination> partials((std::size_t)nPartials);
+  for (auto& partial : partials)
     {
-      f = new TFile(file.c_str());
-      if (RBDS::IsREBDSIMOrCombineOutputFile(f))
-        {
-          std::cout << "Accumulating> " << file << std::endl;
-          for (const auto& hist : histograms)
-            {
-              std::string histPath = hist.path + hist.name; // histPath has trailing '/'
+      for (const auto& hist : histograms)
+        {partial.accumulators.push_back(NewPartialAccumulator(hist));}
+    }
 
-              TH1* h = dynamic_cast<TH1*>(f->Get(histPath.c_str()));
+  std::cout << "Combination of " << inputFiles.size() << " files beginning";
+  if (nPartials > 1)
+    {std::cout << " with " << nPartials << " threads";}
+  std::cout << std::endl;
+  std::mutex printMutex;
+  std::size_t nPerPartial = inputFiles.size() / (std::size_t)nPartials;
+  std::size_t remainder   = inputFiles.size() % (std::size_t)nPartials;
+  std::vector<std::thread> threads;
+  std::size_t begin = 0;
+  for (std::size_t p = 0; p < partials.size(); p++)
+    {
+      std::size_t end = begin + nPerPartial + (p < remainder ? 1 : 0);
+      threads.emplace_back(AccumulateFiles, std::cref(inputFiles), begin, end,
+                           std::cref(histograms), std::ref(partials[p]), std::ref(printMutex));
+      begin = end;
+    }
+  for (auto& t : threads)
+    {t.join();}
 
-              if (!h)
-                {RBDS::WarningMissingHistogram(histPath, file); continue;}
-              hist.accumulator->Accumulate(h);
-            }
-          
-          Header* h = new Header();
-          TTree* ht = (TTree*)f->Get("Header");
-          h->SetBranchAddress(ht);
-          ht->GetEntry(0);
-          nOriginalEvents += h->header->nOriginalEvents;
-          // Here we exploit the fact that the 0th entry of the header tree has no data for these
-          // two variables. There may however, only ever be 1 entry for older data. We add it up anyway.
-          for (int i = 0; i < (int)ht->GetEntries(); i++)
-            {
-              ht->GetEntry(i);
-              nEventsInFile += h->header->nEventsInFile;
-              nEventsInFileSkipped += h->header->nEventsInFileSkipped;
-              nEventsRequested += h->header->nEventsRequested;
-            }
-          delete h;
+  // tree reduction - merge neighbouring partial results in pairs in parallel
+  for (std::size_t stride = 1; stride < partials.size(); stride *= 2)
+    {
+      threads.clear();
+      for (std::size_t p = 0; p + stride < partials.size(); p += 2 * stride)
+        {
+          threads.emplace_back([&partials, p, stride]()
+                               {
+                                 auto& a = partials[p];
+                                 auto& b = partials[p + stride];
+                                 for (std::size_t i = 0; i < a.accumulators.size(); i++)
+                                   {a.accumulators[i]->Merge(b.accumulators[i]);}
+                                 a.nOriginalEvents      += b.nOriginalEvents;
+                                 a.nEventsInFile        += b.nEventsInFile;
+                                 a.nEventsInFileSkipped += b.nEventsInFileSkipped;
+                                 a.nEventsRequested     += b.nEventsRequested;
+                               });
         }
-      else
-        {std::cout << "Skipping " << file << " as not a rebdsim output file" << std::endl;}
-      f->Close();
-      delete f;
+      for (auto& t : threads)
+        {t.join();}
     }
+
+  // the accumulators in the map are attached to the output file
+  const PartialCombination& combined = partials[0];
+  for (std::size_t i = 0; i < histograms.size(); i++)
+    {histograms[i].accumulator->Merge(combined.accumulators[i]);}
+  for (auto& partial : partials)
+    {
+      for (auto acc : partial.accumulators)
+        {delete acc;}
+    }
+  TH1::AddDirectory(true);
+  BDSBH4DBase::AddDirectory(true);
+  unsigned long long int nOriginalEvents      = combined.nOriginalEvents;
+  unsigned long long int nEventsInFile        = combined.nEventsInFile;
+  unsigned long long int nEventsInFileSkipped = combined.nEventsInFileSkipped;
+  unsigned long long int nEventsRequested     = combined.nEventsRequested;
   
   // terminate and write output
   for (const auto& hist : histograms)
@@ -0,0 +1,74 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSACTIONINITIALIZATION_H
+#define BDSACTIONINITIALIZATION_H
+
+#include "globals.hh" // geant4 types / globals
+#include "G4VUserActionInitialization.hh"
+
+class BDSBunch;
+class BDSGlobalConstants;
+class BDSOutput;
+
+namespace GMAD
+{
+  class Beam;
+}
+
+/**
+ * @brief Construction of all user actions for a run.
+ *
+ * All user actions are constructed here rather than registered individually
+ * with the run manager. BDSIM uses the sequential BDSRunManager, so Geant4 calls
+ * Build() once. Multithreaded event processing is not supported: the output,
+ * sensitive detectors and registries are shared singletons. BuildForMaster()
+ * is only provided for completeness of the Geant4 interface.
+ *
+ * The output, bunch and beam definition are owned by BDSIM and are not deleted here.
+ *
+ * @author BDSIM Developers
+ */
+
+class BDSActionInitialization: public G4VUserActionInitialization
+{
+public:
+  BDSActionInitialization(BDSOutput*                outputIn,
+                          BDSBunch*                 bunchIn,
+                          const GMAD::Beam&         beamIn,
+                          const BDSGlobalConstants* globalsIn);
+  virtual ~BDSActionInitialization(){;}
+
+  /// Construct the run action only for the master thread.
+  virtual void BuildForMaster() const;
+
+  /// Construct the full set of user actions.
+  virtual void Build() const;
+
+private:
+  BDSActionInitialization() = delete;
+
+  /// @{ Cache of objects required to construct the actions.
+  BDSOutput*                output;
+  BDSBunch*                 bunch;
+  const GMAD::Beam&         beam;
+  const BDSGlobalConstants* globals;
+  /// @}
+};
+
+#endif
@@ -43,7 +43,8 @@ public:
   BDSArray1DCoords(G4int            nX,
                    G4double         xMinIn,
                    G4double         xMaxIn,
-                   BDSDimensionType dimensionIn = BDSDimensionType::x);
+                   BDSDimensionType dimensionIn = BDSDimensionType::x,
+                   BDSArray4D::ExternalStorage* externalStorageIn = nullptr);
   virtual ~BDSArray1DCoords(){;}
   
   /// Extract 2 points lying around coordinate x.
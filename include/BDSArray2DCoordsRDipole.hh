@@ -98,6 +98,9 @@ public:
 			 G4int t) const;
   /// @}
 
+  /// Data cannot be accessed directly as the data is reflected on access.
+  virtual G4bool DirectAccess() const {return false;}
+
   /// This prints out the raw underlying data, then the reflected version as would normally
   /// be queried.
   virtual std::ostream& Print(std::ostream& out) const;
@@ -71,6 +71,9 @@ public:
                                        G4double z = 0,
                                        G4double t = 0) const;
   
+  /// Data cannot be accessed directly as the index and value operators are applied on access.
+  virtual G4bool DirectAccess() const {return false;}
+
   virtual std::ostream& Print(std::ostream& out) const;
   
   /// Delegate function to call polymorphic Print().
@@ -47,7 +47,8 @@ public:
 		   G4double zMinIn, G4double zMaxIn,
 		   BDSDimensionType xDimensionIn = BDSDimensionType::x,
 		   BDSDimensionType yDimensionIn = BDSDimensionType::y,
-		   BDSDimensionType zDimensionIn = BDSDimensionType::z);
+		   BDSDimensionType zDimensionIn = BDSDimensionType::z,
+		   BDSArray4D::ExternalStorage* externalStorageIn = nullptr);
   virtual ~BDSArray3DCoords(){;}
   
   /// Extract 2x2x2 points lying around coordinate x.
@@ -43,6 +43,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  * https://isocpp.org/wiki/faq/operator-overloading#matrix-subscript-op
  * 
  * The size cannot be changed after construction.
+ *
+ * The values may instead be held by an ExternalStorage given at construction, e.g. a
+ * memory mapped file, in which case the array doesn't allocate its own. A copy of the
+ * array always holds its own copy of the values.
  * 
  * @author Laurie Nevay
  */
@@ -50,13 +54,29 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 class BDSArray4D
 {
 public:
+  /// Values held outside the array that are used in place of the array's own storage.
+  /// Derived classes release the underlying memory in their destructor.
+  class ExternalStorage
+  {
+  public:
+    explicit ExternalStorage(BDSFieldValue* valuesIn): values(valuesIn) {;}
+    virtual ~ExternalStorage(){;}
+    /// Start of nT*nZ*nY*nX values in T,Z,Y,X order.
+    BDSFieldValue* const values;
+  };
+
   /// No default constructor as the array is not adjustable after construction and
   /// therefore the size must be known at construction time.
   BDSArray4D() = delete;
   /// At construction the size of the array must be known as this implementation
-  /// does not allow the size to be changed afterwards.
-  BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn);
-  virtual ~BDSArray4D(){;}
+  /// does not allow the size to be changed afterwards. If externalStorageIn is given
+  /// the array takes ownership of it and uses its values.
+  BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn,
+	     ExternalStorage* externalStorageIn = nullptr);
+  /// Copy the values into the new array's own storage.
+  BDSArray4D(const BDSArray4D& other);
+  BDSArray4D& operator=(const BDSArray4D&) = delete;
+  virtual ~BDSArray4D();
 
   /// @{ Access the number of elements in a given dimension.
   inline G4int NX() const {return nX;}
@@ -94,6 +114,14 @@ public:
   const BDSFieldValue& operator()(const BDSFourVector<G4int>& pos) const
   {return operator()(pos.x(), pos.y(), pos.z(), pos.t());}
 
+  /// Whether the data may be read directly through Data() in place of GetConst(), i.e.
+  /// a derived class does not alter the indices or values on access.
+  virtual G4bool DirectAccess() const {return true;}
+
+  /// Read only access to the underlying contiguous data in T,Z,Y,X order. Only to be
+  /// used in place of GetConst() if DirectAccess() is true.
+  inline const BDSFieldValue* Data() const {return values;}
+
   /// Return whether the indices are valid and lie within the array boundaries or not.
   virtual G4bool Outside(G4int x,
 			 G4int y,
@@ -127,8 +155,11 @@ protected:
   BDSFieldValue defaultValue;
   
 private:
-  /// A 1D array representing all the data.
+  /// A 1D array representing all the data. Empty if externalStorage is used.
   std::vector<BDSFieldValue> data;
+
+  BDSFieldValue*   values;          ///< Either data or the external values.
+  ExternalStorage* externalStorage; ///< Owned if given.
 };
 
 #endif
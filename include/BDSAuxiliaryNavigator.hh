@@ -30,6 +30,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 class BDSStep;
 class G4Step;
 class G4VPhysicalVolume;
+class G4VSolid;
 
 /**
  * @brief Extra G4Navigator to get coordinate transforms.
@@ -57,6 +58,15 @@ class G4VPhysicalVolume;
  * use is one for the real world and one for the read out geometry / world
  * for curvilinear coordinates.  All functions have an optional last argument
  * to select which navigator is required - the default is the curvilinear one.
+ *
+ * The navigators are thread local as navigator state cannot be shared between
+ * threads. They are created on demand and attached to the registered world
+ * volumes. Note, BDSIM itself only runs events sequentially in one thread.
+ *
+ * Each instance caches the last curvilinear volume found when converting a
+ * position and direction to local coordinates. If the next point lies strictly
+ * inside the same volume, which has no daughters, its transform is reused without
+ * a navigator search. The number of cache hits and misses is counted per thread.
  * 
  * @author Laurie Nevay
  */
@@ -69,18 +79,26 @@ public:
 
   /// Setup the navigator w.r.t. to a world volume - typically real world.
   static void AttachWorldVolumeToNavigator(G4VPhysicalVolume* worldPVIn)
-  {auxNavigator->SetWorldVolume(worldPVIn); worldPV = worldPVIn;}
+  {InitialiseNavigators(); auxNavigator->SetWorldVolume(worldPVIn); worldPV = worldPVIn; cacheGeneration++;}
 
   /// Setup the navigator w.r.t. to the read out world / geometry to provide
   /// curvilinear coordinates.
   static void AttachWorldVolumeToNavigatorCL(G4VPhysicalVolume* curvilinearWorldPVIn)
-  {auxNavigatorCL->SetWorldVolume(curvilinearWorldPVIn); curvilinearWorldPV = curvilinearWorldPVIn;}
+  {InitialiseNavigators(); auxNavigatorCL->SetWorldVolume(curvilinearWorldPVIn); curvilinearWorldPV = curvilinearWorldPVIn; cacheGeneration++;}
 
   static void RegisterCurvilinearBridgeWorld(G4VPhysicalVolume* curvilinearBridgeWorldPVIn)
-  {auxNavigatorCLB->SetWorldVolume(curvilinearBridgeWorldPVIn); curvilinearBridgeWorldPV = curvilinearBridgeWorldPVIn;}
+  {InitialiseNavigators(); auxNavigatorCLB->SetWorldVolume(curvilinearBridgeWorldPVIn); curvilinearBridgeWorldPV = curvilinearBridgeWorldPVIn; cacheGeneration++;}
 
   static void ResetNavigatorStates();
 
+  /// @{ Number of times the curvilinear transform cache was used or not in this thread.
+  static G4long TransformCacheHits()   {return transformCacheHits;}
+  static G4long TransformCacheMisses() {return transformCacheMisses;}
+  /// @}
+
+  /// Print the number of hits and misses of the curvilinear transform cache for this thread.
+  static void PrintTransformCacheStatistics();
+
   /// A wrapper for the underlying static navigator instance located within this class.
   G4VPhysicalVolume* LocateGlobalPointAndSetup(const G4ThreeVector& point,
                                                const G4ThreeVector* direction = nullptr,
@@ -226,19 +244,23 @@ protected:
   
   /// Navigator object for safe navigation in the real (mass) world without
   /// affecting tracking of the particle.
-  static G4Navigator* auxNavigator;
+  static G4ThreadLocal G4Navigator* auxNavigator;
 
   /// Navigator object for curvilinear world that contains simple cylinders
   /// for each element whose local coordinates represent the curvilinear coordinate
   /// system.
-  static G4Navigator* auxNavigatorCL;
+  static G4ThreadLocal G4Navigator* auxNavigatorCL;
 
   /// Navigator object for bridge world. This contains bridging volumes for the
   /// gaps in the curvilinear world. It therefore acts as a fall back if we find
   /// the world volume when we know we really shouldn't.
-  static G4Navigator* auxNavigatorCLB;
+  static G4ThreadLocal G4Navigator* auxNavigatorCLB;
 
 private:
+  /// Construct the navigators for the current thread if they don't exist already and
+  /// attach any world volumes that have already been registered.
+  static void InitialiseNavigators();
+
   /// Utility function to select appropriate navigator
   G4Navigator* Navigator(G4bool curvilinear) const;
 
@@ -266,9 +288,35 @@ private:
                            const G4ThreeVector& globalMomentum,
                            const G4double       stepLength);
   
+  /// Whether the point lies strictly inside the cached curvilinear volume. If so,
+  /// the cached transforms are restored to the curvilinear ones in use.
+  G4bool UseCachedTransformCL(const G4ThreeVector& globalPoint) const;
+
+  /// Store the curvilinear volume just located and its transforms if it's suitable
+  /// to be reused, i.e. not a world or bridge volume and has no daughters.
+  void CacheTransformCL(G4VPhysicalVolume* selectedVol) const;
+
+  /// @{ Cache of the last curvilinear volume located with its transforms.
+  mutable G4VPhysicalVolume* cachedVolumeCL;
+  mutable const G4VSolid*    cachedSolidCL;
+  mutable G4AffineTransform  cachedGlobalToLocalCL;
+  mutable G4AffineTransform  cachedLocalToGlobalCL;
+  mutable G4int              cachedGeneration;
+  /// @}
+
+  /// Incremented whenever the navigators are reset or attached to a new world so
+  /// that any cached volumes in any instance are no longer used.
+  static G4ThreadLocal G4int cacheGeneration;
+
+  /// @{ Counters for the curvilinear transform cache.
+  static G4ThreadLocal G4long transformCacheHits;
+  static G4ThreadLocal G4long transformCacheMisses;
+  /// @}
+
   /// Counter to keep track of when the last instance of the class is deleted
   /// and therefore when the navigators can be safely deleted without affecting
-  static G4int numberOfInstances;
+  /// other instances. Per thread as the navigators are.
+  static G4ThreadLocal G4int numberOfInstances;
   
   /// @{ Cache of world PV to test if we're getting the wrong volume for the transform.
   static G4VPhysicalVolume* worldPV;
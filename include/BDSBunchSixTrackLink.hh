@@ -22,10 +22,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSBunch.hh"
 #include "BDSParticleExternal.hh"
 
+#include <map>
+#include <tuple>
 #include <vector>
 
 class BDSParticleCoordsFull;
 class BDSParticleDefinition;
+struct BDSLinkBatchInput;
 
 /**
  * @brief A bunch distribution that holds a bunch from Sixtrack Link.
@@ -35,6 +38,10 @@ class BDSParticleDefinition;
  * to aid memory management (avoid double deletion) we have a member in this class
  * for the current particle definition that is updated each time. The accessor is
  * overloaded to access that one instead of the base class one.
+ *
+ * Alternatively, a batch of particles can be given as a struct of arrays that
+ * is read in place. In this case, one particle definition is kept for each
+ * species (PDG ID and for ions A, Z and charge) rather than one per particle.
  * 
  * @author Laurie Nevay
  */
@@ -57,8 +64,14 @@ public:
   /// Delete all particle objects in the bunch and clear the vector.
   void ClearParticles();
 
+  /// Take particles from the arrays in a batch instead of the ones added with
+  /// AddParticle. The arrays must stay valid while tracking. nullptr returns to
+  /// the added particles.
+  void SetBatch(const BDSLinkBatchInput* batchIn);
+
   /// @{ Accessor.
-  inline size_t Size() const {return particles.size();}
+  inline size_t Size() const {return batch ? batchSize : particles.size();}
+  inline double BatchInputTime() const {return batchInputTime;} ///< Time (s) making batch particles since SetBatch.
   inline int    CurrentExternalParticleID() const {return currentExternalParticleID;}
   inline int    CurrentExternalParentID()   const {return currentExternalParentID;}
   /// @}
@@ -73,6 +86,13 @@ public:
   virtual void UpdateIonDefinition();
   
 private:
+  /// Get the next particle from the batch arrays.
+  BDSParticleCoordsFull GetNextBatchParticle();
+
+  /// Get the cached particle definition for batch particle i, making it if needed. The
+  /// total energy is only used to construct it as only the species is used later.
+  BDSParticleDefinition* BatchParticleDefinition(size_t i, G4double totalEnergy);
+
   G4int currentIndex;
   G4int currentExternalParticleID;
   G4int currentExternalParentID;
@@ -80,5 +100,11 @@ private:
 
   G4int size;         ///< Number of particles (1 counting).
   std::vector<BDSParticleExternal*> particles;
+
+  const BDSLinkBatchInput* batch; ///< Doesn't own.
+  size_t batchSize;
+  double batchInputTime;
+  /// Definitions by PDG ID, A, Z and charge. A, Z and charge are 0 if not given.
+  std::map<std::tuple<G4int, G4int, G4int, G4int>, BDSParticleDefinition*> batchParticleDefinitions;
 };
 #endif
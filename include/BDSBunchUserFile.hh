@@ -27,17 +27,23 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef USE_GZSTREAM
 #include "src-external/gzstream/gzstream.h"
 #endif
 
+class BDSBunchUserFileBinary;
 class BDSParticleCoordsFull;
 class BDSParticleCoordsFullGlobal;
 
 /**
  * @brief A bunch distribution that reads a user specified column file.
  * 
+ * The file may also be in the binary format written by bdsimuserfileconvert
+ * (see BDSBunchUserFileBinary), which is detected automatically. In this case
+ * skipping lines, looping and recreation seek directly to the right record.
+ *
  * @author Lawrence Deacon
  */
 
@@ -54,10 +60,10 @@ public:
 			  const G4double beamlineS = 0);
   virtual void CheckParameters();
 
-  /// Advance to the correct event number in the file for recreation. The implementation
-  /// is brute-force getting of the lines - this could be more efficient (certainly for
-  /// a file that is looped over multiple times) but this is simple, clear and the time
-  /// penalty is on the order of 1 minute for ~100k events.
+  /// Advance to the correct event number in the file for recreation. For a text file the
+  /// implementation is brute-force getting of the lines - this is simple and clear and the
+  /// time penalty is on the order of 1 minute for ~100k events. For a binary file this is
+  /// a single seek.
   virtual void RecreateAdvanceToEvent(G4int eventOffset);
 
   /// Override base class method to find valid particle over rest mass. For a bunch file
@@ -87,6 +93,10 @@ private:
   G4bool   anEnergyCoordinateInUse;///< Whether Et, Ek or P are in the columns.
   G4bool   changingParticleType;   ///< Whether the particle type is a column.
   G4bool   endOfFileReached;
+  G4bool   binaryFile;    ///< Whether the file is in the binary user file format.
+  BDSBunchUserFileBinary* binaryInput; ///< Reader used instead of InputBunchFile for a binary file.
+  std::vector<G4double>   recordValues;///< Values of the current binary record.
+  std::size_t             recordColumn;///< Index of the next value to use in recordValues.
 
   void ParseFileFormat(); ///< Parse the column tokens and units factors
   void OpenBunchFile();   ///< Open the file and check it's open.
@@ -109,7 +119,8 @@ private:
   T InputBunchFile;
 
   /// Read a word into a value. Templated so we can cleverly use different types
-  /// to read into directly such as int or double.
+  /// to read into directly such as int or double. For a binary file, the next value
+  /// from the current record is used instead and the stream is ignored.
   template <typename Type> void ReadValue(std::stringstream& stream, Type& value);
 
   /// Struct for name and unit pair.
@@ -139,6 +150,10 @@ private:
   /// Open the file and skip lines.
   virtual void Initialise();
 
+  /// Check the header of a binary file and take the column format from it if none
+  /// is specified. Throws an exception if both are given and they differ.
+  void CheckBinaryFileFormat();
+
   /// Print out warning we're looping and reopen file from beginning. Includes skipping
   /// lines. Put in a function as used in multiple places.
   void EndOfFileAction();
@@ -0,0 +1,114 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSBUNCHUSERFILEBINARY_H
+#define BDSBUNCHUSERFILEBINARY_H
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+/**
+ * @brief Reader and writer for the binary version of the user bunch file.
+ *
+ * The binary format is a fixed size header, the column format string (as
+ * distrFileFormat) and then one fixed width record of doubles per particle with
+ * the columns in the same order and units as the original text file. Only valid
+ * lines are stored, so comments, empty lines and any ignored header lines are
+ * removed on conversion. As every record is the same size, moving to any particle
+ * in the file is a single seek rather than reading through every line before it.
+ *
+ * A file is identified as binary by its magic number and not its name. Files are
+ * written with the bdsimuserfileconvert tool from a text user file.
+ *
+ * @author BDSIM Developers
+ */
+
+class BDSBunchUserFileBinary
+{
+public:
+  BDSBunchUserFileBinary();
+  ~BDSBunchUserFileBinary();
+
+  /// Whether the file starts with the magic number of the binary format. Returns
+  /// false for any file that can't be opened.
+  static G4bool IsBinaryFile(const G4String& fileName);
+
+  /// Open a file and read the header. Throws an exception if the file isn't a valid
+  /// binary user file. The file is left at the first record.
+  void OpenForReading(const G4String& fileName);
+
+  /// Open a file for writing records of nColumns values. The header is completed
+  /// when the file is closed.
+  void OpenForWriting(const G4String& fileName,
+                      const G4String& formatIn,
+                      G4int           nColumns);
+
+  /// Write one record. There must be the same number of values as columns.
+  void WriteRecord(const std::vector<G4double>& values);
+
+  /// Move to a record by index (counting from 0) so it's the next one read.
+  void SeekRecord(G4long index);
+
+  /// Read the next record into values. Returns false if there are no more records.
+  G4bool ReadRecord(std::vector<G4double>& values);
+
+  /// Close the file. If writing, the number of records is written into the header.
+  void Close();
+
+  /// @{ Accessor.
+  inline G4long   NRecords() const {return (G4long)header.nRecords;}
+  inline G4int    NColumns() const {return (G4int)header.nColumns;}
+  inline const G4String& Format() const {return format;}
+  /// @}
+
+  /// Version of the format written by this class.
+  static const uint32_t formatVersion;
+
+private:
+  /// Header of the binary format. Fixed width types only so the file is portable
+  /// between builds.
+  struct Header
+  {
+    char     magic[8];
+    uint32_t version;
+    uint32_t nColumns;
+    uint64_t nRecords;
+    uint32_t formatLength; ///< Number of characters in the format string following the header.
+    uint32_t padding;
+  };
+
+  /// The magic number at the start of every file.
+  static const char magicNumber[8];
+
+  /// Close file and throw an exception.
+  void Terminate(const G4String& message);
+
+  std::fstream   file;
+  G4String       fileName;
+  Header         header;
+  G4String       format;
+  std::streamoff dataStart;     ///< Byte offset of the first record.
+  G4long         currentRecord; ///< Index of the next record to be read.
+  G4bool         writing;
+};
+
+#endif
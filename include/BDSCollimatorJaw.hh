@@ -20,11 +20,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSCOLLIMATORJAW_H
 
 #include "BDSCollimator.hh"
+#include "BDSExtent.hh"
 
 #include "globals.hh" // geant4 types / globals
 #include "G4Material.hh"
+#include "G4ThreeVector.hh"
 
 class G4Colour;
+class G4LogicalVolume;
+class G4PVPlacement;
 class G4VSolid;
 
 /**
@@ -55,6 +59,20 @@ public:
   inline G4double GetJawTiltLeft() const {return jawTiltLeft;}
   inline G4double GetJawTiltRight() const {return jawTiltRight;}
 
+  /// Change the jaw half apertures, jaw tilts and optionally the jaw material of an
+  /// already built collimator in place. The jaw and vacuum solids are replaced and their
+  /// placements moved. Which jaws are built cannot be changed. The geometry must be open
+  /// for this component. If materialIn is nullptr, the jaw material is unchanged.
+  void UpdateJaws(G4double    xSizeLeftIn,
+                  G4double    xSizeRightIn,
+                  G4double    jawTiltLeftIn,
+                  G4double    jawTiltRightIn,
+                  G4Material* materialIn = nullptr);
+
+  /// Extent of the container required for a given pair of jaw tilts.
+  BDSExtent ContainerExtent(G4double jawTiltLeftIn,
+                            G4double jawTiltRightIn) const;
+
 protected:
   /// Check and update parameters before construction. Called at the start of Build() as
   /// we can't call a virtual function in a constructor.
@@ -69,6 +87,28 @@ protected:
   /// To fulfill inheritance but unused.
   virtual void BuildInnerCollimator() final {;}
 
+  /// Throw an exception if either tilted jaw crosses the mid-plane.
+  void CheckJawTilts() const;
+
+  /// Calculate the half gap of each jaw given the offsets and which jaws are built.
+  void JawHalfGaps(G4double& leftJawHalfGap,
+                   G4double& rightJawHalfGap) const;
+
+  /// Construct and register the solid for one jaw. jawName is "leftjaw" or "rightjaw".
+  G4VSolid* BuildJawSolid(const G4String& jawName,
+                          G4double        jawWidth,
+                          G4double        jawTilt);
+
+  /// Construct and register the vacuum solid between the jaws. The offset for
+  /// its placement is updated.
+  G4VSolid* BuildVacuumSolid(G4double       leftJawHalfGap,
+                             G4double       rightJawHalfGap,
+                             G4ThreeVector& vacuumOffset);
+
+  /// Swap the solid of a logical volume and delete the old one.
+  void ReplaceSolid(G4LogicalVolume* lv,
+                    G4VSolid*        newSolid);
+
   G4VSolid* jawSolid;        ///< Jaw solid.
   G4double  xSizeLeft;       ///< Offset of jaw 1
   G4double  xSizeRight;      ///< Offset of jaw 2
@@ -81,6 +121,12 @@ protected:
   G4bool    buildRightJaw;   ///< Build right jaw or not.
   G4bool    buildAperture;   ///< Build aperture or not.
 
+  /// @{ Cache of placements for in place updates.
+  G4PVPlacement* leftJawPV;
+  G4PVPlacement* rightJawPV;
+  G4PVPlacement* vacuumPV;
+  /// @}
+
 private:
   /// Private default constructor to force the use of the supplied one.
   BDSCollimatorJaw() = delete;
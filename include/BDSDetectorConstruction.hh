@@ -40,7 +40,7 @@ class G4VPhysicalVolume;
 namespace GMAD {
   class BLMPlacement;
   struct Element;
-  template<typename T> class FastList;
+  class ExpandedSequence;
   class Placement;
   class Query;
   class SamplerPlacement;
@@ -195,7 +195,7 @@ private:
   /// Convert a parser beamline_list to BDSAcceleratorComponents with help of
   /// BDSComponentFactory and put in a BDSBeamline container that calculates coordinates
   /// and extents of the beamline.
-  BDSBeamlineSet BuildBeamline(const GMAD::FastList<GMAD::Element>& beamLine,
+  BDSBeamlineSet BuildBeamline(const GMAD::ExpandedSequence& beamLine,
                                const G4String&            name,
                                const BDSBeamlineIntegral& startingIntegral,
                                BDSBeamlineIntegral*&      integral,
@@ -215,7 +215,7 @@ private:
 
   /// Detect whether the first element has an angled face such that it might overlap
   /// with a previous element.  Only used in case of a circular machine.
-  G4bool UnsuitableFirstElement(std::list<GMAD::Element>::const_iterator element);
+  G4bool UnsuitableFirstElement(const GMAD::ExpandedSequence& beamLine);
 
   /// Calculate local extent of custom user sampler.
   BDSExtent CalculateExtentOfSamplerPlacement(const GMAD::SamplerPlacement& sp) const;
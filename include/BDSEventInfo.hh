@@ -56,6 +56,7 @@ public:
   inline void SetAborted(G4bool abortedIn)              {info->aborted   = (bool)abortedIn;}
   inline void SetPrimaryHitMachine(G4bool hitIn)        {info->primaryHitMachine = (bool)hitIn;}
   inline void SetMemoryUsage(G4double memoryUsageMbIn)  {info->memoryUsageMb = (double)memoryUsageMbIn;}
+  inline void SetTrajectoryPointsPeakMemory(G4double peakMbIn) {info->trajectoryPointsPeakMb = (double)peakMbIn;}
   inline void SetPrimaryAbsorbedInCollimator(G4bool absorbed) {info->primaryAbsorbedInCollimator = absorbed;}
   inline void SetNTracks(long long int nTracks)         {info->nTracks = nTracks;}
   inline void SetBunchIndex(int bunchIndexIn)           {info->bunchIndex = bunchIndexIn;}
@@ -0,0 +1,210 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDARRAYCACHE_H
+#define BDSFIELDARRAYCACHE_H
+
+#include "BDSArrayReflectionType.hh"
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <cstddef>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class BDSArray4DCoords;
+
+/**
+ * @brief A holder for loaded field map arrays shared between all uses.
+ *
+ * Arrays are identified by the canonical path of the file they were loaded from,
+ * its size and modification time, and the number of dimensions. Therefore, the same
+ * map referred to by different relative paths or symbolic links is only loaded once,
+ * and a file rewritten on disk is loaded again. Only the file status is checked - the
+ * contents of the file are not read for this.
+ *
+ * Each time an array is returned its reference count is incremented. Each user
+ * (typically an interpolator) should call Release() when it no longer needs the
+ * array. An array with no references left is kept so that a subsequent model (e.g.
+ * the link interface initialised again) reuses it without loading the file. Unused
+ * arrays are only deleted by ClearCachedArrays() or EvictUnusedArrays().
+ *
+ * Transformed (reflected) wrappers of arrays are also cached so that fields using
+ * the same map with the same reflections share the wrapper. A wrapper holds one
+ * reference to the array it wraps and is itself reference counted.
+ *
+ * Tables derived from an array, such as the precomputed coefficients of an
+ * interpolator, may be stored alongside it so that all interpolators on that array
+ * share them. They are kept and deleted along with the array.
+ *
+ * This is separate from BDSFieldLoader so that it may outlive it - for example,
+ * between successive initialisations of the link interface.
+ *
+ * Singleton.
+ *
+ * @author BDSIM Developers
+ */
+
+class BDSFieldArrayCache
+{
+public:
+  /// Access the singleton instance.
+  static BDSFieldArrayCache* Instance();
+
+  ~BDSFieldArrayCache();
+
+  /// Release one reference to an array if the cache exists. Safe to call for arrays
+  /// that were never cached and after the cache has been deleted, in which case
+  /// nothing happens.
+  static void ReleaseIfCached(BDSArray4DCoords* array);
+
+  /// Delete all cached arrays (and transformed wrappers) irrespective of their
+  /// references. Statistics are not reset.
+  void ClearCachedArrays();
+
+  /// Retrieve a cached array loaded from the same file (same canonical path, size and
+  /// modification time) with the same number of dimensions. Will return nullptr if not
+  /// found. The caller holds one reference to the returned array.
+  BDSArray4DCoords* FindCachedArray(const G4String& filePath,
+                                    G4int           nDimensions);
+
+  /// Add an entry to the cache. The cache owns the array from now on and the caller
+  /// holds one reference to it.
+  void CacheArray(const G4String&   filePath,
+                  G4int             nDimensions,
+                  BDSArray4DCoords* array);
+
+  /// Retrieve the transformed wrapper of an array for a set of reflections. Will
+  /// return nullptr if not found. The caller holds one reference to the returned
+  /// wrapper but still holds its own reference to array.
+  BDSArray4DCoords* FindCachedTransformedArray(BDSArray4DCoords*                array,
+                                               const BDSArrayReflectionTypeSet& reflections);
+
+  /// Add a transformed wrapper of an array to the cache. The cache owns the wrapper
+  /// and the wrapper takes over the caller's reference to array. The caller holds one
+  /// reference to the wrapper.
+  void CacheTransformedArray(BDSArray4DCoords*                array,
+                             const BDSArrayReflectionTypeSet& reflections,
+                             BDSArray4DCoords*                transformedArray);
+
+  /// Take ownership of a wrapper of an array that is not shared (e.g. a reflected
+  /// Poisson quadrupole). As for CacheTransformedArray, the wrapper takes over the
+  /// caller's reference to array.
+  void AdoptWrapper(BDSArray4DCoords* array,
+                    BDSArray4DCoords* wrapper);
+
+  /// Release one reference to an array or wrapper. A wrapper with no references remaining
+  /// is deleted and the array it wraps is released. An array with no references remaining
+  /// is kept for reuse. Arrays not known to the cache are ignored.
+  void Release(BDSArray4DCoords* array);
+
+  /// Delete the least recently used arrays with no references (and their coefficient
+  /// tables) until the memory used by unused arrays is at most maxUnusedMemory (bytes).
+  /// The default of 0 deletes all unused arrays.
+  void EvictUnusedArrays(std::size_t maxUnusedMemory = 0);
+
+  /// Number of arrays held, including those with no references.
+  inline std::size_t NArrays() const {return arrays.size();}
+
+  /// @{ Number of times an array was found or not found in the cache.
+  inline G4long NHits()   const {return nHits;}
+  inline G4long NMisses() const {return nMisses;}
+  /// @}
+
+  /// Retrieve the coefficient table stored for an array. Will return an empty pointer
+  /// if there is none.
+  std::shared_ptr<const std::vector<G4double> > FindCoefficients(const BDSArray4DCoords* array) const;
+
+  /// Store a coefficient table for an array so other users of the array may share it. Only
+  /// stored if the array is held by the cache, as it is then known when the array is deleted.
+  void CacheCoefficients(const BDSArray4DCoords*                              array,
+                         const std::shared_ptr<const std::vector<G4double> >& table);
+
+  /// Print the number of hits and misses, and the memory used by the cached arrays.
+  /// Nothing is printed if the cache was never used.
+  void PrintStatistics() const;
+
+private:
+  BDSFieldArrayCache();
+
+  /// Identity of an array - canonical file path, file size and modification time
+  /// and number of dimensions.
+  struct ArrayKey
+  {
+    G4String    path;
+    long long   size;
+    std::time_t modificationTime;
+    long        modificationTimeNS;
+    G4int       nDimensions;
+    bool operator<(const ArrayKey& other) const;
+  };
+
+  /// Build the key for a file. Returns false if the file status cannot be read.
+  static G4bool FileKey(const G4String& filePath,
+                        G4int           nDimensions,
+                        ArrayKey&       key);
+
+  /// Memory used by the field values of an array.
+  static std::size_t ArrayMemory(const BDSArray4DCoords* array);
+
+  /// Memory used by the coefficient table of an array if there is one.
+  std::size_t CoefficientMemory(const BDSArray4DCoords* array) const;
+
+  static BDSFieldArrayCache* instance;
+
+  /// A cached array, the number of users it currently has and when it was last released.
+  struct ArrayEntry
+  {
+    BDSArray4DCoords* array;
+    G4int             nReferences;
+    G4long            lastReleased;
+  };
+
+  /// A wrapper, the array it wraps and the number of users it currently has.
+  struct WrapperEntry
+  {
+    BDSArray4DCoords* array;
+    G4int             nReferences;
+  };
+
+  typedef std::pair<BDSArray4DCoords*, BDSArrayReflectionTypeSet> TransformKey;
+
+  std::map<ArrayKey, ArrayEntry>              arrays;
+  std::map<const BDSArray4DCoords*, ArrayKey> arrayKeys;
+  std::map<TransformKey, BDSArray4DCoords*>   transformedArrays;
+  std::map<BDSArray4DCoords*, WrapperEntry>   wrappers;
+  std::map<const BDSArray4DCoords*, std::shared_ptr<const std::vector<G4double> > > coefficients;
+
+  /// @{ Statistics.
+  G4long nHits;
+  G4long nMisses;
+  G4long nTransformedHits;
+  G4long nTransformedMisses;
+  G4long nReleased;
+  G4long nEvicted;
+  std::size_t peakMemory;
+  /// @}
+
+  G4long releaseCounter; ///< Incremented on each release to order unused arrays.
+};
+
+#endif
@@ -25,6 +25,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Transform3D.hh"
 
 #include <utility>
+#include <vector>
 
 class BDSModulator;
 
@@ -52,6 +53,14 @@ public:
   /// x,y,z respectively.
   virtual std::pair<G4ThreeVector,G4ThreeVector> GetField(const G4ThreeVector& position,
 							  const G4double       t = 0) const = 0;
+
+  /// Get the B and E fields in local coordinates for many points at once. times must be
+  /// the same size as positions and the output vectors are resized to match. The default
+  /// calls GetField for each point.
+  virtual void GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+			     const std::vector<G4double>&      times,
+			     std::vector<G4ThreeVector>&       bFields,
+			     std::vector<G4ThreeVector>&       eFields) const;
   
   /// Each derived class should override this if needs be. Used to warn about
   /// time modulation with a time-varying field.
@@ -68,6 +77,12 @@ public:
   virtual std::pair<G4ThreeVector,G4ThreeVector> GetFieldTransformed(const G4ThreeVector& position,
 								     const G4double       t) const;
 
+  /// Batch version of GetFieldTransformed that uses GetFieldBatch.
+  virtual void GetFieldTransformedBatch(const std::vector<G4ThreeVector>& positions,
+					const std::vector<G4double>&      times,
+					std::vector<G4ThreeVector>&       bFields,
+					std::vector<G4ThreeVector>&       eFields) const;
+
   /// Set the transform applied before evaluating the field. This can be used
   /// to account for any difference between the field coordinate system and
   /// the coordinate system of the geometry.  Ie an offset aperture.  This is
@@ -52,9 +52,9 @@ class BDSMagnetStrength;
  * and construct into required field including the correct interpolator and possible
  * reflections.
  * 
- * This is a singleton as the field loader owns the loaded data arrays and reuses them
- * wrapping them in interpolators multiple times if needed. For this reason there should
- * be only one field loader.
+ * This is a singleton as there should be only one field loader. The loaded data arrays
+ * are owned by BDSFieldArrayCache and are reused, wrapping them in interpolators multiple
+ * times if needed. Each interpolator releases its array when it is deleted.
  * 
  * @author Laurie Nevay
  */
@@ -67,6 +67,7 @@ public:
 
   ~BDSFieldLoader();
 
+  /// Delete all cached arrays in BDSFieldArrayCache.
   void DeleteArrays();
 
   /// Main interface to load a magnetic field.
@@ -92,7 +93,7 @@ private:
   static void EFilePathOK(const BDSFieldInfo& info);
   /// @}
 
-  /// @{ Return the cached array if there is one - may return nullptr.
+  /// @{ Return the cached array from BDSFieldArrayCache if there is one - may return nullptr.
   BDSArray1DCoords* Get1DCached(const G4String& filePath);
   BDSArray2DCoords* Get2DCached(const G4String& filePath);
   BDSArray3DCoords* Get3DCached(const G4String& filePath);
@@ -272,13 +273,6 @@ private:
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
                                         const BDSArrayReflectionTypeSet* bReflection = nullptr);
-
-  /// @{ Map of cached field map array.
-  std::map<G4String, BDSArray1DCoords*> arrays1d;
-  std::map<G4String, BDSArray2DCoords*> arrays2d;
-  std::map<G4String, BDSArray3DCoords*> arrays3d;
-  std::map<G4String, BDSArray4DCoords*> arrays4d;
-  /// @}
 };
 
 #endif
@@ -0,0 +1,130 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDLOADERBDSIMBINARY_H
+#define BDSFIELDLOADERBDSIMBINARY_H
+
+#include "BDSArray4D.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <cstddef>
+#include <cstdint>
+
+class BDSArray4DCoords;
+class BDSArray3DCoords;
+class BDSArray2DCoords;
+class BDSArray1DCoords;
+
+/**
+ * @brief Loader and writer for the binary version of the BDSIM field format.
+ *
+ * The binary format is a fixed size header followed by the packed field
+ * components (x,y,z) for each point in the same T,Z,Y,X order as BDSArray4D
+ * stores them, i.e. adjacent array 'x' values are adjacent in the file. The
+ * header stores the number of points, the limits (in Geant4 units) and the
+ * spatial dimension represented by each array dimension, so the array can be
+ * constructed without parsing anything. The values may be stored as float or
+ * double.
+ *
+ * The file is memory mapped rather than read through a stream. If the stored
+ * precision matches BDSFieldValue, the array uses the mapped values in place with
+ * no copy and holds the mapping until it is deleted. The pages are then only read
+ * from disk as they are used and are shared with other processes mapping the same
+ * file. The mapping is private, so writing to the array copies only the page
+ * written. Otherwise the values are converted once into the array's own storage.
+ *
+ * A file is identified as binary by its magic number and not its name, so it
+ * can be used with the usual bdsim1d to bdsim4d formats. Files are written
+ * with the bdsimfieldconvert tool from the ASCII BDSIM format.
+ *
+ * @author BDSIM Developers
+ */
+
+class BDSFieldLoaderBDSIMBinary
+{
+public:
+  BDSFieldLoaderBDSIMBinary();
+  ~BDSFieldLoaderBDSIMBinary();
+
+  BDSArray4DCoords* Load4D(const G4String& fileName); ///< Load a 4D array.
+  BDSArray3DCoords* Load3D(const G4String& fileName); ///< Load a 3D array.
+  BDSArray2DCoords* Load2D(const G4String& fileName); ///< Load a 2D array.
+  BDSArray1DCoords* Load1D(const G4String& fileName); ///< Load a 1D array.
+
+  /// Whether the file starts with the magic number of the binary format. Returns
+  /// false for any file that can't be opened.
+  static G4bool IsBinaryFile(const G4String& fileName);
+
+  /// Write an array of nDim dimensions to file in the binary format. The values are
+  /// written in double precision if doublePrecision is true or float otherwise.
+  static void Write(const BDSArray4DCoords* array,
+                    G4int                   nDim,
+                    const G4String&         fileName,
+                    G4bool                  doublePrecision = false);
+
+  /// Version of the format written by this class.
+  static const uint32_t formatVersion;
+
+private:
+  /// Header of the binary format. Fixed width types only so the file is portable
+  /// between builds.
+  struct Header
+  {
+    char     magic[8];
+    uint32_t version;
+    uint32_t nDim;
+    uint32_t valueSize;        ///< Bytes per field component - 4 (float) or 8 (double).
+    int32_t  dimensionType[4]; ///< Underlying BDSDimensionType for each array dimension.
+    int32_t  n[4];
+    double   min[4];
+    double   max[4];
+  };
+
+  /// The magic number at the start of every file.
+  static const char magicNumber[8];
+
+  /// Unmap and close the file and throw an exception.
+  void Terminate(const G4String& message);
+
+  /// Open and memory map the whole file. Throws an exception if this fails.
+  void MapFile(const G4String& fileName);
+
+  /// Unmap and close the file if open.
+  void UnmapFile();
+
+  /// Close the file and give the mapping to a new storage object for the values
+  /// following the header.
+  BDSArray4D::ExternalStorage* ReleaseMapping();
+
+  /// General loader for any number of dimensions.
+  BDSArray4DCoords* Load(const G4String& fileName,
+                         const G4int     nDim);
+
+  /// Convert the mapped field values of storage type T into the array.
+  template <typename T>
+  void ReadValues(BDSArray4DCoords* array);
+
+  int         fileDescriptor;
+  char*       mappedData;  ///< Start of the mapped file.
+  std::size_t mappedSize;  ///< Size of the mapped file in bytes.
+  Header      header;
+};
+
+#endif
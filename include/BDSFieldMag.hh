@@ -24,6 +24,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
 
+#include <vector>
+
 class BDSModulator;
 
 /**
@@ -50,6 +52,14 @@ public:
   /// not need to apply the transform.
   virtual G4ThreeVector GetField(const G4ThreeVector& position,
 				 const G4double       t = 0) const = 0;
+
+  /// Get the magnetic field vector in local coordinates for many points at once. times
+  /// must be the same size as positions and fields is resized to match. The default
+  /// calls GetField for each point. Derived classes may override this to evaluate many
+  /// points more efficiently and must give the same result as GetField.
+  virtual void GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+			     const std::vector<G4double>&      times,
+			     std::vector<G4ThreeVector>&       fields) const;
   
   /// Each derived class should override this if needs be. Used to warn about
   /// time modulation with a time-varying field.
@@ -66,6 +76,12 @@ public:
   virtual G4ThreeVector GetFieldTransformed(const G4ThreeVector& position,
 					    const G4double       t) const;
 
+  /// Batch version of GetFieldTransformed that uses GetFieldBatch. As for GetFieldValue,
+  /// any time that is NaN is taken as 0.
+  virtual void GetFieldTransformedBatch(const std::vector<G4ThreeVector>& positions,
+					const std::vector<G4double>&      times,
+					std::vector<G4ThreeVector>&       fields) const;
+
   /// Set the transform applied before evaluating the field. This can be used
   /// to account for any difference between the field coordinate system and
   /// the coordinate system of the geometry.  Ie an offset aperture.  This is
@@ -33,6 +33,9 @@ class BDSMagnetStrength;
  * 
  * The magnetic field is calculated from the strength parameters
  * "kn" up to a specified order and a design rigidity (brho).
+ *
+ * The field is evaluated as a complex polynomial in x + iy whose coefficients
+ * are calculated once at construction.
  */
 
 class BDSFieldMagMultipole: public BDSFieldMag
@@ -48,6 +51,12 @@ public:
   virtual G4ThreeVector GetField(const G4ThreeVector &position,
 				 const G4double       t = 0) const;
 
+  /// Evaluate many points at once. Each step of the polynomial evaluation is applied
+  /// to all points in turn so the inner loop may be vectorised.
+  virtual void GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+			     const std::vector<G4double>&      times,
+			     std::vector<G4ThreeVector>&       fields) const;
+
 private:
   /// Private default constructor to force use of supplied constructor.
   BDSFieldMagMultipole();
@@ -65,6 +74,11 @@ private:
 
   /// Skew field components = kns * brho
   std::vector<G4double> skewComponents;
+
+  /// @{ Coefficients of the polynomial By + iBx = sum_m c_m (x + iy)^m.
+  std::vector<G4double> coefficientsReal;
+  std::vector<G4double> coefficientsImag;
+  /// @}
 };
 
 #endif 
@@ -43,6 +43,10 @@ class BDSMagnetStrength;
  * If a point close (< 6mm) to a pole is queried, the field is capped at the 
  * normalised value at the pole tip - assumed to be the highest value.
  *
+ * Away from the pole tip radius, the sum over the current sources is evaluated
+ * in closed form as a complex rational function of x + iy with constants
+ * calculated at construction.
+ *
  * This field of course does not accurately represent the field in the yoke
  * of a magnet as it neglects the permeability and the geometry, however, it
  * is a 1st order approximation.
@@ -69,6 +73,11 @@ public:
 				 const double         t = 0) const;
 
 private:
+  /// Sum the field from each current source in turn. This is used close to the
+  /// pole tip radius where the field is saturated near each source.
+  G4TwoVector SumCurrents(G4TwoVector pos,
+			  G4bool&     closeToPole) const;
+
   const G4int       order;           ///< N-poles / 2.
   G4double          phiOffset;       ///< Tilt in XY calculated from B vector of inner field. if B0=(0,1,0), phiOffset=0.
   G4double          spatialLimit;    ///< Radius from any current source within which the field is artificially saturated.
@@ -79,6 +88,13 @@ private:
   std::vector<G4TwoVector> currents; ///< Locations of infinite wire current sources.
   G4double          maxField;        ///< Any field beyond this will curtailed to this value.
   G4bool            initialisationPhase; ///< Need a way to control cludge normalisation behaviour during initial normalisation calculation.
+
+  /// @{ Constants for the closed form sum over the currents.
+  G4double          inverseAReal;
+  G4double          inverseAImag;
+  G4double          prefactorReal;
+  G4double          prefactorImag;
+  /// @}
 };
 
 #endif
@@ -24,6 +24,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh" // geant4 types / globals
 #include "G4ThreeVector.hh"
 
+#include <vector>
+
 class BDSMagnetStrength;
 
 /**
@@ -44,6 +46,11 @@ public:
   /// Access the field value.
   virtual G4ThreeVector GetField(const G4ThreeVector &position,
 				 const G4double       t = 0) const;
+
+  /// Evaluate many points without a virtual call for each one.
+  virtual void GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+			     const std::vector<G4double>&      times,
+			     std::vector<G4ThreeVector>&       fields) const;
   
 private:
   /// Private default constructor to force use of supplied constructor.
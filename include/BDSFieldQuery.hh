@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <array>
 #include <fstream>
 #include <vector>
 
@@ -65,6 +66,14 @@ protected:
                              G4double tGlobal,
                              G4double fieldValue[6]);
 
+  /// Get the field values for many points at once. fieldValues is resized to match
+  /// globalXYZ. By default this calls GetFieldValue for each point, but a derived class
+  /// may evaluate them together.
+  virtual void GetFieldValues(const std::vector<G4ThreeVector>&      globalXYZ,
+                              const G4ThreeVector&                   globalDirection,
+                              const std::vector<G4double>&           tGlobal,
+                              std::vector<std::array<G4double, 6> >& fieldValues);
+
   /// Warn the user if the fieldObject variable is use when it shouldn't be.
   virtual void CheckIfFieldObjectSpecified(const BDSFieldQueryInfo* query) const;
   
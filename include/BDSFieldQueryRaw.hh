@@ -24,6 +24,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <array>
+#include <vector>
+
+class BDSFieldE;
+class BDSFieldEM;
+class BDSFieldMag;
 class BDSFieldQueryInfo;
 class G4Field;
 
@@ -53,6 +59,13 @@ protected:
 			     const G4ThreeVector& globalDirection,
 			     G4double tGlobal,
 			     G4double fieldValue[6]);
+
+  /// If the field is a BDSIM field, use its batch interface to evaluate all the points
+  /// together, otherwise query each point.
+  virtual void GetFieldValues(const std::vector<G4ThreeVector>&      globalXYZ,
+			      const G4ThreeVector&                   globalDirection,
+			      const std::vector<G4double>&           tGlobal,
+			      std::vector<std::array<G4double, 6> >& fieldValues);
   
   /// Do the opposite for this class as it's only used for the interpolator and we want
   /// fieldObject to be specified.
@@ -65,6 +78,12 @@ private:
   /// @}
 
   G4Field* field; ///< The field object to query.
+
+  /// @{ Cache of field cast to BDSIM field types for batch queries - may be nullptr.
+  const BDSFieldMag* fieldMag;
+  const BDSFieldE*   fieldE;
+  const BDSFieldEM*  fieldEM;
+  /// @}
 };
 
 #endif
@@ -103,6 +103,8 @@ public:
   inline G4bool   OutputFileNameSet()      const {return G4bool  (options.HasBeenSet("outputFileName"));}
   inline BDSOutputType OutputFormat()      const {return outputType;}
   inline G4int    OutputCompressionLevel() const {return G4int   (options.outputCompressionLevel);}
+  inline G4bool   OutputAsynchronous()     const {return G4bool  (options.outputAsynchronous);}
+  inline G4int    OutputCompressionThreads() const {return G4int (options.outputCompressionThreads);}
   inline G4bool   Survey()                 const {return G4bool  (options.survey);}
   inline G4String SurveyFileName()         const {return G4String(options.surveyFileName);}
   inline G4bool   Batch()                  const {return G4bool  (options.batch);}
@@ -289,6 +291,8 @@ public:
   inline G4bool   StoreSamplerMass()         const {return G4bool  (options.storeSamplerMass);}
   inline G4bool   StoreSamplerRigidity()     const {return G4bool  (options.storeSamplerRigidity);}
   inline G4bool   StoreSamplerIon()          const {return G4bool  (options.storeSamplerIon);}
+  inline G4bool   StoreSamplerCompact()      const {return G4bool  (options.storeSamplerCompact);}
+  inline G4int    SamplerSignificantBits()   const {return G4int   (options.samplerSignificantBits);}
   inline G4bool   StoreModel()               const {return G4bool  (options.storeModel);}
   inline G4int    SamplersSplitLevel()       const {return G4int   (options.samplersSplitLevel);}
   inline G4int    ModelSplitLevel()          const {return G4int   (options.modelSplitLevel);}
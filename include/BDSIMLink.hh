@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSIMLINK_H
 #define BDSIMLINK_H
 #include "BDSHitSamplerLink.hh"
+#include "BDSLinkBatch.hh"
 #include "BDSLinkRunAction.hh"
 
 #include <map>
@@ -51,6 +52,9 @@ class G4VModularPhysicsList;
  * bds->Initialise(argc, argv);
  * bds->TrackThin(...)
  *
+ * For many particles at once, TrackBatch() takes and returns struct of
+ * arrays buffers owned by the caller, avoiding per-particle objects.
+ *
  * @author Laurie Nevay
  */
 
@@ -84,6 +88,13 @@ public:
   /// from the standard input e.g. the executable option ngenerate and then the one specified
   /// in the input gmad files as an option.
   void BeamOn(int nGenerate=-1);
+
+  /// Track all the particles in the input arrays in the currently selected element and
+  /// write the returned particles directly to the caller's output arrays, along with the
+  /// time spent. The output counts and timing are reset first. Requires the bunch given
+  /// at construction to be a BDSBunchSixTrackLink. SamplerHits() is not filled.
+  void TrackBatch(const BDSLinkBatchInput& input,
+                  BDSLinkBatchOutput&      output);
   
   void SelectLinkElement(const std::string& elementName, bool debug = false);
   void SelectLinkElement(int index, bool debug = false);
@@ -105,6 +116,18 @@ public:
                            double crystalAngle  = 0,
 			   bool   sampleIn      = false);
 
+  /// Change the jaw half apertures, jaw tilts and optionally the material of a collimator
+  /// that has already been added, without rebuilding the rest of the model. Only the
+  /// navigation optimisation (voxels) of this one element is rebuilt and the physics tables
+  /// are kept. Which jaws are built, the length, rotation and offsets cannot be changed this
+  /// way. If materialName is empty, the material is unchanged.
+  void UpdateLinkCollimatorJaw(const std::string& collimatorName,
+                               double halfApertureLeft,
+                               double halfApertureRight,
+                               double jawTiltLeft = 0.0,
+                               double jawTiltRight = 0.0,
+                               const std::string& materialName = "");
+
   BDSHitsCollectionSamplerLink* SamplerHits() const;
   void ClearSamplerHits() {runAction->ClearSamplerHits();}
   
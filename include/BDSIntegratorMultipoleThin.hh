@@ -22,7 +22,6 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSIntegratorMag.hh"
 
 #include "globals.hh"
-#include <list>
 #include <vector>
 
 class G4Mag_EqRhs;
@@ -74,10 +73,9 @@ private:
 
   /// Dipole component
   G4double b0l;
-  /// @{ Higher order components
-  std::list<double>  bnl;
-  std::list<double>  bsl;
-  std::vector<G4int> nfact;
+  /// @{ Higher order components as polynomial coefficients in x + iy, i.e. kn / n!.
+  std::vector<G4double> normalCoefficients;
+  std::vector<G4double> skewCoefficients;
   /// @}
 };
 
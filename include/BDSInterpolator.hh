@@ -27,21 +27,17 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 /**
  * @brief Interface for all interpolators containing basic extent of validity.
  *
+ * On deletion, the array given at construction is released from BDSFieldArrayCache
+ * (if it came from there) so the array is deleted when it is no longer used.
+ *
  * @author Laurie Nevay
  */
 
 class BDSInterpolator
 {
 public:
-  explicit BDSInterpolator(BDSArray4DCoords* arrayIn = nullptr):
-    smallestSpatialStep(std::numeric_limits<double>::max())
-  {
-    if (arrayIn)
-      {smallestSpatialStep = arrayIn->SmallestSpatialStep();}
-    else
-      {throw BDSException(__METHOD_NAME__, "Invalid array to construct interpolator on.");}
-  }
-  virtual ~BDSInterpolator(){;}
+  explicit BDSInterpolator(BDSArray4DCoords* arrayIn = nullptr);
+  virtual ~BDSInterpolator();
 
   /// Interface each derived class must provide.
   virtual BDSExtent Extent() const = 0;
@@ -54,6 +50,10 @@ public:
   
 protected:
   G4double smallestSpatialStep;
+
+private:
+  /// The array as given at construction for releasing from the cache.
+  BDSArray4DCoords* arrayReference;
 };
 
 #endif
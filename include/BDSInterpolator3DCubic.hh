@@ -35,6 +35,9 @@ class BDSArray3DCoords;
  * the value at any arbitrary point. If the point lies outside the array
  * the default value for the templated parameter is returned (typically 0).
  * Therefore, the field drops to 0 outside the specified region.
+ *
+ * If the array has no transform and all the required points lie inside it,
+ * the points are read directly from the array storage without copying them.
  * 
  * @author Laurie Nevay
  */
@@ -51,6 +54,9 @@ protected:
 private:
   /// Private default constructor to force use of provided one.
   BDSInterpolator3DCubic() = delete;
+
+  /// Cache of whether the array data can be read directly (i.e. no reflections).
+  G4bool directAccess;
 };
 
 #endif
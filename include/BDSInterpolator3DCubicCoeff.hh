@@ -0,0 +1,86 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSINTERPOLATOR3DCUBICCOEFF_H
+#define BDSINTERPOLATOR3DCUBICCOEFF_H
+
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3D.hh"
+
+#include "G4Types.hh"
+
+#include <memory>
+#include <vector>
+
+class BDSArray3DCoords;
+
+/** 
+ * @brief Cubic interpolation over 3d array with precomputed coefficients.
+ * 
+ * Does not own array - so multiple interpolators could be used on same data.
+ * 
+ * This gives the same result as BDSInterpolator3DCubic, but the tricubic polynomial
+ * for each cell of the array is calculated once at construction. A query then only
+ * requires finding the cell and evaluating its polynomial. This uses 64 coefficients
+ * for each of the 3 field components per cell, kept as doubles irrespective of the field
+ * value type. This is ~64x the memory of the field map when BDSFieldValue is double
+ * precision and ~128x when it is single precision (the default), so is intended for maps
+ * queried a very large number of times. The memory used and the time taken to prepare
+ * the coefficients are printed on construction.
+ *
+ * The coefficients are stored in BDSFieldArrayCache alongside the array so that all
+ * interpolators on the same loaded array share one table.
+ *
+ * Points outside the cells spanned by the array use the same method as
+ * BDSInterpolator3DCubic. If the array has a transform (e.g. reflection), no coefficients
+ * are prepared and all queries use this method.
+ * 
+ * @author BDSIM Developers
+ */
+
+class BDSInterpolator3DCubicCoeff: public BDSInterpolator3D
+{
+public:
+  explicit BDSInterpolator3DCubicCoeff(BDSArray3DCoords* arrayIn);
+  virtual ~BDSInterpolator3DCubicCoeff();
+
+  /// Memory used by the coefficients in bytes.
+  inline size_t CoefficientMemory() const {return coefficients ? coefficients->size() * sizeof(G4double) : 0;}
+
+protected:
+  virtual BDSFieldValue GetInterpolatedValueT(G4double x, G4double y, G4double z) const;
+
+private:
+  /// Private default constructor to force use of provided one.
+  BDSInterpolator3DCubicCoeff() = delete;
+
+  /// Calculate the polynomial coefficients for every cell of the array.
+  std::shared_ptr<const std::vector<G4double> > PrepareCoefficients() const;
+
+  /// Number of cells in each dimension (one less than the number of points).
+  G4int nCellsX;
+  G4int nCellsY;
+  G4int nCellsZ;
+
+  /// Coefficients for each cell stored consecutively. For each cell there are 64
+  /// sets of (x,y,z) components indexed by power of (z*4 + y)*4 + x. Shared with
+  /// other interpolators on the same array.
+  std::shared_ptr<const std::vector<G4double> > coefficients;
+};
+
+#endif
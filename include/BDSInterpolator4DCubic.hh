@@ -30,6 +30,9 @@ class BDSArray4DCoords;
  * @brief Cubic interpolation over 4d array.
  * 
  * Does not own array - so multiple interpolators could be used on same data.
+ *
+ * If the array has no transform and all the required points lie inside it,
+ * the points are read directly from the array storage without copying them.
  * 
  * @author Laurie Nevay
  */
@@ -49,6 +52,9 @@ protected:
 private:
   /// Private default constructor to force use of provided one.
   BDSInterpolator4DCubic() = delete;
+
+  /// Cache of whether the array data can be read directly (i.e. no reflections).
+  G4bool directAccess;
 };
 
 #endif
@@ -139,6 +139,89 @@ namespace BDS
     return BDS::Cubic1D<T>(arr, x);
   }
 
+  /// Weights for each of the 4 points in Cubic1D for a fractional coordinate 'x' on
+  /// the interval [0,1] such that Cubic1D(p,x) = sum_i w[i]*p[i]. As the cubic
+  /// interpolation is separable, the weights for each dimension can be used to
+  /// interpolate in any number of dimensions in one pass over the points.
+  inline void CubicWeights(G4double x,
+                           G4double (&w)[4])
+  {
+    G4double x2 = x*x;
+    G4double x3 = x2*x;
+    w[0] = 0.5*(-x + 2.*x2 - x3);
+    w[1] = 1. + 0.5*(-5.*x2 + 3.*x3);
+    w[2] = 0.5*(x + 4.*x2 - 3.*x3);
+    w[3] = 0.5*(x3 - x2);
+  }
+
+  /// Sum of 4 contiguous field values along the first (array 'x') dimension using
+  /// the weights w. The result is accumulated into r (3 components).
+  inline void CubicRowSum(const BDSFieldValue* row,
+                          const G4double (&w)[4],
+                          G4double         factor,
+                          G4double (&r)[3])
+  {
+    r[0] += factor * (w[0]*row[0].x() + w[1]*row[1].x() + w[2]*row[2].x() + w[3]*row[3].x());
+    r[1] += factor * (w[0]*row[0].y() + w[1]*row[1].y() + w[2]*row[2].y() + w[3]*row[3].y());
+    r[2] += factor * (w[0]*row[0].z() + w[1]*row[1].z() + w[2]*row[2].z() + w[3]*row[3].z());
+  }
+
+  /// Cubic interpolation in 3 dimensions reading the 4x4x4 points directly from
+  /// contiguous storage. 'origin' is the first (lowest index) of the points and
+  /// strideY and strideZ are the number of values between successive points in the
+  /// 2nd and 3rd dimensions. The 1st dimension must be contiguous. This is equivalent
+  /// to Cubic3D but with no copy of the points and can be vectorised by the compiler.
+  inline BDSFieldValue Cubic3DContiguous(const BDSFieldValue* origin,
+                                         long                 strideY,
+                                         long                 strideZ,
+                                         G4double x,
+                                         G4double y,
+                                         G4double z)
+  {
+    G4double wx[4], wy[4], wz[4];
+    CubicWeights(x, wx);
+    CubicWeights(y, wy);
+    CubicWeights(z, wz);
+    G4double r[3] = {0, 0, 0};
+    for (G4int k = 0; k < 4; k++)
+      {
+        const BDSFieldValue* plane = origin + k*strideZ;
+        for (G4int j = 0; j < 4; j++)
+          {CubicRowSum(plane + j*strideY, wx, wz[k]*wy[j], r);}
+      }
+    return BDSFieldValue((FIELDTYPET)r[0], (FIELDTYPET)r[1], (FIELDTYPET)r[2]);
+  }
+
+  /// Cubic interpolation in 4 dimensions reading the 4x4x4x4 points directly from
+  /// contiguous storage. As Cubic3DContiguous but with strideT for the 4th dimension.
+  inline BDSFieldValue Cubic4DContiguous(const BDSFieldValue* origin,
+                                         long                 strideY,
+                                         long                 strideZ,
+                                         long                 strideT,
+                                         G4double x,
+                                         G4double y,
+                                         G4double z,
+                                         G4double t)
+  {
+    G4double wx[4], wy[4], wz[4], wt[4];
+    CubicWeights(x, wx);
+    CubicWeights(y, wy);
+    CubicWeights(z, wz);
+    CubicWeights(t, wt);
+    G4double r[3] = {0, 0, 0};
+    for (G4int l = 0; l < 4; l++)
+      {
+        for (G4int k = 0; k < 4; k++)
+          {
+            const BDSFieldValue* plane = origin + l*strideT + k*strideZ;
+            G4double wtz = wt[l]*wz[k];
+            for (G4int j = 0; j < 4; j++)
+              {CubicRowSum(plane + j*strideY, wx, wtz*wy[j], r);}
+          }
+      }
+    return BDSFieldValue((FIELDTYPET)r[0], (FIELDTYPET)r[1], (FIELDTYPET)r[2]);
+  }
+
   /// Linear interpolation of the magnitude in 1 dimension
   template<class T>
   double Linear1DMagOnly(const T p[2],
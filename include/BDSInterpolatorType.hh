@@ -40,7 +40,8 @@ struct interpolatortypes_def
       nearest1d, linear1d, linearmag1d, cubic1d,
       nearest2d, linear2d, linearmag2d, cubic2d,
       nearest3d, linear3d, linearmag3d, cubic3d,
-      nearest4d, linear4d, linearmag4d, cubic4d
+      nearest4d, linear4d, linearmag4d, cubic4d,
+      cubiccoeff3d
     };
 };
 
@@ -0,0 +1,110 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSLINKBATCH_H
+#define BDSLINKBATCH_H
+
+#include <cstddef>
+
+/**
+ * @brief Struct of arrays of particles given to BDSIMLink::TrackBatch.
+ *
+ * The arrays belong to the caller and must each hold at least n values
+ * until tracking is finished. They are read in place and not copied. Units
+ * are those used by external trackers: m, rad, s and GeV for the total energy.
+ * parentID may be nullptr, in which case 0 is used. A, Z and charge (in units
+ * of e) are only used for ions and may also be nullptr, in which case the ion
+ * is taken from the PDG ID and assumed to be fully stripped. These allow partially
+ * stripped ions as with the Z, A and charge given to each particle individually.
+ *
+ * @author BDSIM Developers
+ */
+
+struct BDSLinkBatchInput
+{
+  std::size_t   n           = 0;
+  const double* x           = nullptr;
+  const double* xp          = nullptr;
+  const double* y           = nullptr;
+  const double* yp          = nullptr;
+  const double* t           = nullptr;
+  const double* totalEnergy = nullptr;
+  const int*    pdgID       = nullptr;
+  const int*    id          = nullptr;
+  const int*    parentID    = nullptr;
+  const int*    A           = nullptr;
+  const int*    Z           = nullptr;
+  const int*    charge      = nullptr;
+};
+
+/**
+ * @brief Time spent in each part of one call of BDSIMLink::TrackBatch (s).
+ *
+ * @author BDSIM Developers
+ */
+
+struct BDSLinkBatchTiming
+{
+  double input    = 0; ///< Preparing the input particles, including making each primary.
+  double tracking = 0; ///< Tracking excluding the input and writing the output.
+  double output   = 0; ///< Writing the returned particles to the output buffer.
+  double total    = 0;
+};
+
+/**
+ * @brief Struct of arrays of particles returned by BDSIMLink::TrackBatch.
+ *
+ * The arrays are allocated by the caller with room for capacity particles and
+ * are written directly by BDSSDSamplerLink as each particle arrives, so no hit
+ * objects are made. Any array that isn't required may be left as nullptr and isn't
+ * written. Units are as for BDSLinkBatchInput, with the mass in GeV and the charge
+ * in units of e. Surviving primaries and secondaries are mixed in the order they arrive. A
+ * secondary has parentID equal to the id of the primary and a new id above the
+ * current maximum given to BDSIMLink. nPrimaries and nSecondaries count every
+ * particle returned. Those beyond capacity are counted in nNotStored but not written.
+ *
+ * @author BDSIM Developers
+ */
+
+struct BDSLinkBatchOutput
+{
+  std::size_t capacity    = 0;
+  double*     x           = nullptr;
+  double*     xp          = nullptr;
+  double*     y           = nullptr;
+  double*     yp          = nullptr;
+  double*     t           = nullptr;
+  double*     totalEnergy = nullptr;
+  double*     mass        = nullptr;
+  double*     charge      = nullptr;
+  int*        pdgID       = nullptr;
+  int*        Z           = nullptr;
+  int*        A           = nullptr;
+  int*        id          = nullptr;
+  int*        parentID    = nullptr;
+
+  /// @{ Filled in by tracking.
+  std::size_t size         = 0; ///< Number of particles written.
+  std::size_t nPrimaries   = 0;
+  std::size_t nSecondaries = 0;
+  std::size_t nNotStored   = 0;
+  BDSLinkBatchTiming timing;
+  /// @}
+};
+
+#endif
@@ -27,11 +27,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Version.hh"
 #include "G4VUserDetectorConstruction.hh"
 
+#include <map>
 #include <string>
 
 class BDSBeamline;
 class BDSBeamlineElement;
 class BDSBeamlineIntegral;
+class BDSLinkOpaqueBox;
 class BDSLinkPrimaryGeneratorAction;
 class BDSLinkRegistry;
 class BDSParticleDefinition;
@@ -70,6 +72,20 @@ public:
 			     G4bool   isACrystal    = false,
 			     G4double crystalAngle  = 0,
 			     G4bool   sampleIn      = false);
+
+  /// Change the jaw half apertures, jaw tilts and optionally the material of a collimator
+  /// already added to the link in place without rebuilding any other geometry. If materialName
+  /// is empty, the material is unchanged. The geometry must be open for the placement of this
+  /// element (see LinkPlacement()).
+  void UpdateLinkCollimatorJaw(const std::string& collimatorName,
+                               G4double halfApertureLeft,
+                               G4double halfApertureRight,
+                               G4double jawTiltLeft = 0.0,
+                               G4double jawTiltRight = 0.0,
+                               const std::string& materialName = "");
+
+  /// Placement in the world of the link element with this name. nullptr if not found.
+  G4VPhysicalVolume* LinkPlacement(const std::string& elementName) const;
   
   /// Set the design particle definition.
   inline void SetDesignParticle(const BDSParticleDefinition* defIn) {designParticle = defIn;}
@@ -97,6 +113,9 @@ public:
   /// Place a beam line element in the world.
   G4int PlaceOneComponent(const BDSBeamlineElement* element, const G4String& originalName);
 
+  /// Convert a material name used by the external tracker to a BDSIM one.
+  std::string LinkMaterialName(const std::string& materialName) const;
+
   G4Box* worldSolid;
   G4VPhysicalVolume* worldPV;
   BDSExtent worldExtent;
@@ -118,6 +137,11 @@ public:
 
   std::map<std::string, G4int> nameToElementIndex; ///< Build up a copy here too.
   std::map<G4int, G4int> linkIDToBeamlineIndex;    ///< Special linkID to linkBeamline index
+
+  /// @{ Cache of each placed element by linkID for in place updates.
+  std::map<G4int, BDSLinkOpaqueBox*>   linkIDToOpaqueBox;
+  std::map<G4int, G4VPhysicalVolume*> linkIDToPlacement;
+  /// @}
 };
 
 #endif
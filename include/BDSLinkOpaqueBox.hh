@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSLINKOPAQUEBOX_H
 #define BDSLINKOPAQUEBOX_H
 #include "BDSAcceleratorComponent.hh"
+#include "BDSTiltOffset.hh"
 #include "BDSUtilities.hh"
 
 #include "G4ThreeVector.hh"
@@ -28,6 +29,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSGeometryComponent.hh"
 
 class BDSAcceleratorComponent;
+class BDSExtent;
 class BDSSamplerCustom;
 
 /**
@@ -57,17 +59,25 @@ public:
 
   /// Place the output sampler
   G4int PlaceOutputSampler();
+
+  /// Whether a component of this extent would fit inside the opaque box with the
+  /// same tilt and offset the wrapped component was placed with.
+  G4bool Encompasses(const BDSExtent& componentExtent) const;
   
   /// @{ Accessor
   G4double ArcLength()   const {return component ? component->GetArcLength() : 0.0;}
   G4double ChordLength() const {return component ? component->GetChordLength() : 0.0;}
   G4bool   Angled()      const {return component ? BDS::IsFinite(component->GetAngle()) : false;}
   G4String LinkName()    const {return component ? component->GetName() : "unknown";}
+  BDSAcceleratorComponent* AcceleratorComponent() const {return component;}
   /// @}
 
 private:
   BDSAcceleratorComponent* component;
   G4double                 outputSamplerRadius;
+  BDSTiltOffset            tiltOffset;
+  G4double                 innerHalfWidth;  ///< Transverse half width inside the opaque box.
+  G4double                 innerHalfLength; ///< Half length inside the opaque box.
   G4ThreeVector            offsetToStart;
   G4Transform3D            transformToStart;
   BDSSamplerCustom*        sampler;
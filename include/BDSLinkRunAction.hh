@@ -23,7 +23,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Types.hh"
 #include "G4UserRunAction.hh"
 
+class BDSParticleCoordsFull;
 class G4Run;
+struct BDSLinkBatchOutput;
 
 /**
  * @brief Simplified run action to hold link hits.
@@ -45,6 +47,23 @@ public:
 		              G4int externalParentID,
 		              const BDSHitsCollectionSamplerLink* hits);
 
+  /// Write returned particles directly to this buffer instead of making hits.
+  /// nullptr to return to hits.
+  void SetBatchOutput(BDSLinkBatchOutput* batchOutputIn) {batchOutput = batchOutputIn;}
+  inline G4bool Batching() const {return batchOutput != nullptr;}
+
+  /// Assign the external IDs of one returned particle and write it to the batch
+  /// output in external units. Called by BDSSDSamplerLink in place of making a hit.
+  void WriteToBatch(const BDSParticleCoordsFull& coords,
+                    G4double mass,
+                    G4double charge,
+                    G4int    pdgID,
+                    G4int    Z,
+                    G4int    A,
+                    G4int    parentID,
+                    G4int    externalParticleID,
+                    G4int    externalParentID);
+
   BDSHitsCollectionSamplerLink* SamplerHits() const {return allHits;}
   void ClearSamplerHits() {delete allHits; allHits = nullptr;}
 
@@ -54,7 +73,16 @@ public:
   inline void SetMaximumExternalParticleID(G4int maxExtPartID) {maximumExternalParticleID = maxExtPartID;}
   
 private:
+  /// Primaries keep the IDs of the event. Secondaries get a new ID above the
+  /// current maximum and the primary as their parent.
+  void AssignExternalIDs(G4int  parentID,
+                         G4int  externalParticleID,
+                         G4int  externalParentID,
+                         G4int& hitExternalParticleID,
+                         G4int& hitExternalParentID);
+
   BDSHitsCollectionSamplerLink* allHits;
+  BDSLinkBatchOutput* batchOutput; ///< Doesn't own.
   G4int nSecondariesToReturn;
   G4int nPrimariesToReturn;
   G4int maximumExternalParticleID;
@@ -0,0 +1,100 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSMULTIPOLEROUTINES_H
+#define BDSMULTIPOLEROUTINES_H
+
+#include "G4Types.hh"
+
+namespace BDS
+{
+  // These routines use complex arithmetic written out in real and imaginary parts
+  // rather than std::complex, whose multiplication and division include checks for
+  // infinite and NaN values that are slow and not required here.
+
+  /// Evaluate the polynomial sum_{i=0}^{n-1} c_i z^i for z = x + iy using Horner's method.
+  /// The real and imaginary parts of the coefficients are given as separate arrays
+  /// of length n.
+  inline void ComplexHorner(const G4double* cReal,
+			    const G4double* cImag,
+			    G4int           n,
+			    G4double        x,
+			    G4double        y,
+			    G4double&       resultReal,
+			    G4double&       resultImag)
+  {
+    G4double re = 0;
+    G4double im = 0;
+    for (G4int i = n-1; i >= 0; i--)
+      {
+	G4double reNew = re*x - im*y + cReal[i];
+	im = re*y + im*x + cImag[i];
+	re = reNew;
+      }
+    resultReal = re;
+    resultImag = im;
+  }
+
+  /// As above but for real coefficients c_i.
+  inline void ComplexHorner(const G4double* c,
+			    G4int           n,
+			    G4double        x,
+			    G4double        y,
+			    G4double&       resultReal,
+			    G4double&       resultImag)
+  {
+    G4double re = 0;
+    G4double im = 0;
+    for (G4int i = n-1; i >= 0; i--)
+      {
+	G4double reNew = re*x - im*y + c[i];
+	im = re*y + im*x;
+	re = reNew;
+      }
+    resultReal = re;
+    resultImag = im;
+  }
+
+  /// Raise z = x + iy to a non-negative integer power by repeated squaring.
+  inline void ComplexPower(G4double  x,
+			   G4double  y,
+			   G4int     n,
+			   G4double& resultReal,
+			   G4double& resultImag)
+  {
+    G4double re = 1;
+    G4double im = 0;
+    while (n > 0)
+      {
+	if (n & 1)
+	  {
+	    G4double reNew = re*x - im*y;
+	    im = re*y + im*x;
+	    re = reNew;
+	  }
+	G4double xNew = x*x - y*y;
+	y = 2*x*y;
+	x = xNew;
+	n >>= 1;
+      }
+    resultReal = re;
+    resultImag = im;
+  }
+}
+
+#endif
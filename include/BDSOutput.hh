@@ -115,8 +115,8 @@ public:
 
   /// Fill the local structure with primary vertex information. A unique interface
   /// for the case of generating primaries only. This fills the primary structure,
-  /// and calls WriteFileEventLevel() and then clears the structures. It therefore
-  /// should not be used in conjunction with FillEvent().
+  /// and calls WriteAndClearEventLevel(). It therefore should not be used in
+  /// conjunction with FillEvent().
   void FillEventPrimaryOnly(const BDSParticleCoordsFullGlobal& coords,
                             const BDSParticleDefinition*       particle);
   
@@ -210,6 +210,14 @@ private:
   /// structures are copied.
   virtual void WriteFileEventLevel() = 0;
 
+  /// Write the event level structures and clear them for the next event. By default
+  /// this is done immediately. An output may do this in another thread instead, in
+  /// which case WaitForEventLevelWrite() must block until it has finished.
+  virtual void WriteAndClearEventLevel();
+
+  /// Wait until the event level structures are free to be filled again.
+  virtual void WaitForEventLevelWrite() {;}
+
   /// Copy from local run structures to the actual file. Only run level
   /// structures are copied.
   virtual void WriteFileRunLevel() = 0;
@@ -239,6 +247,9 @@ private:
   /// Fill sampler link hits into output structures.
   void FillSamplerHitsLink(const BDSHitsCollectionSamplerLink* hits);
 
+  /// Reduce the planar sampler data once filled if compact sampler output is used.
+  void CompactSamplers();
+
   /// Fill the hit where the primary particle impact.
   void FillPrimaryHit(const std::vector<const BDSTrajectoryPointHit*>& primaryHits);
 
@@ -328,6 +339,8 @@ private:
   G4bool storeSamplerMass;
   G4bool storeSamplerRigidity;
   G4bool storeSamplerIon;
+  G4bool storeSamplerCompact;
+  G4int  samplerSignificantBits;
   G4int  storeTrajectoryStepPoints;
   G4bool storeTrajectoryStepPointLast;
   BDS::TrajectoryOptions storeTrajectoryOptions;
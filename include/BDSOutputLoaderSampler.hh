@@ -27,6 +27,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 /**
  * @brief Loader of ROOT Event output for receating events.
  *
+ * Only the branch of the requested sampler is read from the Event tree and it
+ * is read through a TTreeCache so that a whole cluster of entries is fetched
+ * in one request rather than one basket at a time.
+ *
  * @author Laurie Nevay
  */
 
@@ -42,6 +46,13 @@ public:
   
   inline G4bool DoublePrecision() const {return doublePrecision;}
   inline G4long NEventsInFile() const {return nEvents;}
+
+  /// Restart the read cache from the cluster that contains this event so skipping
+  /// to it doesn't read any of the clusters in between.
+  void SetReadStart(G4long eventNumber);
+
+  /// The first event of the cluster containing this event.
+  G4long ClusterStart(G4long eventNumber) const;
   
   BDSOutputLoaderSampler() = delete;
   BDSOutputLoaderSampler(const BDSOutputLoaderSampler&) = delete;
@@ -50,6 +61,9 @@ public:
 private:
   void Common(G4long eventNumber);
   
+  /// Size of the TTreeCache in bytes.
+  static const G4long cacheSize;
+
   G4bool doublePrecision;
   G4long nEvents;
   BDSOutputROOTEventSampler<float>*  localSamplerFloat;
@@ -25,11 +25,20 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Rtypes.h"
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 class TFile;
 class TTree;
 
 /**
  * @brief ROOT Event output class.
+ *
+ * Optionally, each event is written and compressed in a separate thread while
+ * the next event is simulated. The event structures are only filled again
+ * once the previous event has been written.
  * 
  * @author Stewart Boogert
  */
@@ -79,11 +88,25 @@ private:
   /// structures are copied.
   virtual void WriteFileRunLevel();
 
+  /// Pass the event to the writer thread if asynchronous, otherwise write it now.
+  virtual void WriteAndClearEventLevel();
+
+  /// Wait for the writer thread to finish the current event if there is one.
+  virtual void WaitForEventLevelWrite();
+
+  /// Loop run by the writer thread. Waits for an event, writes it and clears
+  /// the structures.
+  void WriterLoop();
+
+  /// Stop and join the writer thread. Non-virtual as used in the destructor.
+  void StopWriter();
+
   /// An implementation only in this class. We need a non-virtual function to
   /// call in the class destructor.
   void Close();
   
   G4int  compressionLevel;     ///< ROOT compression level for files.
+  G4bool asynchronous;         ///< Whether to write events in a separate thread.
   TFile* theRootOutputFile;    ///< Output file.
   TTree* theHeaderOutputTree;  ///< Header Tree.
   TTree* theParticleDataTree;  ///< Geant4 Data Tree.
@@ -92,6 +115,15 @@ private:
   TTree* theModelOutputTree;   ///< Model tree.
   TTree* theEventOutputTree;   ///< Event tree.
   TTree* theRunOutputTree;     ///< Output histogram tree.
+
+  /// @{ Writer thread and its state. Only one event may be waiting to be written.
+  std::thread             writer;
+  std::mutex              writerMutex;
+  std::condition_variable writerCondition;
+  G4bool                  eventPending;
+  G4bool                  stopWriting;
+  std::exception_ptr      writerException;
+  /// @}
 };
 
 #endif
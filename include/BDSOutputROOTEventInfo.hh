@@ -44,6 +44,7 @@ public:
   bool   primaryHitMachine;             ///< Whether the primary particle hit the accelerator or not.
   bool   primaryAbsorbedInCollimator;   ///< Whether the primary stopped in a collimator.
   double memoryUsageMb;                 ///< Memory usage (rusage.ru_maxrss).
+  double trajectoryPointsPeakMb;        ///< Peak memory used by trajectory points in the event.
   double energyDeposited;               ///< Total energy deposited in machine (not world or tunnel).
   double energyDepositedVacuum;         ///< Total energy deposited in vacuum volumes.
   double energyDepositedWorld;          ///< Total energy deposited in the world for this event.
@@ -67,7 +68,7 @@ public:
   /// Fill from another instance.
   void Fill(const BDSOutputROOTEventInfo* other);
   
-  ClassDef(BDSOutputROOTEventInfo, 7);
+  ClassDef(BDSOutputROOTEventInfo, 8);
 };
 
 #endif
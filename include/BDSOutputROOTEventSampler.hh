@@ -128,6 +128,14 @@ public:
   /// @{ Calculate and fill calculated variables.
   inline void FillIon() {isIon = getIsIon(); ionA = getIonA(); ionZ = getIonZ();}
   /// @}
+
+  /// Reduce the size of the stored data once compressed. Nothing is removed and the types
+  /// are unchanged, so the data is read as before. If compactDerived, the momentum, kinetic
+  /// energy and rigidity, which can be calculated from the total energy and the mass, are
+  /// rounded to 12 significant bits (as a Float16_t). If significantBits > 0, the floating
+  /// point coordinates (not T or weight) are rounded to that number of significant bits.
+  /// The remaining bits of each number are zero and compress well.
+  void Compact(bool compactDerived, int significantBits);
   
   void SetBranchAddress(TTree *);
   virtual void Flush();  ///< Clean Sampler
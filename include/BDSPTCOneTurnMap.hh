@@ -24,8 +24,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh" // Geant4 typedefs
 #include "G4Track.hh"
 
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <map>
 #include <set>
+#include <vector>
 
 class BDSParticleDefinition;
 
@@ -33,6 +36,9 @@ class BDSParticleDefinition;
  * @brief Class to load and use PTC 1 turn map.
  *
  * This class uses PTC units internally for calculating the result of the map.
+ * On loading, the terms of all five outputs are compiled into one list of unique
+ * monomials, each with a coefficient for every output. The powers of each coordinate
+ * are computed once per evaluation and every monomial is only evaluated once.
  *
  * @author Stuart Walker.
  */
@@ -49,6 +55,15 @@ public:
     G4int npy;
     G4int ndeltaP;
   };
+
+  /// A unique monomial of the map with its coefficient in each of the five outputs
+  /// (x, px, y, py, deltaP). The power indices are into the table of powers built
+  /// for each evaluation.
+  struct PTCMonomial
+  {
+    std::array<G4int, 5>    powerIndex;
+    std::array<G4double, 5> coefficient;
+  };
     
   BDSPTCOneTurnMap() = delete;                                   ///< Default constructor.
   BDSPTCOneTurnMap(const BDSPTCOneTurnMap &other) = default;     ///< Copy constructor.
@@ -79,13 +94,33 @@ public:
 		   G4double& pz,
 		   G4int turnstaken);
 
+  /// Apply the map once to coordinates (x, px, y, py, deltaP) in PTC units.
+  /// coordsIn and coordsOut may be the same.
+  void Evaluate(const G4double coordsIn[5],
+		G4double       coordsOut[5]);
+
+  /// Apply the map once to n particles in place. Coordinates are in PTC units.
+  void EvaluateBatch(std::size_t n,
+		     G4double*   x,
+		     G4double*   px,
+		     G4double*   y,
+		     G4double*   py,
+		     G4double*   deltaP);
+
+  /// @{ Accessor.
+  inline G4int MaximumOrder() const {return maximumOrder;}
+  inline std::size_t NMonomials() const {return monomials.size();}
+  /// @}
+
 private:
-  G4double Evaluate(std::vector<PTCMapTerm>& terms,
-		    G4double x,
-		    G4double px,
-            G4double y,
-		    G4double py,
-		    G4double deltaP) const;
+  /// Add a term of output index (0 to 4) to the list of monomials, merging
+  /// with an existing monomial of the same powers.
+  void AddTerm(G4int             outputIndex,
+	       const PTCMapTerm& term,
+	       std::map<std::array<G4int, 5>, std::size_t>& monomialIndex);
+
+  /// Fill the table of powers for one set of coordinates.
+  void FillPowers(const G4double coords[5]);
 
   G4double initialPrimaryMomentum;
   G4bool   beamOffsetS0;
@@ -101,11 +136,9 @@ private:
   G4double pyLastTurn;
   G4double deltaPLastTurn;
 
-  std::vector<PTCMapTerm> xTerms;
-  std::vector<PTCMapTerm> yTerms;
-  std::vector<PTCMapTerm> pxTerms;
-  std::vector<PTCMapTerm> pyTerms;
-  std::vector<PTCMapTerm> deltaPTerms;
+  G4int maximumOrder;                  ///< Highest power of any one coordinate.
+  std::vector<PTCMonomial> monomials; ///< Compiled evaluation plan.
+  std::vector<G4double> powers;       ///< Powers of each coordinate (maximumOrder+1 each).
 };
 
 #endif
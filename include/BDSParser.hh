@@ -70,7 +70,7 @@ public:
   
   /// Return the beamline. See GMAD::Parser. Our inheritance here is private, so
   /// we re-expose this function as public for use in BDSIM, without redefining it
-  /// or reimplementing it. const FastList<Element>& GMAD::Parser::GetBeamline() const;
+  /// or reimplementing it. const ExpandedSequence& GMAD::Parser::GetBeamline() const;
   using GMAD::Parser::GetBeamline;
   
   /// Import privately inherited function to access sampler filter map.
@@ -78,7 +78,7 @@ public:
   using GMAD::Parser::GetSamplerFilterIDToSet;
 
   /// Return sequence.
-  inline const GMAD::FastList<GMAD::Element>& GetSequence(const std::string& name) {return get_sequence(name);}
+  inline const GMAD::ExpandedSequence& GetSequence(const std::string& name) {return get_sequence(name);}
   
   /// Return an element definition. Returns nullptr if not found. Note the element_list is
   /// emptied after parsing.
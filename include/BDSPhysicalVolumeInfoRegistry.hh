@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <iterator>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 class G4VPhysicalVolume;
 class BDSBeamlineElement;
@@ -49,6 +50,11 @@ typedef std::map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*>::const_iterator BDS
  * volumes of a component will lead to polluting the main register with many more
  * volumes. This can be revisited and simplified if we force / require that every
  * element has a read out volume.
+ *
+ * As GetInfo is used for every energy deposition, the read out and general
+ * registers are also combined into a single hash table for lookup along with
+ * the excluded volumes, which map to a nullptr. The separate ordered registers
+ * are kept for printing.
  * 
  * @author Laurie Nevay
  */
@@ -84,7 +90,7 @@ public:
   /// Get the logical volume info for a particular logical volume (by address). Note,
   /// returns null pointer if none found. If isTunnel, gets only from tunnelRegistry.
   BDSPhysicalVolumeInfo* GetInfo(G4VPhysicalVolume* logicalVolume,
-				 G4bool             isTunnel = false);
+				 G4bool             isTunnel = false) const;
 
   /// Register a pointer to exclude from the search. If the registry is queried with
   /// one of these pointers, it immediately returns a nullptr without complaint. This
@@ -108,22 +114,16 @@ private:
   BDSPhysicalVolumeInfoRegistry();
 
   /// Check whether a physical volume is registered at all
-  G4bool IsRegistered(G4VPhysicalVolume* physicalVolume);
+  G4bool IsRegistered(G4VPhysicalVolume* physicalVolume) const;
 
   /// Check whether a physical volume is registered to the read out registry
-  G4bool IsRegisteredToReadOutRegister(G4VPhysicalVolume* physicalVolume);
+  G4bool IsRegisteredToReadOutRegister(G4VPhysicalVolume* physicalVolume) const;
 
   /// Check whether a physical volume is registered ot the general backup registry
-  G4bool IsRegisteredToBackupRegister(G4VPhysicalVolume* physicalVolume);
+  G4bool IsRegisteredToBackupRegister(G4VPhysicalVolume* physicalVolume) const;
 
   // Check whether a physical volume is registered ot the tunnel registry
-  G4bool IsRegisteredToTunnelRegister(G4VPhysicalVolume* physicalVolume);
-
-  /// @{ Search iterator
-  BDSPVInfoIterator readOutSearch;
-  BDSPVInfoIterator backupSearch;
-  BDSPVInfoIterator tunnelSearch;
-  /// @}
+  G4bool IsRegisteredToTunnelRegister(G4VPhysicalVolume* physicalVolume) const;
   
   /// The singleton instance
   static BDSPhysicalVolumeInfoRegistry* instance;
@@ -133,6 +133,11 @@ private:
   std::map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*> backupRegister;
   std::map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*> tunnelRegister;
   std::set<G4VPhysicalVolume*> excludedVolumes;
+
+  /// Combined read out and backup registers for lookup. Excluded volumes are
+  /// stored with a nullptr so they're found in the same single search.
+  std::unordered_map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*> lookup;
+  std::unordered_map<G4VPhysicalVolume*, BDSPhysicalVolumeInfo*> tunnelLookup;
   
   std::set<BDSPhysicalVolumeInfo*> pvInfosForDeletion;
 
@@ -26,6 +26,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 class BDSBunchEventGenerator;
@@ -37,6 +41,14 @@ class G4VSolid;
 
 /**
  * @brief Loader to read a specific sampler from a BDSIM ROOT output file.
+ *
+ * Optionally, the next events in the file are read and decompressed in a separate
+ * thread into a ring buffer of prefetchDepth events while the current one is simulated.
+ * The particles are converted to Geant4 primaries and filtered when they are used, so
+ * the events generated are identical with or without prefetching.
+ *
+ * The result of the filters for each event in the file is cached, so when the file is
+ * looped any event where no particles passed is not read again.
  * 
  * @author Laurie Nevay
  */
@@ -49,13 +61,16 @@ public:
   /// Constructor takes full distrType string including semicolon and
   /// eventgeneratorfile prefix. The filename is assumed to be correctly
   /// prefixed if a relative path already. The bunch definition is used
-  /// for the reference coordinates and offset of the beam point.
+  /// for the reference coordinates and offset of the beam point. If
+  /// prefetchDepthIn is greater than 0, that many events are read ahead
+  /// in a separate thread.
   BDSPrimaryGeneratorFileSampler(const G4String& distrType,
                                  const G4String& fileNameIn,
                                  BDSBunchEventGenerator* bunchIn,
                                  G4bool loopFileIn,
                                  G4bool removeUnstableWithoutDecayIn = true,
-                                 G4bool warnAboutSkippedParticlesIn  = true);
+                                 G4bool warnAboutSkippedParticlesIn  = true,
+                                 G4int  prefetchDepthIn              = 0);
   virtual ~BDSPrimaryGeneratorFileSampler();
 
   /// Read the next non-empty sampler entry from the file.
@@ -71,6 +86,16 @@ public:
     G4PrimaryParticle* vertex;
   };
 
+  /// Plain copy of one sampler hit so it can be loaded without any Geant4 objects.
+  struct SamplerParticle
+  {
+    G4int         pdgID;
+    G4ThreeVector momentum;
+    G4ThreeVector xyz;
+    G4double      T;
+    G4double      weight;
+  };
+
   /// Just advance to a different event index. Have a function to put the
   /// implementation in one place and be similar to BDSPrimaryGeneratorFileHEPMC.
   void SkipEvents(G4long nEventsToSkip);
@@ -82,10 +107,39 @@ protected:
   /// Conversion from HepMC::GenEvent to G4Event.
   //void HepMC2G4(const HepMC3::GenEvent* hepmcevt, G4Event* g4event);
   
-  void ReadPrimaryParticlesFloat(G4long index);
-  void ReadPrimaryParticlesDouble(G4long index);
+  /// @{ Copy the sampler hits of an event into particles.
+  void ReadPrimaryParticlesFloat(G4long index, std::vector<SamplerParticle>& particles);
+  void ReadPrimaryParticlesDouble(G4long index, std::vector<SamplerParticle>& particles);
+  /// @}
+
+  /// Read the sampler hits of an event in the precision of the file. The read cache
+  /// is restarted if this isn't the event after the last one read.
+  void ReadParticles(G4long index, std::vector<SamplerParticle>& particles);
 
 private:
+  /// One event in the prefetch ring buffer.
+  struct PrefetchedEvent
+  {
+    G4long index = 0;
+    G4bool read  = false; ///< False if not read as none of the particles pass the filters.
+    std::vector<SamplerParticle> particles;
+  };
+
+  /// Get the particles of event index from the prefetch thread. If the thread is reading
+  /// a different part of the file (e.g. after skipping) it is restarted from index.
+  G4bool TakePrefetchedEvent(G4long index, std::vector<SamplerParticle>& particles);
+
+  /// Loop run by the prefetch thread.
+  void PrefetchLoop();
+
+  /// Stop and join the prefetch thread. Non-virtual as used in the destructor.
+  void StopPrefetch();
+
+  /// @{ Values of filterCache other than the number of particles rejected.
+  static const G4int filterUnknown;
+  static const G4int filterPassed;
+  /// @}
+
   BDSOutputLoaderSampler*   reader;
   G4String                  fileName;
   G4String                  samplerName;
@@ -95,8 +149,31 @@ private:
   
   /// Used for transiently loading information.
   std::vector<DisplacedVertex> vertices;
+  std::vector<SamplerParticle> particlesLoaded;
   
   std::vector<G4PrimaryVertex*> currentVertices;
+
+  G4long                    lastIndexRead;
+
+  /// Result of the filters for each event in the file. filterUnknown if not read yet,
+  /// filterPassed if any particle passed, else the number of particles rejected. Guarded
+  /// by prefetchMutex when prefetching.
+  std::vector<G4int> filterCache;
+
+  /// @{ Prefetch thread and its state. Guarded by prefetchMutex.
+  G4int                        prefetchDepth;
+  std::thread                  prefetcher;
+  std::mutex                   prefetchMutex;
+  std::condition_variable      prefetchCondition;
+  std::vector<PrefetchedEvent> ring;
+  std::size_t                  ringHead;
+  std::size_t                  ringCount;
+  G4long                       nextPrefetchIndex;
+  G4long                       prefetchGeneration; ///< Incremented on restart to discard an event being read.
+  G4bool                       prefetchAtEnd;      ///< Whether the end of a non-looped file has been read.
+  G4bool                       stopPrefetching;
+  std::exception_ptr           prefetchException;
+  /// @}
 };
 
 #endif
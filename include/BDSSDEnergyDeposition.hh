@@ -68,6 +68,16 @@ public:
 
   /// Provide access to last hit.
   virtual G4VHit* last() const;
+
+  /// @{ Number of times the volume info lookup for a hit fell back to locating the pre-step
+  /// point, then to a point shifted along the step, or failed entirely, for this thread.
+  static G4long FallbackPreStepPoint() {return nFallbackPreStepPoint;}
+  static G4long FallbackShiftedPoint() {return nFallbackShiftedPoint;}
+  static G4long FallbackFailed()       {return nFallbackFailed;}
+  /// @}
+
+  /// Print the number of hits and how many required each fallback for this thread.
+  static void PrintFallbackStatistics();
   
 private:
   G4bool   storeExtras;     ///< Whether to store extra information.
@@ -78,6 +88,13 @@ private:
 
   /// Navigator for checking points in read out geometry
   BDSAuxiliaryNavigator* auxNavigator;
+
+  /// @{ Counters for the volume info lookup. Shared by all instances in a thread.
+  static G4ThreadLocal G4long nLookups;
+  static G4ThreadLocal G4long nFallbackPreStepPoint;
+  static G4ThreadLocal G4long nFallbackShiftedPoint;
+  static G4ThreadLocal G4long nFallbackFailed;
+  /// @}
 };
 
 #endif
@@ -35,7 +35,9 @@ class BDSSDCollimator;
 class BDSSDEnergyDeposition;
 class BDSSDEnergyDepositionGlobal;
 class BDSLinkRegistry;
+class BDSLinkRunAction;
 class BDSMultiSensitiveDetectorOrdered;
+class BDSScoringMeshVirtual;
 class BDSSDFilterPDGIDSet;
 class BDSSDSampler;
 class BDSSDSamplerCylinder;
@@ -163,8 +165,16 @@ public:
   /// Access the map of units for primitive scorers.
   inline const std::map<G4String, G4double>& PrimitiveScorerUnits() const {return primitiveScorerNameToUnit;}
 
+  /// Keep a record of a scoring mesh that must be filled from the stepping action.
+  /// Not owned by this class (owned by G4SDManager).
+  inline void RegisterVirtualScoringMesh(BDSScoringMeshVirtual* mesh) {virtualScoringMeshes.push_back(mesh);}
+
+  /// Access the scoring meshes to fill from the stepping action.
+  inline const std::vector<BDSScoringMeshVirtual*>& VirtualScoringMeshes() const {return virtualScoringMeshes;}
+
   /// If samplerLink member exists, set the registry to look up links for that SD.
   void SetLinkRegistry(BDSLinkRegistry* registry);
+  inline void SetLinkRunAction(BDSLinkRunAction* runActionIn) {samplerLink->SetLinkRunAction(runActionIn);}
   inline void SetLinkMinimumEK(G4double minimumEKIn) {samplerLink->SetMinimumEK(minimumEKIn);}
   inline void SetLinkProtonsAndIonsOnly(G4bool protonsAndIonsOnlyIn) {samplerLink->SetProtonsAndIonsOnly(protonsAndIonsOnlyIn);}
   
@@ -232,6 +242,9 @@ private:
 
   /// Map of primitive scorer names to units.
   std::map<G4String, G4double> primitiveScorerNameToUnit;
+
+  /// Scoring meshes without geometry.
+  std::vector<BDSScoringMeshVirtual*> virtualScoringMeshes;
   
   std::map<G4int, BDSSDSampler*> extraSamplersWithFilters;
   std::map<G4int, BDSSDSamplerCylinder*> extraSamplerCylindersWithFilters;
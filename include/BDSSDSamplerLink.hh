@@ -25,6 +25,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Types.hh"
 
 class BDSLinkRegistry;
+class BDSLinkRunAction;
 
 class G4Step;
 class G4HCofThisEvent;
@@ -34,7 +35,8 @@ class G4TouchableHistory;
  * @brief The sensitive detector class that provides sensitivity to BDSSamplerLink instances.
  *
  * It creates BDSHitSamplerLink instances for each particle impact on a sampler this SD is
- * attached to.
+ * attached to. When the run action is writing to a batch output, the particle is
+ * written there directly instead and no hit is made.
  * 
  * @author Laurie Nevay
  */
@@ -60,6 +62,9 @@ public:
   /// Update cached pointer of link registry.
   inline void SetLinkRegistry(BDSLinkRegistry* registryIn) {registry = registryIn;}
 
+  /// Update cached pointer of the run action that may write to a batch output.
+  inline void SetLinkRunAction(BDSLinkRunAction* linkRunActionIn) {linkRunAction = linkRunActionIn;}
+
   inline void SetMinimumEK(G4double minimumEKIn) {minimumEK = minimumEKIn;}
   inline void SetProtonsAndIonsOnly(G4bool protonsAndIonsOnlyIn) {protonsAndIonsOnly = protonsAndIonsOnlyIn;}
 
@@ -78,6 +83,9 @@ private:
   /// Cached pointer to registry as accessed many times
   BDSLinkRegistry* registry;
 
+  /// Cached pointer to the run action for batch output. Doesn't own.
+  BDSLinkRunAction* linkRunAction;
+
   /// Minimum kinetic energy to generate a hit for.
   G4double minimumEK;
 
@@ -0,0 +1,110 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSSCORINGMESHVIRTUAL_H
+#define BDSSCORINGMESHVIRTUAL_H
+
+#include "BDSScorerType.hh"
+
+#include "G4String.hh"
+#include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
+#include "G4Types.hh"
+#include "G4VSensitiveDetector.hh"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+class BDSHistBinMapper;
+class BDSScorerMeshInfo;
+class G4HCofThisEvent;
+class G4Step;
+class G4TouchableHistory;
+class G4VPrimitiveScorer;
+template <typename T> class G4THitsMap;
+
+/**
+ * @brief Box scoring mesh without any geometry.
+ *
+ * Each step of every track in the mass world is transformed into the mesh
+ * coordinates and the straight line between the pre and post step points is
+ * traversed voxel by voxel (3D DDA). The quantities are split between the
+ * voxels in proportion to the length of the step in each. This avoids the
+ * parallel world navigation of a replicated mesh, which dominates for fine meshes.
+ *
+ * This is a sensitive detector only so that the hits maps are created and stored
+ * in the event the same way as those of a G4ScoringBox. It is not attached to
+ * any volume and is filled through ScoreStep() from the stepping action.
+ * The voxel index is the same as BDSScoringMeshBox through BDSHistBinMapper.
+ *
+ * @author BDSIM Developers
+ */
+
+class BDSScoringMeshVirtual: public G4VSensitiveDetector
+{
+public:
+  BDSScoringMeshVirtual(const G4String&          name,
+                        const BDSScorerMeshInfo& recipe,
+                        const G4Transform3D&     placementTransform);
+  virtual ~BDSScoringMeshVirtual();
+
+  /// Add a quantity to score. The primitive scorer provides the name, unit and
+  /// filter and is owned by this class. Must be used before this detector is
+  /// registered with G4SDManager. Throws if the type can't be binned analytically.
+  void AddScorer(G4VPrimitiveScorer* scorer, const BDSScorerType& scorerType);
+
+  inline const BDSHistBinMapper* Mapper() const {return mapper;}
+
+  /// Create the hits maps for this event.
+  virtual void Initialize(G4HCofThisEvent* HCE);
+
+  /// Not used as not attached to any volume.
+  virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*) {return false;}
+
+  /// Bin the step into the mesh. Does nothing if it doesn't overlap the mesh.
+  void ScoreStep(const G4Step* step);
+
+private:
+  BDSScoringMeshVirtual() = delete;
+
+  /// One scored quantity.
+  struct Quantity
+  {
+    G4VPrimitiveScorer*   scorer;
+    BDSScorerType         type;
+    G4THitsMap<G4double>* hits;
+    std::set<std::pair<G4int, G4int> > cellAndTrackIDs; ///< For population only.
+  };
+
+  /// Call visit(i, j, k, fraction) for each voxel crossed by the line from a to b,
+  /// both in the frame of the mesh with the origin at the low corner. The fraction
+  /// is the fraction of the whole line inside that voxel.
+  template <typename F>
+  void Traverse(const G4ThreeVector& a, const G4ThreeVector& b, F&& visit) const;
+
+  G4Transform3D globalToLocal;
+  G4ThreeVector halfSize;
+  G4int         nBins[3];
+  G4double      binWidth[3];
+  G4double      voxelVolume;
+  BDSHistBinMapper* mapper;
+  std::vector<Quantity> quantities;
+};
+
+#endif
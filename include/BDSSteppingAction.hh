@@ -22,8 +22,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4UserSteppingAction.hh"
 #include "G4Types.hh"
 
+#include <vector>
+
+class BDSScoringMeshVirtual;
+
 /**
  * @brief Provide extra output for Geant4 through a verbose stepping action.
+ *
+ * Also fills any scoring meshes that have no geometry with every step.
  */
 
 class BDSSteppingAction: public G4UserSteppingAction
@@ -32,11 +38,12 @@ public:
   BDSSteppingAction();
   BDSSteppingAction(G4bool verboseStepIn,
 		    G4int  verboseEventStartIn,
-		    G4int  verboseEventStopIn);
+		    G4int  verboseEventStopIn,
+		    const std::vector<BDSScoringMeshVirtual*>* virtualMeshesIn = nullptr);
   virtual ~BDSSteppingAction();
 
-  /// If this event is verbose, then print out verbose stepping information
-  /// for this step.
+  /// Score the step in any virtual meshes. If this event is verbose, then print
+  /// out verbose stepping information for this step.
   virtual void UserSteppingAction(const G4Step* step);
 
 private:
@@ -46,6 +53,9 @@ private:
   const G4bool verboseStep;
   const G4bool verboseEventStart;
   const G4bool verboseEventStop;
+
+  /// Meshes to fill. Not owned. The vector may be filled after construction.
+  const std::vector<BDSScoringMeshVirtual*>* virtualMeshes;
 };
 
 #endif
@@ -21,6 +21,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSTrajectoryPointIon.hh"
 #include "BDSTrajectoryPointLocal.hh"
 #include "BDSTrajectoryPointLink.hh"
+#include "BDSTrajectoryPointMemory.hh"
 
 #include "globals.hh" // geant4 types / globals
 #include "G4Allocator.hh"
@@ -207,11 +208,13 @@ inline void* BDSTrajectoryPoint::operator new(size_t)
 {
   void *aTrajectoryPoint;
   aTrajectoryPoint = (void *) bdsTrajectoryPointAllocator.MallocSingle();
+  BDS::AddTrajectoryPointBytes(sizeof(BDSTrajectoryPoint));
   return aTrajectoryPoint;
 }
 
 inline void BDSTrajectoryPoint::operator delete(void *aTrajectoryPoint)
 {
+  BDS::RemoveTrajectoryPointBytes(sizeof(BDSTrajectoryPoint));
   bdsTrajectoryPointAllocator.FreeSingle((BDSTrajectoryPoint *) aTrajectoryPoint);
 }
 
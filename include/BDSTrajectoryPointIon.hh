@@ -18,6 +18,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSTRAJECTORYPOINTION_H
 #define BDSTRAJECTORYPOINTION_H
+#include "BDSTrajectoryPointMemory.hh"
+
 #include "globals.hh"
 #include "G4Allocator.hh"
 
@@ -59,12 +61,14 @@ inline void* BDSTrajectoryPointIon::operator new(size_t)
 {
   void* aHit;
   aHit=(void*) BDSAllocatorTrajectoryPointIon.MallocSingle();
+  BDS::AddTrajectoryPointBytes(sizeof(BDSTrajectoryPointIon));
   return aHit;
 }
 
 inline void BDSTrajectoryPointIon::operator delete(void *aHit)
 {
- BDSAllocatorTrajectoryPointIon.FreeSingle((BDSTrajectoryPointIon*) aHit);
+  BDS::RemoveTrajectoryPointBytes(sizeof(BDSTrajectoryPointIon));
+  BDSAllocatorTrajectoryPointIon.FreeSingle((BDSTrajectoryPointIon*) aHit);
 }
 
 #endif
@@ -18,6 +18,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSTRAJECTORYPOINTLINK_H
 #define BDSTRAJECTORYPOINTLINK_H
+#include "BDSTrajectoryPointMemory.hh"
+
 #include "globals.hh"
 #include "G4Allocator.hh"
 
@@ -59,11 +61,13 @@ inline void* BDSTrajectoryPointLink::operator new(size_t)
 {
   void* aHit;
   aHit=(void*) BDSAllocatorTrajectoryPointLink.MallocSingle();
+  BDS::AddTrajectoryPointBytes(sizeof(BDSTrajectoryPointLink));
   return aHit;
 }
 
 inline void BDSTrajectoryPointLink::operator delete(void *aHit)
 {
+  BDS::RemoveTrajectoryPointBytes(sizeof(BDSTrajectoryPointLink));
   BDSAllocatorTrajectoryPointLink.FreeSingle((BDSTrajectoryPointLink*) aHit);
 }
 
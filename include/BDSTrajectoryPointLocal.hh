@@ -18,6 +18,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSTRAJECTORYPOINTLOCAL_H
 #define BDSTRAJECTORYPOINTLOCAL_H
+#include "BDSTrajectoryPointMemory.hh"
+
 #include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
 
@@ -55,11 +57,13 @@ inline void* BDSTrajectoryPointLocal::operator new(size_t)
 {
   void* aHit;
   aHit=(void*) BDSAllocatorTrajectoryPointLocal.MallocSingle();
+  BDS::AddTrajectoryPointBytes(sizeof(BDSTrajectoryPointLocal));
   return aHit;
 }
 
 inline void BDSTrajectoryPointLocal::operator delete(void *aHit)
 {
+  BDS::RemoveTrajectoryPointBytes(sizeof(BDSTrajectoryPointLocal));
   BDSAllocatorTrajectoryPointLocal.FreeSingle((BDSTrajectoryPointLocal*) aHit);
 }
 
@@ -0,0 +1,49 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSTRAJECTORYPOINTMEMORY_H
+#define BDSTRAJECTORYPOINTMEMORY_H
+
+#include "globals.hh" // geant4 types / globals
+
+#include <cstddef>
+
+namespace BDS
+{
+  /// @{ Number of bytes of trajectory points and their extra information currently
+  /// allocated from their pools, and the peak since the last reset, for this thread.
+  extern G4ThreadLocal std::size_t trajectoryPointBytes;
+  extern G4ThreadLocal std::size_t trajectoryPointBytesPeak;
+  /// @}
+
+  /// Account for a trajectory point or extra information being allocated.
+  inline void AddTrajectoryPointBytes(std::size_t nBytes)
+  {
+    trajectoryPointBytes += nBytes;
+    if (trajectoryPointBytes > trajectoryPointBytesPeak)
+      {trajectoryPointBytesPeak = trajectoryPointBytes;}
+  }
+
+  /// Account for a trajectory point or extra information being freed.
+  inline void RemoveTrajectoryPointBytes(std::size_t nBytes) {trajectoryPointBytes -= nBytes;}
+
+  /// Reset the peak to the current usage, e.g. at the start of an event.
+  inline void ResetTrajectoryPointBytesPeak() {trajectoryPointBytesPeak = trajectoryPointBytes;}
+}
+
+#endif
@@ -0,0 +1,129 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray4DCoords.hh"
+#include "BDSException.hh"
+#include "BDSFieldLoaderBDSIM.hh"
+#include "BDSFieldLoaderBDSIMBinary.hh"
+
+#include "globals.hh"      // geant4 types / globals
+#include "G4String.hh"
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifdef USE_GZSTREAM
+#include "src-external/gzstream/gzstream.h"
+#endif
+
+namespace
+{
+  void Usage()
+  {
+    G4cout << "usage: bdsimfieldconvert <input field file> <output file> <number of dimensions> [--double]" << G4endl;
+    G4cout << " input field file       : BDSIM format field map (optionally gzipped)" << G4endl;
+    G4cout << " output file            : file name for the binary BDSIM field map" << G4endl;
+    G4cout << " number of dimensions   : 1, 2, 3 or 4 as per the bdsimNd field format" << G4endl;
+    G4cout << " --double (optional)    : store values in double rather than float precision" << G4endl;
+  }
+
+  template <class T>
+  BDSArray4DCoords* LoadArray(const G4String& fileName, G4int nDim)
+  {
+    BDSFieldLoaderBDSIM<T> loader;
+    BDSArray4DCoords* result = nullptr;
+    switch (nDim)
+      {
+      case 1:
+        {result = loader.Load1D(fileName); break;}
+      case 2:
+        {result = loader.Load2D(fileName); break;}
+      case 3:
+        {result = loader.Load3D(fileName); break;}
+      case 4:
+        {result = loader.Load4D(fileName); break;}
+      default:
+        {throw BDSException("bdsimfieldconvert", "invalid number of dimensions " + std::to_string(nDim));}
+      }
+    return result;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  /// Print header & program information
+  G4cout<<"bdsimfieldconvert : version @BDSIM_VERSION@"<<G4endl;
+  G4cout<<"                    (C) 2001-@CURRENT_YEAR@ Royal Holloway University London"<<G4endl;
+  G4cout<<"                    http://www.pp.rhul.ac.uk/bdsim"<<G4endl;
+  G4cout<<G4endl;
+
+  if (argc < 4 || argc > 5)
+    {
+      Usage();
+      return 1;
+    }
+
+  G4String inputFileName  = G4String(argv[1]);
+  G4String outputFileName = G4String(argv[2]);
+  G4bool doublePrecision  = false;
+  if (argc == 5)
+    {
+      if (std::string(argv[4]) == "--double")
+        {doublePrecision = true;}
+      else
+        {
+          Usage();
+          return 1;
+        }
+    }
+
+  try
+    {
+      G4int nDim = std::stoi(argv[3]);
+      BDSArray4DCoords* array = nullptr;
+      if (inputFileName.rfind("gz") != std::string::npos)
+        {
+#ifdef USE_GZSTREAM
+          array = LoadArray<igzstream>(inputFileName, nDim);
+#else
+          throw BDSException("bdsimfieldconvert", "Compressed file loading - but BDSIM not compiled with ZLIB.");
+#endif
+        }
+      else
+        {array = LoadArray<std::ifstream>(inputFileName, nDim);}
+
+      BDSFieldLoaderBDSIMBinary::Write(array, nDim, outputFileName, doublePrecision);
+      G4cout << "Written \"" << outputFileName << "\"" << G4endl;
+      delete array;
+    }
+  catch (BDSException& e)
+    {
+      G4cout << e.what() << G4endl;
+      return 1;
+    }
+  catch (std::exception& e)
+    {
+      G4cout << e.what() << G4endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,168 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBunchUserFileBinary.hh"
+#include "BDSException.hh"
+
+#include "globals.hh"      // geant4 types / globals
+#include "G4String.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef USE_GZSTREAM
+#include "src-external/gzstream/gzstream.h"
+#endif
+
+namespace
+{
+  void Usage()
+  {
+    G4cout << "usage: bdsimuserfileconvert <input file> <output file> <distrFileFormat> [nlinesIgnore]" << G4endl;
+    G4cout << " input file             : text user bunch file (optionally gzipped)" << G4endl;
+    G4cout << " output file            : file name for the binary user bunch file" << G4endl;
+    G4cout << " distrFileFormat        : column format as used in the beam command, e.g. \"x[mm]:xp[mrad]:E[GeV]\"" << G4endl;
+    G4cout << " nlinesIgnore (optional): number of lines to ignore at the start of the input file" << G4endl;
+  }
+
+  /// Number of columns in a distrFileFormat string, i.e. the number of ':' separated tokens.
+  G4int NColumns(const G4String& format)
+  {
+    G4int result = 0;
+    std::string::size_type start = 0;
+    while (start <= format.size())
+      {
+        std::string::size_type end = format.find(':', start);
+        if (end == std::string::npos)
+          {end = format.size();}
+        if (end == start)
+          {throw BDSException("bdsimuserfileconvert", "empty column in format \"" + format + "\"");}
+        result++;
+        start = end + 1;
+      }
+    return result;
+  }
+
+  /// Read all valid lines of the text file and write them as records. Empty lines and
+  /// comments are removed with the same rules as BDSBunchUserFile.
+  template <class T>
+  G4long Convert(const G4String& inputFileName,
+                 const G4String& outputFileName,
+                 const G4String& format,
+                 G4long          nlinesIgnore)
+  {
+    T inputFile;
+    inputFile.open(inputFileName);
+    if (!inputFile.good())
+      {throw BDSException("bdsimuserfileconvert", "Cannot open input file \"" + inputFileName + "\"");}
+
+    G4int nColumns = NColumns(format);
+    BDSBunchUserFileBinary output;
+    output.OpenForWriting(outputFileName, format, nColumns);
+
+    std::regex comment("^\\s*\\#|\\!.*");
+    std::vector<G4double> values((std::size_t)nColumns);
+    std::string line;
+    G4long lineCounter = 0;
+    while (std::getline(inputFile, line))
+      {
+        lineCounter++;
+        if (lineCounter <= nlinesIgnore)
+          {continue;}
+        if (std::all_of(line.begin(), line.end(), isspace) || std::regex_search(line, comment))
+          {continue;}
+
+        const char* position = line.c_str();
+        for (G4int i = 0; i < nColumns; i++)
+          {
+            char* next = nullptr;
+            values[(std::size_t)i] = std::strtod(position, &next);
+            if (next == position)
+              {
+                std::string message = "Invalid line at line " + std::to_string(lineCounter) +
+                  ".  Expected " + std::to_string(nColumns) + " numerical columns.";
+                throw BDSException("bdsimuserfileconvert", message);
+              }
+            position = next;
+          }
+        output.WriteRecord(values);
+      }
+    if (lineCounter < nlinesIgnore)
+      {throw BDSException("bdsimuserfileconvert", "end of file reached before nlinesIgnore was reached");}
+    G4long nRecords = output.NRecords();
+    output.Close();
+    return nRecords;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  /// Print header & program information
+  G4cout<<"bdsimuserfileconvert : version @BDSIM_VERSION@"<<G4endl;
+  G4cout<<"                       (C) 2001-@CURRENT_YEAR@ Royal Holloway University London"<<G4endl;
+  G4cout<<"                       http://www.pp.rhul.ac.uk/bdsim"<<G4endl;
+  G4cout<<G4endl;
+
+  if (argc < 4 || argc > 5)
+    {
+      Usage();
+      return 1;
+    }
+
+  G4String inputFileName  = G4String(argv[1]);
+  G4String outputFileName = G4String(argv[2]);
+  G4String format         = G4String(argv[3]);
+
+  try
+    {
+      G4long nlinesIgnore = argc == 5 ? std::stol(argv[4]) : 0;
+      G4long nRecords = 0;
+      if (inputFileName.rfind("gz") != std::string::npos)
+        {
+#ifdef USE_GZSTREAM
+          nRecords = Convert<igzstream>(inputFileName, outputFileName, format, nlinesIgnore);
+#else
+          throw BDSException("bdsimuserfileconvert", "Compressed file loading - but BDSIM not compiled with ZLIB.");
+#endif
+        }
+      else
+        {nRecords = Convert<std::ifstream>(inputFileName, outputFileName, format, nlinesIgnore);}
+
+      G4cout << "Written " << nRecords << " particles to \"" << outputFileName << "\"" << G4endl;
+    }
+  catch (BDSException& e)
+    {
+      G4cout << e.what() << G4endl;
+      return 1;
+    }
+  catch (std::exception& e)
+    {
+      G4cout << e.what() << G4endl;
+      return 1;
+    }
+
+  return 0;
+}
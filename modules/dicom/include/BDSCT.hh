@@ -29,6 +29,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <vector>
 
 class BDSDicomFileMgr;
+class BDSDicomPhantomParameterisationColour;
 class G4Box;
 class G4LogicalVolume;
 class G4Material;
@@ -56,7 +57,9 @@ public:
   BDSCT() = delete; ///< No default constructor.
   BDSCT(const G4String& nameIn,
         const G4String& dicomDataPath,
-        const G4String& dicomDataFile);
+        const G4String& dicomDataFile,
+        const G4String& voxelMergingIn = "none",
+        G4bool          skipEqualMaterialsIn = false);
 
   virtual ~BDSCT();
 
@@ -96,6 +99,14 @@ private:
   /// Construct the phantom volumes. This method should be implemented for each of the derived classes.
   void BuildPhantom();
 
+  /// Place the voxels as merged boxes of the same material instead of a regular
+  /// phantom. Navigation uses the normal smart voxels.
+  void BuildMergedPhantom(G4LogicalVolume* voxelLogic);
+
+  /// Print the number of voxels and the memory of the voxel description.
+  void PrintVoxelReport(G4int nVoxelsAfter,
+                        size_t memoryAfter) const;
+
   void SetScorer(G4LogicalVolume* voxel_logic);
 
   G4Material* fAir;
@@ -131,6 +142,10 @@ private:
   BDSDicomFileMgr* theFileMgr;
   G4String dicomDataPath;
   G4String dicomDataFile;
+  G4String voxelMerging;       ///< "none" or "runlength".
+  G4bool   skipEqualMaterials; ///< For regular navigation, step over voxels of the same material.
+  /// Owned colour parameterisation whose colour map the merged voxel parameterisation uses.
+  BDSDicomPhantomParameterisationColour* colourParameterisation;
 };
 
 #endif
@@ -0,0 +1,103 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSDICOMMERGEDPARAMETERISATION_H
+#define BDSDICOMMERGEDPARAMETERISATION_H
+
+#include "G4String.hh"
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+#include "G4VPVParameterisation.hh"
+
+#include <array>
+#include <map>
+#include <vector>
+
+class G4Box;
+class G4Material;
+class G4VisAttributes;
+class G4VPhysicalVolume;
+class G4VTouchable;
+
+/**
+ * @brief A box of adjacent DICOM voxels that all have the same material.
+ *
+ * Indices and sizes are in units of the original voxels.
+ */
+
+struct BDSDicomVoxelBlock
+{
+  std::array<G4int, 3> start; ///< Index of the first voxel in x, y and z.
+  std::array<G4int, 3> size;  ///< Number of voxels in x, y and z.
+  G4int materialIndex;        ///< Index in the vector of phantom materials.
+};
+
+/**
+ * @brief Parameterisation of a DICOM phantom where identical neighbouring voxels
+ * have been merged into larger boxes.
+ *
+ * Each copy number is one block and the boxes are of different sizes, so this is
+ * navigated with the normal smart voxel navigation rather than regular navigation.
+ *
+ * @author BDSIM Developers
+ */
+
+class BDSDicomMergedParameterisation: public G4VPVParameterisation
+{
+public:
+  typedef std::map<G4String, G4VisAttributes*> ColourMap_t;
+  
+  BDSDicomMergedParameterisation(const std::vector<BDSDicomVoxelBlock>& blocksIn,
+				 const std::vector<G4Material*>& materialsIn,
+				 const G4ThreeVector& voxelHalfSizeIn,
+				 const std::array<G4int, 3>& nVoxelsIn,
+				 const ColourMap_t* coloursIn = nullptr);
+  virtual ~BDSDicomMergedParameterisation(){;}
+
+  /// Merge neighbouring voxels with the same material index into boxes. Voxels are first
+  /// merged into runs along x, then identical runs in consecutive rows in y and finally
+  /// identical rectangles in consecutive slices in z. The copy number of a voxel in the
+  /// material index array is ix + iy*nx + iz*nx*ny.
+  static std::vector<BDSDicomVoxelBlock> MergeVoxels(const size_t* materialIndices,
+						     const std::array<G4int, 3>& nVoxels);
+
+  virtual void ComputeTransformation(const G4int copyNo,
+				     G4VPhysicalVolume* physVol) const override;
+
+  virtual void ComputeDimensions(G4Box& box,
+				 const G4int copyNo,
+				 const G4VPhysicalVolume* physVol) const override;
+
+  virtual G4Material* ComputeMaterial(const G4int copyNo,
+				      G4VPhysicalVolume* currentVol,
+				      const G4VTouchable* parentTouch = nullptr) override;
+
+  inline G4int NumberOfBlocks() const {return (G4int)blocks.size();}
+
+private:
+  /// Find the colour for a material by its name (without any density suffix).
+  G4VisAttributes* Colour(const G4Material* material) const;
+  
+  std::vector<BDSDicomVoxelBlock> blocks;
+  std::vector<G4Material*> materials;
+  G4ThreeVector voxelHalfSize;
+  std::array<G4int, 3> nVoxels;
+  const ColourMap_t* colours;
+};
+
+#endif
@@ -21,6 +21,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSCT.hh"
 #include "BDSDicomFileMgr.hh"
 #include "BDSDicomIntersectVolume.hh"
+#include "BDSDicomMergedParameterisation.hh"
 #include "BDSDicomPhantomParameterisationColour.hh"
 #include "BDSExtent.hh"
 
@@ -40,12 +41,20 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <array>
+#include <vector>
+
 BDSCT::BDSCT(const G4String& nameIn,
              const G4String& dataFilePath,
-             const G4String& dataFileName):
+             const G4String& dataFileName,
+             const G4String& voxelMergingIn,
+             G4bool          skipEqualMaterialsIn):
   BDSAcceleratorComponent(nameIn, 1, 0, "ct"),
   dicomDataPath(dataFilePath),
-  dicomDataFile(dataFileName)
+  dicomDataFile(dataFileName),
+  voxelMerging(voxelMergingIn),
+  skipEqualMaterials(skipEqualMaterialsIn),
+  colourParameterisation(nullptr)
 {
   //--- As soon as the object is constructed, we retrieve data from the CT files
   theFileMgr = BDSDicomFileMgr::GetInstance();
@@ -54,7 +63,9 @@ BDSCT::BDSCT(const G4String& nameIn,
 }
 
 BDSCT::~BDSCT()
-{;}
+{
+  delete colourParameterisation;
+}
 
 void BDSCT::Build()
 {
@@ -95,6 +106,16 @@ void BDSCT::Build()
 
 void BDSCT::BuildPhantom()
 {
+  if (voxelMerging == "runlength")
+    {
+      G4Box* voxel_solid = new G4Box("Voxel", fVoxelHalfDimX, fVoxelHalfDimY, fVoxelHalfDimZ);
+      G4LogicalVolume* voxel_logic = new G4LogicalVolume(voxel_solid, fMaterials[0], "VoxelLogical", 0, 0, 0);
+      voxel_logic->SetVisAttributes(new G4VisAttributes(G4VisAttributes::GetInvisible()));
+      BuildMergedPhantom(voxel_logic);
+      SetScorer(voxel_logic);
+      return;
+    }
+  
   //----- Create parameterisation
   BDSDicomPhantomParameterisationColour* param = new BDSDicomPhantomParameterisationColour(dicomDataPath + "ColourMap.dat");
   
@@ -115,6 +136,10 @@ void BDSCT::BuildPhantom()
   // correspond to the index of its material in the vector of materials
   // defined above
   param->SetMaterialIndices(fMateIDs);
+
+  //----- Allow G4RegularNavigation to step straight through neighbouring voxels
+  // of the same material rather than stopping at every voxel boundary
+  param->SetSkipEqualMaterials(skipEqualMaterials);
   
   //----- Define voxel logical volume
   G4Box *voxel_solid = new G4Box("Voxel", fVoxelHalfDimX, fVoxelHalfDimY, fVoxelHalfDimZ);
@@ -149,10 +174,57 @@ void BDSCT::BuildPhantom()
   // so that G4RegularNavigation is used
   phantom_phys->SetRegularStructureId(1); // if not set, G4VoxelNavigation
   // will be used instead
+
+  G4int nVoxels = fNVoxelX * fNVoxelY * fNVoxelZ;
+  PrintVoxelReport(nVoxels, (size_t)nVoxels * sizeof(size_t));
   
   SetScorer(voxel_logic);
 }
 
+void BDSCT::BuildMergedPhantom(G4LogicalVolume* voxelLogic)
+{
+  std::array<G4int, 3> nVoxels = {fNVoxelX, fNVoxelY, fNVoxelZ};
+  std::vector<BDSDicomVoxelBlock> blocks = BDSDicomMergedParameterisation::MergeVoxels(fMateIDs, nVoxels);
+  
+  // the colours are read in the same way as for the regular phantom - the
+  // parameterisation is kept only for its colour map
+  colourParameterisation = new BDSDicomPhantomParameterisationColour(dicomDataPath + "ColourMap.dat");
+  auto param = new BDSDicomMergedParameterisation(blocks,
+                                                  fMaterials,
+                                                  G4ThreeVector(fVoxelHalfDimX, fVoxelHalfDimY, fVoxelHalfDimZ),
+                                                  nVoxels,
+                                                  &colourParameterisation->GetColourMap());
+  
+  // kUndefined so that Geant4 builds smart voxels for the boxes of different sizes
+  new G4PVParameterised("phantom",
+                        voxelLogic,
+                        containerLogicalVolume,
+                        kUndefined,
+                        param->NumberOfBlocks(),
+                        param);
+
+  PrintVoxelReport(param->NumberOfBlocks(), blocks.size() * sizeof(BDSDicomVoxelBlock));
+
+  // the per-voxel material indices are no longer required
+  delete[] fMateIDs;
+  fMateIDs = nullptr;
+}
+
+void BDSCT::PrintVoxelReport(G4int  nVoxelsAfter,
+                             size_t memoryAfter) const
+{
+  G4int  nVoxelsBefore = fNVoxelX * fNVoxelY * fNVoxelZ;
+  size_t memoryBefore  = (size_t)nVoxelsBefore * sizeof(size_t);
+  G4cout << "BDSCT \"" << name << "\": voxel merging \"" << voxelMerging << "\"" << G4endl;
+  G4cout << "BDSCT voxels:  " << nVoxelsBefore << " -> " << nVoxelsAfter << G4endl;
+  auto oldPrecision = G4cout.precision(3);
+  G4cout << "BDSCT voxel description memory: "
+         << memoryBefore / 1048576.0 << " MB -> " << memoryAfter / 1048576.0 << " MB" << G4endl;
+  G4cout.precision(oldPrecision);
+  if (voxelMerging != "runlength")
+    {G4cout << "BDSCT skip voxels of equal material: " << (skipEqualMaterials ? "yes" : "no") << G4endl;}
+}
+
 void BDSCT::InitialisationOfMaterials()
 {
   // Creating elements :
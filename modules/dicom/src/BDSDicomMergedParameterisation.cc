@@ -0,0 +1,168 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDicomMergedParameterisation.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4VisAttributes.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VVisManager.hh"
+
+#include <array>
+#include <map>
+#include <utility>
+#include <vector>
+
+BDSDicomMergedParameterisation::BDSDicomMergedParameterisation(const std::vector<BDSDicomVoxelBlock>& blocksIn,
+							       const std::vector<G4Material*>& materialsIn,
+							       const G4ThreeVector& voxelHalfSizeIn,
+							       const std::array<G4int, 3>& nVoxelsIn,
+							       const ColourMap_t* coloursIn):
+  blocks(blocksIn),
+  materials(materialsIn),
+  voxelHalfSize(voxelHalfSizeIn),
+  nVoxels(nVoxelsIn),
+  colours(coloursIn)
+{;}
+
+std::vector<BDSDicomVoxelBlock> BDSDicomMergedParameterisation::MergeVoxels(const size_t* materialIndices,
+									    const std::array<G4int, 3>& nVoxels)
+{
+  const G4int nx = nVoxels[0];
+  const G4int ny = nVoxels[1];
+  const G4int nz = nVoxels[2];
+  
+  std::vector<BDSDicomVoxelBlock> result;
+  // blocks that ended in the previous z slice and may be extended into this one
+  // key is (ix, nx, iy, ny, material)
+  std::map<std::array<G4int, 5>, size_t> openInZ;
+  for (G4int iz = 0; iz < nz; ++iz)
+    {
+      std::vector<BDSDicomVoxelBlock> slice;
+      // runs that ended in the previous row and may be extended into this one
+      // key is (ix, nx, material)
+      std::map<std::array<G4int, 3>, size_t> openInY;
+      for (G4int iy = 0; iy < ny; ++iy)
+	{
+	  std::map<std::array<G4int, 3>, size_t> openInYNext;
+	  const size_t* row = materialIndices + (size_t)iy*nx + (size_t)iz*nx*ny;
+	  G4int ix = 0;
+	  while (ix < nx)
+	    {
+	      G4int ixEnd = ix + 1;
+	      while (ixEnd < nx && row[ixEnd] == row[ix])
+		{ixEnd++;}
+	      std::array<G4int, 3> key = {ix, ixEnd - ix, (G4int)row[ix]};
+	      auto search = openInY.find(key);
+	      if (search != openInY.end())
+		{
+		  slice[search->second].size[1] += 1;
+		  openInYNext[key] = search->second;
+		}
+	      else
+		{
+		  slice.push_back(BDSDicomVoxelBlock{{ix, iy, iz}, {ixEnd - ix, 1, 1}, (G4int)row[ix]});
+		  openInYNext[key] = slice.size() - 1;
+		}
+	      ix = ixEnd;
+	    }
+	  openInY = std::move(openInYNext);
+	}
+
+      std::map<std::array<G4int, 5>, size_t> openInZNext;
+      for (const auto& block : slice)
+	{
+	  std::array<G4int, 5> key = {block.start[0], block.size[0],
+				      block.start[1], block.size[1],
+				      block.materialIndex};
+	  auto search = openInZ.find(key);
+	  if (search != openInZ.end())
+	    {
+	      result[search->second].size[2] += 1;
+	      openInZNext[key] = search->second;
+	    }
+	  else
+	    {
+	      result.push_back(block);
+	      openInZNext[key] = result.size() - 1;
+	    }
+	}
+      openInZ = std::move(openInZNext);
+    }
+  return result;
+}
+
+void BDSDicomMergedParameterisation::ComputeTransformation(const G4int copyNo,
+							   G4VPhysicalVolume* physVol) const
+{
+  const BDSDicomVoxelBlock& block = blocks[copyNo];
+  G4ThreeVector centre;
+  for (G4int i = 0; i < 3; i++)
+    {centre[i] = (2*block.start[i] + block.size[i] - nVoxels[i]) * voxelHalfSize[i];}
+  physVol->SetTranslation(centre);
+  physVol->SetRotation(nullptr);
+}
+
+void BDSDicomMergedParameterisation::ComputeDimensions(G4Box& box,
+						       const G4int copyNo,
+						       const G4VPhysicalVolume*) const
+{
+  const BDSDicomVoxelBlock& block = blocks[copyNo];
+  box.SetXHalfLength(block.size[0] * voxelHalfSize.x());
+  box.SetYHalfLength(block.size[1] * voxelHalfSize.y());
+  box.SetZHalfLength(block.size[2] * voxelHalfSize.z());
+}
+
+G4Material* BDSDicomMergedParameterisation::ComputeMaterial(const G4int copyNo,
+							    G4VPhysicalVolume* currentVol,
+							    const G4VTouchable*)
+{
+  G4Material* material = materials[blocks[copyNo].materialIndex];
+  if (G4VVisManager::GetConcreteInstance() && currentVol && colours)
+    {
+      G4VisAttributes* vis = Colour(material);
+      if (vis)
+	{currentVol->GetLogicalVolume()->SetVisAttributes(vis);}
+    }
+  return material;
+}
+
+G4VisAttributes* BDSDicomMergedParameterisation::Colour(const G4Material* material) const
+{
+  G4String materialName = material->GetName();
+  std::string::size_type iuu = materialName.find("__");
+  if (iuu != std::string::npos)
+    {materialName = materialName.substr(0, iuu);}
+
+  auto search = colours->find(materialName);
+  if (search != colours->end())
+    {return search->second;}
+
+  // new materials are named as the original material + "_" + density
+  for (const auto& kv : *colours)
+    {
+      const G4String& name = kv.first;
+      auto len = name.length();
+      if (materialName.find(name) == 0 && materialName.length() > len && materialName[len] == '_')
+	{return kv.second;}
+    }
+  auto defaultColour = colours->find("Default");
+  return defaultColour != colours->end() ? defaultColour->second : nullptr;
+}
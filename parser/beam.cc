@@ -171,6 +171,7 @@ void Beam::PublishMembers()
   publish("distrFileMatchLength", &Beam::distrFileMatchLength);
   publish("distrFileLoop",        &Beam::distrFileLoop);
   publish("distrFileLoopNTimes",  &Beam::distrFileLoopNTimes);
+  publish("distrFilePrefetch",    &Beam::distrFilePrefetch);
   publish("removeUnstableWithoutDecay", &Beam::removeUnstableWithoutDecay);
   publish("nlinesIgnore",         &Beam::nlinesIgnore);
   publish("nLinesIgnore",         &Beam::nlinesIgnore); // for consistency
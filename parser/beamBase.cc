@@ -42,6 +42,7 @@ BeamBase::BeamBase()
   distrFileMatchLength = true;
   distrFileLoop        = false;
   distrFileLoopNTimes  = 1;
+  distrFilePrefetch    = 0;
   removeUnstableWithoutDecay = true;
   nlinesIgnore         = 0;
   nlinesSkip           = 0;
@@ -55,6 +55,7 @@ namespace GMAD
       bool        distrFileMatchLength;
       bool        distrFileLoop;
       int         distrFileLoopNTimes;
+      int         distrFilePrefetch; ///< Number of events to read ahead in a separate thread.
       bool        removeUnstableWithoutDecay;
       ///@}
       int         nlinesIgnore; ///< Ignore first lines in the input bunch file.
@@ -251,6 +251,8 @@ void Element::PublishMembers()
 
   publish("dicomDataPath",       &Element::dicomDataPath);
   publish("dicomDataFile",       &Element::dicomDataFile);
+  publish("dicomVoxelMerging",   &Element::dicomVoxelMerging);
+  publish("dicomSkipEqualMaterials", &Element::dicomSkipEqualMaterials);
 
   publish("colour",              &Element::colour);
   
@@ -359,6 +361,8 @@ void Element::print(int ident) const
       {
         std::cout << "dicomDataPath: " << dicomDataPath << std::endl;
         std::cout << "dicomDataFile: " << dicomDataFile << std::endl;
+        std::cout << "dicomVoxelMerging: " << dicomVoxelMerging << std::endl;
+        std::cout << "dicomSkipEqualMaterials: " << dicomSkipEqualMaterials << std::endl;
         break;
       }
     case ElementType::_AWAKESCREEN:
@@ -623,6 +627,8 @@ void Element::flush()
   
   dicomDataFile = "";
   dicomDataPath = "";
+  dicomVoxelMerging = "none";
+  dicomSkipEqualMaterials = false;
   
   colour = "";
 
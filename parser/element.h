@@ -226,6 +226,8 @@ namespace GMAD
 
     std::string dicomDataPath; ///< for CT, file for DICOM construction data
     std::string dicomDataFile; ///< for CT, file for DICOM construction data
+    std::string dicomVoxelMerging;       ///< for CT, "none" or "runlength"
+    bool        dicomSkipEqualMaterials; ///< for CT, regular navigation through equal materials
 
     /// Override colour for certain items
     std::string colour;
@@ -0,0 +1,134 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "expandedsequence.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace GMAD;
+
+ExpandedSequence::ExpandedSequence():
+  ExpandedSequence(std::make_shared<ElementDefinitions>())
+{;}
+
+ExpandedSequence::ExpandedSequence(std::shared_ptr<ElementDefinitions> definitionsIn):
+  definitions(definitionsIn),
+  nameIndexValid(false)
+{;}
+
+unsigned int ExpandedSequence::AddDefinition(const Element& definition)
+{
+  auto search = definitions->index.find(definition.name);
+  if (search != definitions->index.end())
+    {return search->second;}
+  
+  unsigned int index = (unsigned int)definitions->elements.size();
+  definitions->elements.push_back(definition);
+  definitions->index[definition.name] = index;
+  return index;
+}
+
+void ExpandedSequence::push_back(unsigned int definitionIndex)
+{
+  occurrences.push_back(Occurrence{definitionIndex, -1});
+  nameIndexValid = false;
+}
+
+void ExpandedSequence::append(const std::vector<unsigned int>& definitionIndices)
+{
+  occurrences.reserve(occurrences.size() + definitionIndices.size());
+  for (auto index : definitionIndices)
+    {occurrences.push_back(Occurrence{index, -1});}
+  nameIndexValid = false;
+}
+
+void ExpandedSequence::clear()
+{
+  occurrences.clear();
+  modified.clear();
+  nameIndex.clear();
+  nameIndexValid = false;
+}
+
+void ExpandedSequence::keep(std::size_t first, std::size_t last)
+{
+  if (first >= occurrences.size() || first > last)
+    {occurrences.clear();}
+  else
+    {
+      if (last + 1 < occurrences.size())
+        {occurrences.erase(occurrences.begin() + (last + 1), occurrences.end());}
+      occurrences.erase(occurrences.begin(), occurrences.begin() + first);
+    }
+  nameIndexValid = false;
+}
+
+const Element& ExpandedSequence::operator[](std::size_t i) const
+{
+  const Occurrence& occurrence = occurrences[i];
+  if (occurrence.modified >= 0)
+    {return modified[(std::size_t)occurrence.modified];}
+  else
+    {return definitions->elements[occurrence.definition];}
+}
+
+Element& ExpandedSequence::modify(std::size_t i)
+{
+  Occurrence& occurrence = occurrences[i];
+  if (occurrence.modified < 0)
+    {
+      modified.push_back(definitions->elements[occurrence.definition]);
+      occurrence.modified = (int)modified.size() - 1;
+    }
+  return modified[(std::size_t)occurrence.modified];
+}
+
+void ExpandedSequence::BuildNameIndex() const
+{
+  if (nameIndexValid)
+    {return;}
+  nameIndex.clear();
+  for (std::size_t i = 0; i < occurrences.size(); i++)
+    {nameIndex[(*this)[i].name].push_back(i);}
+  nameIndexValid = true;
+}
+
+const std::vector<std::size_t>& ExpandedSequence::positions(const std::string& name) const
+{
+  static const std::vector<std::size_t> none;
+  BuildNameIndex();
+  auto search = nameIndex.find(name);
+  return search != nameIndex.end() ? search->second : none;
+}
+
+ExpandedSequence::const_iterator ExpandedSequence::find(const std::string& name, unsigned int count) const
+{
+  const std::vector<std::size_t>& indices = positions(name);
+  if (count < 1 || count > indices.size())
+    {return end();}
+  return const_iterator(this, indices[count - 1]);
+}
+
+void ExpandedSequence::print(int ident) const
+{
+  for (const auto& element : *this)
+    {element.print(ident);}
+}
@@ -0,0 +1,204 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EXPANDEDSEQUENCE_H
+#define EXPANDEDSEQUENCE_H
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "element.h"
+
+namespace GMAD
+{
+  /**
+   * @brief Store of element definitions that may be shared between expanded sequences.
+   *
+   * Each definition is stored once by name. A deque is used so references to
+   * stored elements remain valid as more are added.
+   *
+   * @author BDSIM Developers
+   */
+  struct ElementDefinitions
+  {
+    std::deque<Element> elements;
+    std::unordered_map<std::string, unsigned int> index;
+  };
+
+  /**
+   * @brief A fully expanded beam line.
+   *
+   * Rather than a complete copy of the element for each occurrence, each occurrence
+   * is an index of a definition in a (possibly shared) store of definitions. Only
+   * occurrences that are modified individually, e.g. by attaching a sampler, get their
+   * own copy of the element. Occurrences are held contiguously, so access by position
+   * is constant time, and there is a hash index of occurrences by name.
+   *
+   * Iteration gives a const reference to an Element that remains valid for the
+   * lifetime of this object.
+   *
+   * @author BDSIM Developers
+   */
+  class ExpandedSequence
+  {
+  public:
+    /// A sequence with its own store of definitions.
+    ExpandedSequence();
+    /// A sequence that shares its store of definitions with other sequences.
+    explicit ExpandedSequence(std::shared_ptr<ElementDefinitions> definitionsIn);
+
+    /// Bidirectional iterator over the elements of each occurrence.
+    class const_iterator
+    {
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type        = Element;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const Element*;
+      using reference         = const Element&;
+
+      const_iterator(): sequence(nullptr), index(0) {;}
+      const_iterator(const ExpandedSequence* sequenceIn, std::size_t indexIn):
+        sequence(sequenceIn), index(indexIn) {;}
+
+      reference operator*()  const {return (*sequence)[index];}
+      pointer   operator->() const {return &(*sequence)[index];}
+      const_iterator& operator++() {++index; return *this;}
+      const_iterator& operator--() {--index; return *this;}
+      const_iterator  operator++(int) {const_iterator r = *this; ++index; return r;}
+      const_iterator  operator--(int) {const_iterator r = *this; --index; return r;}
+      bool operator==(const const_iterator& other) const {return index == other.index && sequence == other.sequence;}
+      bool operator!=(const const_iterator& other) const {return !(*this == other);}
+
+      /// Position of this occurrence in the sequence.
+      std::size_t Index() const {return index;}
+      
+    private:
+      const ExpandedSequence* sequence;
+      std::size_t index;
+    };
+
+    /// Store a definition (once by name) and return its index. If a definition with
+    /// the same name is already stored, that one is used.
+    unsigned int AddDefinition(const Element& definition);
+    
+    ///@{ Append an occurrence.
+    void push_back(unsigned int definitionIndex);
+    void push_back(const Element& definition) {push_back(AddDefinition(definition));}
+    ///@}
+    /// Append many occurrences at once.
+    void append(const std::vector<unsigned int>& definitionIndices);
+
+    /// Remove all occurrences. Definitions are kept as they may be shared.
+    void clear();
+    
+    /// Keep only the occurrences from first to last inclusive.
+    void keep(std::size_t first, std::size_t last);
+    
+    inline int  size()  const {return (int)occurrences.size();}
+    inline bool empty() const {return occurrences.empty();}
+    
+    const_iterator begin() const {return const_iterator(this, 0);}
+    const_iterator end()   const {return const_iterator(this, occurrences.size());}
+
+    /// Element of the i-th occurrence.
+    const Element& operator[](std::size_t i) const;
+
+    /// Get a modifiable copy of the element for only the i-th occurrence.
+    Element& modify(std::size_t i);
+
+    /// Apply modify to the element of every occurrence for which select is true. select
+    /// must only depend on the name and type of the element. If the store of definitions is
+    /// not shared with another sequence, the definitions are modified in place rather than
+    /// copied for each occurrence.
+    template <typename Select, typename Modify>
+    void modify_all(Select select, Modify modify);
+
+    /// Position of the count-th (1 counting) occurrence of an element name or end()
+    /// if there is no such occurrence.
+    const_iterator find(const std::string& name, unsigned int count = 1) const;
+
+    /// Positions of all occurrences of a name in order. Empty if there are none.
+    const std::vector<std::size_t>& positions(const std::string& name) const;
+
+    /// Number of unique definitions referred to, including any shared with other sequences.
+    inline std::size_t NumberOfDefinitions() const {return definitions->elements.size();}
+    /// Number of occurrences with their own modified copy.
+    inline std::size_t NumberOfModifiedOccurrences() const {return modified.size();}
+    
+    /// Get a vector of full copies of each element.
+    std::vector<Element> getVector() const {return std::vector<Element>(begin(), end());}
+
+    /// Print each element in order.
+    void print(int ident = 0) const;
+
+  private:
+    struct Occurrence
+    {
+      unsigned int definition; ///< Index in store of definitions.
+      int          modified;   ///< Index in modified copies or -1 if unmodified.
+    };
+
+    /// Build the index of positions by name if required.
+    void BuildNameIndex() const;
+
+    std::vector<Occurrence> occurrences;
+    std::shared_ptr<ElementDefinitions> definitions;
+    std::deque<Element> modified;
+
+    /// Index of occurrences by name - built on first query.
+    mutable std::unordered_map<std::string, std::vector<std::size_t>> nameIndex;
+    mutable bool nameIndexValid;
+  };
+
+  template <typename Select, typename Modify>
+  void ExpandedSequence::modify_all(Select select, Modify modify)
+  {
+    if (definitions.use_count() > 1)
+      {
+        for (std::size_t i = 0; i < occurrences.size(); i++)
+          {
+            if (select((*this)[i]))
+              {modify(this->modify(i));}
+          }
+        return;
+      }
+    
+    std::vector<bool> referenced(definitions->elements.size(), false);
+    for (const auto& occurrence : occurrences)
+      {referenced[occurrence.definition] = true;}
+    for (std::size_t i = 0; i < referenced.size(); i++)
+      {
+        Element& definition = definitions->elements[i];
+        if (referenced[i] && select(definition))
+          {modify(definition);}
+      }
+    for (auto& element : modified)
+      {
+        if (select(element))
+          {modify(element);}
+      }
+  }
+}
+
+#endif
@@ -158,6 +158,8 @@ void Options::PublishMembers()
   publish("outputFormat",          &Options::outputFormat);
   publish("outputDoublePrecision", &Options::outputDoublePrecision);
   publish("outputCompressionLevel",&Options::outputCompressionLevel);
+  publish("outputAsynchronous",    &Options::outputAsynchronous);
+  publish("outputCompressionThreads",&Options::outputCompressionThreads);
   publish("survey",                &Options::survey);
   publish("surveyFileName",        &Options::surveyFileName);
   
@@ -495,6 +497,8 @@ void Options::PublishMembers()
   publish("storeSamplerMass",               &Options::storeSamplerMass);
   publish("storeSamplerRigidity",           &Options::storeSamplerRigidity);
   publish("storeSamplerIon",                &Options::storeSamplerIon);
+  publish("storeSamplerCompact",            &Options::storeSamplerCompact);
+  publish("samplerSignificantBits",         &Options::samplerSignificantBits);
 
   publish("trajConnect",                    &Options::trajConnect);
   publish("trajectoryConnect",              &Options::trajConnect);
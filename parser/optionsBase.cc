@@ -43,6 +43,8 @@ OptionsBase::OptionsBase()
   outputDoublePrecision = false;
 #endif
   outputCompressionLevel= 5;
+  outputAsynchronous    = false;
+  outputCompressionThreads = 0;
   survey                = false;
   surveyFileName        = "survey.dat";
   batch                 = false;
@@ -345,6 +347,8 @@ OptionsBase::OptionsBase()
   storeSamplerMass         = false;
   storeSamplerRigidity     = false;
   storeSamplerIon          = false;
+  storeSamplerCompact      = false;
+  samplerSignificantBits   = 0;
 
   trajCutGTZ               = 1e99;  // minimum z position, so large default value
   trajCutLTR               = 0.0;   // maximum radius in mm, so small default value
@@ -50,6 +50,8 @@ namespace GMAD
     std::string outputFormat;
     bool        outputDoublePrecision;
     int         outputCompressionLevel;
+    bool        outputAsynchronous;
+    int         outputCompressionThreads;
     ///@}
   
     ///@{ Parameter for survey
@@ -385,6 +387,8 @@ namespace GMAD
     bool        storeSamplerMass;
     bool        storeSamplerRigidity;
     bool        storeSamplerIon;
+    bool        storeSamplerCompact;
+    int         samplerSignificantBits;
 
     double      trajCutGTZ;
     double      trajCutLTR;
@@ -189,6 +189,8 @@ Parameters::Parameters()
 
   setMap["dicomDataPath"]  = false;
   setMap["dicomDataFile"]  = false;
+  setMap["dicomVoxelMerging"] = false;
+  setMap["dicomSkipEqualMaterials"] = false;
 
   setMap["colour"] = false;
 
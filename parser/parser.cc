@@ -114,7 +114,9 @@ Parser* Parser::Instance(const std::string& name)
 
 Parser::~Parser()
 {
-  beamline_list.erase();
+  beamline_list.clear();
+  for (auto& kv : expandedSequences)
+    {delete kv.second;}
   // delete allocated lines
   for (auto element : allocated_lines)
     {delete element;}
@@ -290,9 +292,11 @@ void Parser::write_table(std::string* name, ElementType type, bool isLine)
 
 void Parser::expand_sequences()
 {
+  // all sequences share one store of definitions so each element is only copied once
+  sequenceDefinitions = std::make_shared<ElementDefinitions>();
   for (const auto& name : sequences)
     {
-      FastList<Element>* newLine = new FastList<Element>();
+      ExpandedSequence* newLine = new ExpandedSequence(sequenceDefinitions);
       expand_line(*newLine, name);
       expandedSequences[name] = newLine;
     }
@@ -302,10 +306,12 @@ void Parser::expand_line(const std::string& name,
                          const std::string& start,
                          const std::string& end)
 {
+  // fresh store of definitions as elements may have changed since any previous use
+  beamline_list = ExpandedSequence();
   expand_line(beamline_list, name, start, end);
 }
 
-void Parser::expand_line(FastList<Element>& target,
+void Parser::expand_line(ExpandedSequence& target,
                          const std::string& name,
                          const std::string& start,
                          const std::string& end)
@@ -334,102 +340,12 @@ void Parser::expand_line(FastList<Element>& target,
 #endif
   if (!line.lst)
     {return;} //list empty
-    
-  // first expand the whole range 
-  std::list<Element>::iterator sit = line.lst->begin();
-  std::list<Element>::iterator eit = line.lst->end();
-  
-  // copy the list into the resulting list
-  switch(line.type)
-    {
-      case ElementType::_LINE:
-        {target.insert(target.end(),sit,eit); break;}
-      case ElementType::_REV_LINE:
-        {target.insert(target.end(),line.lst->rbegin(),line.lst->rend()); break;}
-      default:
-        {target.insert(target.end(),sit,eit); break;}
-    }
-  // bool to check if beamline is fully expanded
-  bool is_expanded = false;
-  
-  // parse starting from the second element until the list is expanded
-  int iteration = 0;
-    while (!is_expanded)
-    {
-      is_expanded = true;
-      // start at second element
-      std::list<Element>::iterator it = ++target.begin();
-      for (; it!=target.end(); ++it)
-        {
-          Element& element = *it; // alias
-          const ElementType& type = element.type;
-#ifdef BDSDEBUG 
-          std::cout << element.name << " , " << type << std::endl;
-#endif
-          // if list - expand further
-          if (type != ElementType::_LINE && type != ElementType::_REV_LINE)
-            {continue;}
-          is_expanded = false;
-          // lookup the line in main list
-          std::list<Element>::const_iterator tmpit = element_list.find(element.name);
-          std::list<Element>::const_iterator iterEnd = element_list.end();
-          if ( (tmpit != iterEnd) && ( (*tmpit).lst != nullptr) )
-            { // sublist found and not empty
-              const Element& list = *tmpit; // alias
-#ifdef BDSDEBUG
-              std::cout << "inserting sequence for " << element.name << " - " << list.name << " ...";
-#endif
-              if (type == ElementType::_LINE)
-                {target.insert(it,list.lst->begin(),list.lst->end());}
-              else if (type == ElementType::_REV_LINE)
-                {
-                  //iterate over list and invert any sublines contained within. SPM
-                  std::list<Element> tmpList;
-                  tmpList.insert(tmpList.end(),list.lst->begin(),list.lst->end());
-                  for (std::list<Element>::iterator itLineInverter = tmpList.begin();
-                       itLineInverter != tmpList.end(); ++itLineInverter)
-                    {
-                      if ( (*itLineInverter).type == ElementType::_LINE)
-                        {(*itLineInverter).type = ElementType::_REV_LINE;}
-                      else if ((*itLineInverter).type == ElementType::_REV_LINE)
-                        {(*itLineInverter).type = ElementType::_LINE;}
-                    }
-                  target.insert(it,tmpList.rbegin(),tmpList.rend());
-                }
-#ifdef BDSDEBUG
-              std::cout << "inserted" << std::endl;
-#endif
-              // delete the list pointer
-              target.erase(it--);
-            }
-          else if ( tmpit != iterEnd )
-            { // entry points to a scalar element type -
-              //transfer properties from the main list
-#ifdef BDSDEBUG 
-              std::cout << "keeping element..." << element.name << std::endl;
-#endif
-              // copy properties
-              element = (*tmpit);
-              
-#ifdef BDSDEBUG 
-              std::cout << "done" << std::endl;
-#endif
-            }
-          else
-            { // element of undefined type
-              std::cerr << "Error : Expanding line \"" << name << "\" : element \"" << element.name
-                        << "\" has not been defined! " << std::endl;
-              exit(1);
-            }
-        }
-      iteration++;
-      if ( iteration > MAX_EXPAND_ITERATIONS )
-        {
-          std::cerr << "Error : Line expansion of '" << name << "' seems to loop, " << std::endl
-                    << "possible recursive line definition, quitting" << std::endl;
-          exit(1);
-        }
-    }// while
+
+  // expand the whole line - each unique subline is only expanded once
+  std::map<std::pair<std::string, bool>, std::vector<unsigned int>> cache;
+  std::vector<unsigned int> expanded;
+  expand_line_contents(target, name, *line.lst, line.type == ElementType::_REV_LINE, 0, cache, expanded);
+  target.append(expanded);
     
   // leave only the desired range
   //
@@ -437,18 +353,16 @@ void Parser::expand_line(FastList<Element>& target,
   
   if ( !start.empty()) // determine the start element
     {
-      std::list<Element>::const_iterator startIt = target.find(std::string(start));
-      
-      if(startIt!=target.end())
-        {target.erase(target.begin(),startIt);}
+      auto startIt = target.find(start);
+      if (startIt != target.end())
+        {target.keep(startIt.Index(), target.size() - 1);}
     }
   
   if ( !end.empty()) // determine the end element
     {
-      std::list<Element>::const_iterator endIt = target.find(std::string(end));
-      
-      if(endIt!=target.end())
-        {target.erase(++endIt,target.end());}
+      auto endIt = target.find(end);
+      if (endIt != target.end())
+        {target.keep(0, endIt.Index());}
     }
   
   // insert the tunnel if present
@@ -458,7 +372,68 @@ void Parser::expand_line(FastList<Element>& target,
     {target.push_back(*itTunnel);}
 }
 
-const FastList<Element>& Parser::get_sequence(const std::string& name)
+void Parser::expand_line_contents(ExpandedSequence& target,
+                                  const std::string& lineName,
+                                  const std::list<Element>& contents,
+                                  bool reversed,
+                                  int depth,
+                                  std::map<std::pair<std::string, bool>, std::vector<unsigned int>>& cache,
+                                  std::vector<unsigned int>& result)
+{
+  if (depth > MAX_EXPAND_ITERATIONS)
+    {
+      std::cerr << "Error : Line expansion of '" << lineName << "' seems to loop, " << std::endl
+                << "possible recursive line definition, quitting" << std::endl;
+      exit(1);
+    }
+
+  auto expandItem = [&](const Element& item)
+  {
+    // items in a line are all of type line or reversed line until resolved - inside a
+    // reversed line the direction of each subline is inverted
+    bool itemReversed = item.type == ElementType::_REV_LINE;
+    if (reversed)
+      {itemReversed = !itemReversed;}
+    
+    std::list<Element>::const_iterator definition = element_list.find(item.name);
+    if (definition == element_list.end())
+      {
+        std::cerr << "Error : Expanding line \"" << lineName << "\" : element \"" << item.name
+                  << "\" has not been defined! " << std::endl;
+        exit(1);
+      }
+    
+    if ((*definition).type == ElementType::_LINE || (*definition).type == ElementType::_REV_LINE)
+      {// sublist - expand further
+        if (!(*definition).lst)
+          {return;} // empty line
+        auto key = std::make_pair(item.name, itemReversed);
+        auto search = cache.find(key);
+        if (search == cache.end())
+          {
+            std::vector<unsigned int> subline;
+            expand_line_contents(target, lineName, *(*definition).lst, itemReversed, depth + 1, cache, subline);
+            search = cache.emplace(key, std::move(subline)).first;
+          }
+        result.insert(result.end(), search->second.begin(), search->second.end());
+      }
+    else
+      {result.push_back(target.AddDefinition(*definition));}
+  };
+
+  if (reversed)
+    {
+      for (auto it = contents.rbegin(); it != contents.rend(); ++it)
+        {expandItem(*it);}
+    }
+  else
+    {
+      for (const auto& item : contents)
+        {expandItem(item);}
+    }
+}
+
+const ExpandedSequence& Parser::get_sequence(const std::string& name)
 {
   // search for previously queried beamlines
   const auto search = expandedSequences.find(name);
@@ -480,49 +455,52 @@ void Parser::set_sampler(const std::string& name,
   // skip first element and add one at the end
   if (count == -2)
     {
-      for (auto it = beamline_list.begin(); it != beamline_list.end(); ++it)
-        {// skip LINEs
-          if((*it).type == ElementType::_LINE || (*it).type == ElementType::_REV_LINE)
-            {continue;}
-          // if type not equal to NONE and elements have to match type 
-          if (type != ElementType::_NONE && type != (*it).type)
-            {continue;}
-          
-          (*it).setSamplerInfo(samplerType,(*it).name,samplerRadius,particleSetID);
-        }
+      // the sampler name is the element name so every occurrence of a definition is
+      // the same and the definitions can be modified rather than each occurrence
+      auto select = [&](const Element& element)
+      {// skip LINEs
+        if (element.type == ElementType::_LINE || element.type == ElementType::_REV_LINE)
+          {return false;}
+        // if type not equal to NONE and elements have to match type
+        return type == ElementType::_NONE || type == element.type;
+      };
+      auto modify = [&](Element& element)
+      {element.setSamplerInfo(samplerType,element.name,samplerRadius,particleSetID);};
+      beamline_list.modify_all(select, modify);
     } 
   else if (count == -1) // if count equal to -1 add sampler to all element instances
     {
-      auto itPair = beamline_list.equal_range(name);
-      if (itPair.first == itPair.second)
+      const std::vector<std::size_t>& positions = beamline_list.positions(name);
+      if (positions.empty())
         {
           std::string msg = "parser> SetSampler> current beamline doesn't contain element \"" + name + "\"";
           yyerror2(msg.c_str());
         }
-      for (auto it = itPair.first; it != itPair.second; ++it)
+      if (beamline_list[positions.front()].type != ElementType::_MARKER)
+        {
+          auto select = [&](const Element& element) {return element.name == name;};
+          auto modify = [&](Element& element)
+          {element.setSamplerInfo(samplerType,name,samplerRadius,particleSetID);};
+          beamline_list.modify_all(select, modify);
+          return;
+        }
+      // copy as modifying may invalidate the reference
+      std::vector<std::size_t> markerPositions = positions;
+      for (auto position : markerPositions)
         {
           // if sampler is attached to a marker, really attach it to the previous element with the name of marker
-          auto elementIt = (it->second);
-          std::string samplerName = elementIt->name;
-          if ((*elementIt).type == ElementType::_MARKER)
-            {
-              // need to find real element before
-              // but careful not to go beyond first element also!
-              while ((*elementIt).isSpecial())
-                {
-                  elementIt--;
-                  // have to break first before continue since in while loop
-                  if (elementIt == beamline_list.begin())
-                    {break;}
-                }
+          // need to find real element before
+          // but careful not to go beyond first element also!
+          std::size_t i = position;
+          while (i > 0 && beamline_list[i].isSpecial())
+            {i--;}
           
-              if (elementIt==beamline_list.begin())
-                {
-                  std::cout << "parser> SetSampler> WARNING: no element before marker " << name << ", no sampler added" << std::endl;
-                  continue;
-                }
+          if (i == 0)
+            {
+              std::cout << "parser> SetSampler> WARNING: no element before marker " << name << ", no sampler added" << std::endl;
+              continue;
             }
-          (*elementIt).setSamplerInfo(samplerType,samplerName,samplerRadius,particleSetID);
+          beamline_list.modify(i).setSamplerInfo(samplerType,name,samplerRadius,particleSetID);
         }
     }
   else
@@ -534,22 +512,22 @@ void Parser::set_sampler(const std::string& name,
           yyerror2(msg.c_str());
         }
       // if sampler is attached to a marker, really attach it to the previous element with the name of marker
-      std::string samplerName = (*it).name;
-      if ((*it).type == ElementType::_MARKER)
+      std::size_t i = it.Index();
+      if (beamline_list[i].type == ElementType::_MARKER)
         {
           // need to find real element before
           // but careful not to go beyond first element also!
-          while ((*it).isSpecial())
+          while (beamline_list[i].isSpecial())
             {
-              it--;
-              if (it == beamline_list.begin())
+              i--;
+              if (i == 0)
                 {
                   std::cout << "parser> SetSampler> WARNING: no element before marker " << name << ", no sampler added" << std::endl;
                   return;
                 }
             }
         }
-      (*it).setSamplerInfo(samplerType,samplerName,samplerRadius,particleSetID);
+      beamline_list.modify(i).setSamplerInfo(samplerType,name,samplerRadius,particleSetID);
     }
 }
 
@@ -900,7 +878,7 @@ bool Parser::TryPrintingObject(const std::string& objectName) const
   return false;
 }
 
-const FastList<Element>& Parser::GetBeamline()const
+const ExpandedSequence& Parser::GetBeamline()const
 {
   return beamline_list;
 }
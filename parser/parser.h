@@ -21,6 +21,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -34,6 +35,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "crystal.h"
 #include "element.h"
 #include "elementtype.h"
+#include "expandedsequence.h"
 #include "field.h"
 #include "fastlist.h"
 #include "material.h"
@@ -105,9 +107,9 @@ namespace GMAD
     /// Method that transfers parameters to element properties
     void write_table(std::string* name, ElementType type, bool isLine=false);
 
-    /// Expand a sequence by name from start to end into the target list. This
+    /// Expand a sequence by name from start to end into the target sequence. This
     /// removes sublines from the beamline into one LINE.
-    void expand_line(FastList<Element>& target,
+    void expand_line(ExpandedSequence& target,
                      const std::string& name,
                      const std::string& start = "",
                      const std::string& end   = "");
@@ -118,8 +120,8 @@ namespace GMAD
                      const std::string& end);
 
     /// Find the sequence defined in the parser and expand it if not already
-    /// done so. Cache result in map of fastlists.
-    const FastList<Element>& get_sequence(const std::string& name);
+    /// done so. Cache result in map of expanded sequences.
+    const ExpandedSequence& get_sequence(const std::string& name);
   
     /// Add a particle set for a sampler and return a unique integer ID for that set. If no list
     /// or empty list given, returns -1, the default for 'no filter'.
@@ -205,7 +207,7 @@ namespace GMAD
     std::string current_end;
     ///@}
     /// Beamline Access.
-    const FastList<Element>& GetBeamline() const;
+    const ExpandedSequence& GetBeamline() const;
     
   private:
     /// Set sampler
@@ -218,9 +220,20 @@ namespace GMAD
     void add_func(std::string name, double (*func)(double));
     void add_var(std::string name, double value, int is_reserved = 0);
 
-    /// Expand all sequences define with 'line' into FastLists.
+    /// Expand all sequences define with 'line' into ExpandedSequences.
     void expand_sequences();
 
+    /// Append the expansion of the contents of a line to the indices of definitions in
+    /// target. Sublines are expanded recursively. Each subline is only expanded once
+    /// per direction and the result is reused for further occurrences through cache.
+    void expand_line_contents(ExpandedSequence& target,
+                              const std::string& lineName,
+                              const std::list<Element>& contents,
+                              bool reversed,
+                              int depth,
+                              std::map<std::pair<std::string, bool>, std::vector<unsigned int>>& cache,
+                              std::vector<unsigned int>& result);
+
     // protected implementation (for inheritance to BDSParser - hackish)
   protected:
     /// Beam instance;
@@ -228,7 +241,7 @@ namespace GMAD
     /// General options
     Options options;
     /// Beamline
-    FastList<Element>   beamline_list;
+    ExpandedSequence   beamline_list;
     /// @{ List of parser defined instances of that object.
     FastList<Atom>   atom_list;
     FastList<NewColour> colour_list;
@@ -313,7 +326,10 @@ namespace GMAD
     std::vector<std::string> sequences;
 
     /// Cached copy of expanded sequences.
-    std::map<std::string, FastList<Element>*> expandedSequences;
+    std::map<std::string, ExpandedSequence*> expandedSequences;
+
+    /// Element definitions shared by all expanded sequences.
+    std::shared_ptr<ElementDefinitions> sequenceDefinitions;
 
     /// Parser symbol map
     SymbolMap symtab_map;
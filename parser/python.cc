@@ -21,7 +21,6 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "parser.h"
 
 #include <cstdio>
-#include <list>
 
 /** Python interface, need to match pybdsim/Gmad.py **/
 int GMAD::GmadParser_c(char *name)
@@ -37,83 +36,72 @@ int GMAD::GetNElements()
 
 const char* GMAD::GetName(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return (it->name).c_str();
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return (element.name).c_str();
 }
 
 int GMAD::GetType(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return static_cast<int>(it->type);
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return static_cast<int>(element.type);
 }
 
 double GMAD::GetLength(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return it->l;
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return element.l;
 }
 
 double GMAD::GetAngle(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return it->angle;
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return element.angle;
 }
 
 double* GMAD::GetKs(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
+  const Element& element = Parser::Instance()->GetBeamline()[i];
   double* result = new double[5];
-  result[0] = it->ks;
-  result[1] = it->k1;
-  result[2] = it->k2;
-  result[3] = it->k3;
-  result[4] = it->k4;
+  result[0] = element.ks;
+  result[1] = element.k1;
+  result[2] = element.k2;
+  result[3] = element.k3;
+  result[4] = element.k4;
   return result;
 }
 
 double GMAD::GetAper1(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return it->aper1;
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return element.aper1;
 }
 
 double GMAD::GetAper2(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return it->aper2;
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return element.aper2;
 }
 
 double GMAD::GetAper3(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return it->aper3;
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return element.aper3;
 }
 
 double GMAD::GetAper4(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return it->aper4;
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return element.aper4;
 }
 
 const char* GMAD::GetApertureType(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return (it->apertureType).c_str();
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return (element.apertureType).c_str();
 }
 
 double GMAD::GetBeampipeThickness(int i)
 {
-  std::list<Element>::const_iterator it = Parser::Instance()->GetBeamline().begin();
-  std::advance(it, i);
-  return it->beampipeThickness;
+  const Element& element = Parser::Instance()->GetBeamline()[i];
+  return element.beampipeThickness;
 }
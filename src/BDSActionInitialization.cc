@@ -0,0 +1,102 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSActionInitialization.hh"
+#include "BDSBunch.hh"
+#include "BDSEventAction.hh"
+#include "BDSFieldFactory.hh"
+#include "BDSGlobalConstants.hh"
+#include "BDSParser.hh"
+#include "BDSParticleDefinition.hh"
+#include "BDSPrimaryGeneratorAction.hh"
+#include "BDSRunAction.hh"
+#include "BDSSDManager.hh"
+#include "BDSStackingAction.hh"
+#include "BDSSteppingAction.hh"
+#include "BDSTrackingAction.hh"
+#include "BDSUtilities.hh"
+
+#include "parser/beam.h"
+#include "parser/scorermesh.h"
+
+BDSActionInitialization::BDSActionInitialization(BDSOutput*                outputIn,
+                                                 BDSBunch*                 bunchIn,
+                                                 const GMAD::Beam&         beamIn,
+                                                 const BDSGlobalConstants* globalsIn):
+  G4VUserActionInitialization(),
+  output(outputIn),
+  bunch(bunchIn),
+  beam(beamIn),
+  globals(globalsIn)
+{;}
+
+void BDSActionInitialization::BuildForMaster() const
+{
+  // the master only requires a run action - no events are processed on it
+  SetUserAction(new BDSRunAction(output,
+                                 bunch,
+                                 bunch->ParticleDefinition()->IsAnIon(),
+                                 nullptr,
+                                 globals->StoreTrajectorySamplerID()));
+}
+
+void BDSActionInitialization::Build() const
+{
+  BDSEventAction* eventAction = new BDSEventAction(output);
+  SetUserAction(eventAction);
+  
+  SetUserAction(new BDSRunAction(output,
+                                 bunch,
+                                 bunch->ParticleDefinition()->IsAnIon(),
+                                 eventAction,
+                                 globals->StoreTrajectorySamplerID()));
+  
+  // Only add stepping action if it is actually used, so do check here (for performance reasons)
+  G4int verboseSteppingEventStart = globals->VerboseSteppingEventStart();
+  G4int verboseSteppingEventStop  = BDS::VerboseEventStop(verboseSteppingEventStart,
+                                                          globals->VerboseSteppingEventContinueFor());
+  // virtual scoring meshes are filled from the stepping action - the meshes themselves
+  // are only constructed later on so we pass a reference to the (to be filled) vector
+  G4bool useVirtualMeshes = false;
+  for (const auto& mesh : BDSParser::Instance()->GetScorerMesh())
+    {useVirtualMeshes = useVirtualMeshes || BDS::LowerCase(mesh.geometryType) == "virtual";}
+  if (globals->VerboseSteppingBDSIM() || useVirtualMeshes)
+    {
+      SetUserAction(new BDSSteppingAction(globals->VerboseSteppingBDSIM(),
+                                          verboseSteppingEventStart,
+                                          verboseSteppingEventStop,
+                                          &BDSSDManager::Instance()->VirtualScoringMeshes()));
+    }
+  
+  SetUserAction(new BDSTrackingAction(globals->Batch(),
+                                      globals->StoreTrajectory(),
+                                      globals->StoreTrajectoryOptions(),
+                                      eventAction,
+                                      verboseSteppingEventStart,
+                                      verboseSteppingEventStop,
+                                      globals->VerboseSteppingPrimaryOnly(),
+                                      globals->VerboseSteppingLevel()));
+  
+  SetUserAction(new BDSStackingAction(globals));
+  
+  auto primaryGeneratorAction = new BDSPrimaryGeneratorAction(bunch, beam, globals->Batch());
+  // possibly updated after the primary generator as loaded a beam file
+  eventAction->SetPrintModulo(BDSGlobalConstants::Instance()->PrintModuloEvents());
+  SetUserAction(primaryGeneratorAction);
+  BDSFieldFactory::SetPrimaryGeneratorAction(primaryGeneratorAction);
+}
@@ -32,13 +32,16 @@ BDSArray2DCoords::BDSArray2DCoords(G4int nXIn, G4int nYIn,
 				   G4double xMinIn, G4double xMaxIn,
 				   G4double yMinIn, G4double yMaxIn,
 				   BDSDimensionType xDimensionIn,
-				   BDSDimensionType yDimensionIn):
+				   BDSDimensionType yDimensionIn,
+				   BDSArray4D::ExternalStorage* externalStorageIn):
   BDSArray3DCoords(nXIn,nYIn,1,
 		   xMinIn,xMaxIn,
 		   yMinIn,yMaxIn,
 		   0,   1,
 		   xDimensionIn,
-		   yDimensionIn)
+		   yDimensionIn,
+		   BDSDimensionType::z,
+		   externalStorageIn)
 {
   std::set<BDSDimensionType> allDims = {BDSDimensionType::x,
                                         BDSDimensionType::y,
@@ -23,16 +23,37 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "globals.hh" // geant4 types / globals
 
+#include <cstddef>
 #include <ostream>
 #include <string>
 #include <vector>
 
 
-BDSArray4D::BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn):
+BDSArray4D::BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn,
+		       ExternalStorage* externalStorageIn):
   nX(nXIn), nY(nYIn), nZ(nZIn), nT(nTIn),
   defaultValue(BDSFieldValue()),
-  data(std::vector<BDSFieldValue>(nTIn*nZIn*nYIn*nXIn))
-{;}
+  data(std::vector<BDSFieldValue>(externalStorageIn ? 0 : nTIn*nZIn*nYIn*nXIn)),
+  values(nullptr),
+  externalStorage(externalStorageIn)
+{
+  values = externalStorage ? externalStorage->values : data.data();
+}
+
+BDSArray4D::BDSArray4D(const BDSArray4D& other):
+  nX(other.nX), nY(other.nY), nZ(other.nZ), nT(other.nT),
+  defaultValue(other.defaultValue),
+  data(other.values, other.values + (std::size_t)other.nT*other.nZ*other.nY*other.nX),
+  values(nullptr),
+  externalStorage(nullptr)
+{
+  values = data.data();
+}
+
+BDSArray4D::~BDSArray4D()
+{
+  delete externalStorage;
+}
 
 BDSFieldValue& BDSArray4D::operator()(G4int x,
 				      G4int y,
@@ -40,7 +61,7 @@ BDSFieldValue& BDSArray4D::operator()(G4int x,
 				      G4int t)
 {
   OutsideWarn(x,y,z,t); // keep as a warning as can't assign to invalid index
-  return data[t*nZ*nY*nX + z*nY*nX + y*nX + x];
+  return values[t*nZ*nY*nX + z*nY*nX + y*nX + x];
 }
 
 const BDSFieldValue& BDSArray4D::GetConst(G4int x,
@@ -50,7 +71,7 @@ const BDSFieldValue& BDSArray4D::GetConst(G4int x,
 {
   if (Outside(x,y,z,t))
     {return defaultValue;}
-  return data[t*nZ*nY*nX + z*nY*nX + y*nX + x];
+  return values[t*nZ*nY*nX + z*nY*nX + y*nX + x];
 }
   
 const BDSFieldValue& BDSArray4D::operator()(G4int x,
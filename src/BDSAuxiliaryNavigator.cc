@@ -21,16 +21,22 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSStep.hh"
 #include "BDSUtilities.hh"
 
+#include "G4LogicalVolume.hh"
 #include "G4Navigator.hh"
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 #include "G4StepStatus.hh"
 #include "G4ThreeVector.hh"
-
-G4Navigator*       BDSAuxiliaryNavigator::auxNavigator             = new G4Navigator();
-G4Navigator*       BDSAuxiliaryNavigator::auxNavigatorCL           = new G4Navigator();
-G4Navigator*       BDSAuxiliaryNavigator::auxNavigatorCLB          = new G4Navigator();
-G4int              BDSAuxiliaryNavigator::numberOfInstances        = 0;
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+
+G4ThreadLocal G4Navigator* BDSAuxiliaryNavigator::auxNavigator    = nullptr;
+G4ThreadLocal G4Navigator* BDSAuxiliaryNavigator::auxNavigatorCL  = nullptr;
+G4ThreadLocal G4Navigator* BDSAuxiliaryNavigator::auxNavigatorCLB = nullptr;
+G4ThreadLocal G4int BDSAuxiliaryNavigator::numberOfInstances       = 0;
+G4ThreadLocal G4int BDSAuxiliaryNavigator::cacheGeneration         = 0;
+G4ThreadLocal G4long BDSAuxiliaryNavigator::transformCacheHits     = 0;
+G4ThreadLocal G4long BDSAuxiliaryNavigator::transformCacheMisses   = 0;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::worldPV                  = nullptr;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::curvilinearWorldPV       = nullptr;
 G4VPhysicalVolume* BDSAuxiliaryNavigator::curvilinearBridgeWorldPV = nullptr;
@@ -41,8 +47,14 @@ BDSAuxiliaryNavigator::BDSAuxiliaryNavigator():
   globalToLocalCL(G4AffineTransform()),
   localToGlobalCL(G4AffineTransform()),
   bridgeVolumeWasUsed(false),
+  cachedVolumeCL(nullptr),
+  cachedSolidCL(nullptr),
+  cachedGlobalToLocalCL(G4AffineTransform()),
+  cachedLocalToGlobalCL(G4AffineTransform()),
+  cachedGeneration(-1),
   volumeMargin(0.1*CLHEP::mm)
 {
+  InitialiseNavigators();
   numberOfInstances++;
 }
 
@@ -58,11 +70,75 @@ BDSAuxiliaryNavigator::~BDSAuxiliaryNavigator()
   numberOfInstances--;
 }
 
+void BDSAuxiliaryNavigator::InitialiseNavigators()
+{
+  // the world volumes may not be registered yet, in which case they are
+  // attached when they are registered through the static functions
+  if (!auxNavigator)
+    {
+      auxNavigator = new G4Navigator();
+      if (worldPV)
+        {auxNavigator->SetWorldVolume(worldPV);}
+    }
+  if (!auxNavigatorCL)
+    {
+      auxNavigatorCL = new G4Navigator();
+      if (curvilinearWorldPV)
+        {auxNavigatorCL->SetWorldVolume(curvilinearWorldPV);}
+    }
+  if (!auxNavigatorCLB)
+    {
+      auxNavigatorCLB = new G4Navigator();
+      if (curvilinearBridgeWorldPV)
+        {auxNavigatorCLB->SetWorldVolume(curvilinearBridgeWorldPV);}
+    }
+}
+
 void BDSAuxiliaryNavigator::ResetNavigatorStates()
 {
+  InitialiseNavigators();
   auxNavigator->ResetStackAndState();
   auxNavigatorCL->ResetStackAndState();
   auxNavigatorCLB->ResetStackAndState();
+  cacheGeneration++;
+}
+
+void BDSAuxiliaryNavigator::PrintTransformCacheStatistics()
+{
+  G4long total = transformCacheHits + transformCacheMisses;
+  if (total == 0)
+    {return;}
+  G4cout << "BDSAuxiliaryNavigator> curvilinear transform cache: " << transformCacheHits << " hits, "
+         << transformCacheMisses << " misses (" << 100.0 * (G4double)transformCacheHits / (G4double)total
+         << "% hit rate)" << G4endl;
+}
+
+G4bool BDSAuxiliaryNavigator::UseCachedTransformCL(const G4ThreeVector& globalPoint) const
+{
+  if (!cachedVolumeCL || cachedGeneration != cacheGeneration)
+    {return false;}
+  G4ThreeVector localPoint = cachedGlobalToLocalCL.TransformPoint(globalPoint);
+  if (cachedSolidCL->Inside(localPoint) != kInside)
+    {return false;} // on the surface or outside so the navigator is required
+  globalToLocalCL = cachedGlobalToLocalCL;
+  localToGlobalCL = cachedLocalToGlobalCL;
+  bridgeVolumeWasUsed = false;
+  return true;
+}
+
+void BDSAuxiliaryNavigator::CacheTransformCL(G4VPhysicalVolume* selectedVol) const
+{
+  cachedVolumeCL = nullptr;
+  if (!selectedVol || bridgeVolumeWasUsed || selectedVol == curvilinearWorldPV)
+    {return;}
+  G4LogicalVolume* lv = selectedVol->GetLogicalVolume();
+  if (lv->GetNoDaughters() > 0)
+    {return;} // a point inside this volume could be in one of its daughters
+  cachedVolumeCL        = selectedVol;
+  cachedSolidCL         = lv->GetSolid();
+  cachedGlobalToLocalCL = globalToLocalCL;
+  cachedLocalToGlobalCL = localToGlobalCL;
+  cachedGeneration      = cacheGeneration;
 }
 
 G4VPhysicalVolume* BDSAuxiliaryNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& point,
@@ -198,17 +274,30 @@ BDSStep BDSAuxiliaryNavigator::ConvertToLocal(const G4ThreeVector& globalPositio
   else if (stepLength > 0) // must be a shorter length, obey it
     {point += globalDirUnit * (stepLength * 0.5);}
   // else pass: point = globalPosition
-  
-  auto selectedVol = LocateGlobalPointAndSetup(point,
-                                               &globalDirection,
-                                               true,  // relative search
-                                               false, // don't ignore direction, ie use it
-                                               useCurvilinear);
+
+  G4VPhysicalVolume* selectedVol = nullptr;
+  if (useCurvilinear && UseCachedTransformCL(point))
+    {// still inside the same curvilinear volume so no need to search
+      transformCacheHits++;
+      selectedVol = cachedVolumeCL;
+    }
+  else
+    {
+      selectedVol = LocateGlobalPointAndSetup(point,
+                                              &globalDirection,
+                                              true,  // relative search
+                                              false, // don't ignore direction, ie use it
+                                              useCurvilinear);
 #ifdef BDSDEBUGNAV
-  G4cout << __METHOD_NAME__ << selectedVol->GetName() << G4endl;
+      G4cout << __METHOD_NAME__ << selectedVol->GetName() << G4endl;
 #endif
-  
-  useCurvilinear ? InitialiseTransform(false, true) : InitialiseTransform(true, false);
+      useCurvilinear ? InitialiseTransform(false, true) : InitialiseTransform(true, false);
+      if (useCurvilinear)
+        {
+          transformCacheMisses++;
+          CacheTransformCL(selectedVol);
+        }
+    }
   const G4AffineTransform& aff = GlobalToLocal(useCurvilinear);
   G4ThreeVector localPos = aff.TransformPoint(globalPosition);
   G4ThreeVector localDir = aff.TransformAxis(globalDirection);
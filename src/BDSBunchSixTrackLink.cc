@@ -20,7 +20,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSIonDefinition.hh"
+#include "BDSLinkBatch.hh"
 #include "BDSParticleDefinition.hh"
+#include "BDSPhysicsUtilities.hh"
 
 #include "globals.hh"
 #include "G4IonTable.hh"
@@ -28,6 +30,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ParticleTable.hh"
 #include "G4String.hh"
 
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <chrono>
+#include <map>
+#include <tuple>
 #include <vector>
 
 BDSBunchSixTrackLink::BDSBunchSixTrackLink():
@@ -36,14 +44,29 @@ BDSBunchSixTrackLink::BDSBunchSixTrackLink():
   currentExternalParticleID(0),
   currentExternalParentID(0),
   currentParticleDefinition(nullptr),
-  size(0)
+  size(0),
+  batch(nullptr),
+  batchSize(0),
+  batchInputTime(0)
 {;}
 
 BDSBunchSixTrackLink::~BDSBunchSixTrackLink()
-{;}
+{
+  for (auto& kv : batchParticleDefinitions)
+    {delete kv.second;}
+}
 
 BDSParticleCoordsFull BDSBunchSixTrackLink::GetNextParticleLocal()
 {
+  if (batch)
+    {
+      auto tStart = std::chrono::steady_clock::now();
+      BDSParticleCoordsFull result = GetNextBatchParticle();
+      std::chrono::duration<double> duration = std::chrono::steady_clock::now() - tStart;
+      batchInputTime += duration.count();
+      return result;
+    }
+  
   if (currentIndex >= size)
     {
       G4cout << __METHOD_NAME__ << "looping to start of bunch" << G4endl;
@@ -83,6 +106,84 @@ void BDSBunchSixTrackLink::ClearParticles()
   particles.clear();
 }
 
+void BDSBunchSixTrackLink::SetBatch(const BDSLinkBatchInput* batchIn)
+{
+  currentIndex = 0;
+  batch = batchIn;
+  batchSize = batch ? batch->n : 0;
+  batchInputTime = 0;
+}
+
+BDSParticleCoordsFull BDSBunchSixTrackLink::GetNextBatchParticle()
+{
+  if (currentIndex >= (G4int)batchSize)
+    {
+      G4cout << __METHOD_NAME__ << "looping to start of batch" << G4endl;
+      currentIndex = 0;
+    }
+
+  size_t i = (size_t)currentIndex;
+  currentIndex++;
+
+  G4double totalEnergy = batch->totalEnergy[i] * CLHEP::GeV;
+  currentParticleDefinition = BatchParticleDefinition(i, totalEnergy);
+  particleDefinitionHasBeenUpdated = true;
+
+  currentExternalParticleID = batch->id[i];
+  currentExternalParentID   = batch->parentID ? batch->parentID[i] : 0;
+
+  G4double xp = batch->xp[i];
+  G4double yp = batch->yp[i];
+  G4double zp = BDSBunch::CalculateZp(xp, yp, 1);
+  return BDSParticleCoordsFull(batch->x[i] * CLHEP::m,
+                               batch->y[i] * CLHEP::m,
+                               0,
+                               xp,
+                               yp,
+                               zp,
+                               batch->t[i] * CLHEP::s,
+                               0,
+                               totalEnergy,
+                               1);
+}
+
+BDSParticleDefinition* BDSBunchSixTrackLink::BatchParticleDefinition(size_t   i,
+                                                                     G4double totalEnergy)
+{
+  G4int pdgID = batch->pdgID[i];
+  G4int aIn   = batch->A      ? batch->A[i]      : 0;
+  G4int zIn   = batch->Z      ? batch->Z[i]      : 0;
+  G4int qIn   = batch->charge ? batch->charge[i] : 0;
+  auto key = std::make_tuple(pdgID, aIn, zIn, qIn);
+  auto search = batchParticleDefinitions.find(key);
+  if (search != batchParticleDefinitions.end())
+    {return search->second;}
+
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  G4ParticleDefinition* particleDef = particleTable->FindParticle(pdgID);
+  if (!particleDef) // ions are only made by the ion table when first asked for
+    {particleDef = particleTable->GetIonTable()->GetIon(pdgID);}
+  if (!particleDef)
+    {throw BDSException(__METHOD_NAME__, "particle with PDG ID \"" + std::to_string(pdgID) + "\" not found");}
+
+  BDSParticleDefinition* result = nullptr;
+  if (BDS::IsIon(particleDef))
+    {// as for individual particles, use the A, Z and charge if given, else assume fully stripped
+      G4int a = batch->A ? aIn : particleDef->GetAtomicMass();
+      G4int z = batch->Z ? zIn : particleDef->GetAtomicNumber();
+      G4int q = batch->charge ? qIn : z;
+      BDSIonDefinition ionDef(a, z, q * CLHEP::eplus);
+      result = new BDSParticleDefinition(particleDef, totalEnergy, 0, 0, 1, &ionDef);
+#if G4VERSION_NUMBER > 1049
+      BDS::FixGeant105ThreshholdsForParticle(particleDef);
+#endif
+    }
+  else
+    {result = new BDSParticleDefinition(particleDef, totalEnergy, 0, 0, 1);}
+  batchParticleDefinitions[key] = result;
+  return result;
+}
+
 void BDSBunchSixTrackLink::UpdateGeant4ParticleDefinition(G4int pdgID)
 {
   G4ParticleDefinition* newParticleDefinition = nullptr;
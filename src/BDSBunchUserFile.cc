@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSBunchUserFile.hh"
+#include "BDSBunchUserFileBinary.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSGlobalConstants.hh"
@@ -56,6 +57,9 @@ BDSBunchUserFile<T>::BDSBunchUserFile():
   anEnergyCoordinateInUse(false),
   changingParticleType(false),
   endOfFileReached(false),
+  binaryFile(false),
+  binaryInput(nullptr),
+  recordColumn(0),
   matchDistrFileLength(false)
 {
   ffact = BDSGlobalConstants::Instance()->FFact();
@@ -74,6 +78,7 @@ template<class T>
 BDSBunchUserFile<T>::~BDSBunchUserFile()
 {
   CloseBunchFile();
+  delete binaryInput;
 }
 
 template<class T>
@@ -86,6 +91,13 @@ void BDSBunchUserFile<T>::OpenBunchFile()
       printedOutFirstTime = true;
     }
   lineCounter = 0;
+  if (binaryFile)
+    {
+      if (!binaryInput)
+        {binaryInput = new BDSBunchUserFileBinary();}
+      binaryInput->OpenForReading(distrFilePath);
+      return;
+    }
   InputBunchFile.open(distrFilePath);
   if (!InputBunchFile.good())
     {throw BDSException("BDSBunchUserFile::OpenBunchFile>", "Cannot open bunch file " + distrFilePath);}
@@ -94,6 +106,8 @@ void BDSBunchUserFile<T>::OpenBunchFile()
 template<class T>
 void BDSBunchUserFile<T>::CloseBunchFile()
 {
+  if (binaryInput)
+    {binaryInput->Close();}
   InputBunchFile.clear(); // igzstream doesn't reset eof flags when closing - do manually
   InputBunchFile.close();
   endOfFileReached = true;
@@ -257,6 +271,8 @@ void BDSBunchUserFile<T>::skip(std::stringstream& ss, G4int nValues)
 template<class T>
 void BDSBunchUserFile<T>::SkipNLinesIgnoreIntoFile(G4bool usualPrintOut)
 {
+  if (binaryFile)
+    {return;} // only valid lines are stored in a binary file
   if (BDS::IsFinite(nlinesIgnore))
     {
       if (usualPrintOut)
@@ -284,6 +300,13 @@ void BDSBunchUserFile<T>::SkipNLinesSkip(G4bool usualPrintOut)
     {
       if (usualPrintOut)
         {G4cout << "BDSBunchUserFile> skipping " << nlinesSkip << " valid lines" << G4endl;}
+
+      if (binaryFile)
+        {
+          binaryInput->SeekRecord(nlinesSkip);
+          IncrementNEventsInFileSkipped((unsigned long long int)nlinesSkip);
+          return;
+        }
       
       // We can read into the file safely without checking eof() because we know from earlier
       // counting of the number of valid lines in the file that nlinesSkip is not beyond the
@@ -316,9 +339,34 @@ void BDSBunchUserFile<T>::SetOptions(const BDSParticleDefinition* beamParticle,
   nlinesIgnore  = (G4long)beam.nlinesIgnore;
   nlinesSkip    = (G4long)beam.nlinesSkip;
   matchDistrFileLength = beam.distrFileMatchLength;
+  binaryFile    = BDSBunchUserFileBinary::IsBinaryFile(distrFilePath);
+  if (binaryFile)
+    {CheckBinaryFileFormat();}
   ParseFileFormat();
 }
 
+template<class T>
+void BDSBunchUserFile<T>::CheckBinaryFileFormat()
+{
+  BDSBunchUserFileBinary header;
+  header.OpenForReading(distrFilePath);
+  G4String fileFormat = header.Format();
+  header.Close();
+  if (bunchFormat.empty())
+    {bunchFormat = fileFormat;}
+  else if (bunchFormat != fileFormat)
+    {
+      G4String msg = "distrFileFormat \"" + bunchFormat + "\" does not match the format \"" + fileFormat;
+      msg += "\" stored in the binary file \"" + distrFilePath + "\"";
+      throw BDSException("BDSBunchUserFile::CheckBinaryFileFormat>", msg);
+    }
+  if (BDS::IsFinite(nlinesIgnore))
+    {
+      BDS::Warning("BDSBunchUserFile> nlinesIgnore is not used for a binary file as only valid lines are stored");
+      nlinesIgnore = 0;
+    }
+}
+
 template<class T>
 G4bool BDSBunchUserFile<T>::SkippableLine(const std::string& line) const
 {
@@ -329,6 +377,19 @@ template<class T>
 G4long BDSBunchUserFile<T>::CountNLinesValidDataInFile()
 {
   OpenBunchFile();
+  if (binaryFile)
+    {
+      G4long nRecords = binaryInput->NRecords();
+      G4int  nColumns = binaryInput->NColumns();
+      CloseBunchFile();
+      if (nColumns < (G4int)fields.size())
+        {
+          G4String msg = "binary file \"" + distrFilePath + "\" has " + std::to_string(nColumns);
+          msg += " columns but " + std::to_string(fields.size()) + " are expected";
+          throw BDSException("BDSBunchUserFile::CountNLinesValidDataInFile>", msg);
+        }
+      return nRecords;
+    }
   SkipNLinesIgnoreIntoFile(false);
 
   std::string line;
@@ -462,6 +523,13 @@ void BDSBunchUserFile<T>::RecreateAdvanceToEvent(G4int eventOffset)
   // generator action in the start of the event after BeamOn(nEvents) has been called
   // therefore this adjustment for recreation + match is done earlier in this class
 
+  if (binaryFile)
+    {
+      binaryInput->SeekRecord(nlinesSkip + eventOffset);
+      lineCounter += eventOffset;
+      return;
+    }
+
   // we should now be completely safe to read into the file ignoring comment lines and
   // without checking eof()
   std::string line;
@@ -484,7 +552,7 @@ BDSParticleCoordsFullGlobal BDSBunchUserFile<T>::GetNextParticleValid(G4int /*ma
 template<class T>
 BDSParticleCoordsFull BDSBunchUserFile<T>::GetNextParticleLocal()
 {
-  if (InputBunchFile.eof() || InputBunchFile.fail())
+  if (!binaryFile && (InputBunchFile.eof() || InputBunchFile.fail()))
     {EndOfFileAction();}
 
   G4double E = 0, Ek = 0, P = 0, x = 0, y = 0, z = 0, xp = 0, yp = 0, zp = 0, t = 0;
@@ -497,51 +565,64 @@ BDSParticleCoordsFull BDSBunchUserFile<T>::GetNextParticleLocal()
   // flag whether we're going to update the particle definition
   G4bool updateParticleDefinition = false;
 
-  // read a whole line at a time for safety - no partially read lines
   std::string line;
-  std::getline(InputBunchFile, line);
-  lineCounter++;
-  
-  // skip empty lines and comment lines (starting with # or !)
-  G4bool lineIsBad = true;
-  while (lineIsBad)
+  if (binaryFile)
+    {// a record is always complete and valid so the line checks below aren't required
+      if (!binaryInput->ReadRecord(recordValues))
+        {
+          EndOfFileAction();
+          binaryInput->ReadRecord(recordValues);
+        }
+      lineCounter++;
+      recordColumn = 0;
+    }
+  else
     {
-      if (SkippableLine(line))
+      // read a whole line at a time for safety - no partially read lines
+      std::getline(InputBunchFile, line);
+      lineCounter++;
+  
+      // skip empty lines and comment lines (starting with # or !)
+      G4bool lineIsBad = true;
+      while (lineIsBad)
         {
-          if (InputBunchFile.eof() || InputBunchFile.fail())
-            {EndOfFileAction();}
-          else
+          if (SkippableLine(line))
             {
-              std::getline(InputBunchFile, line);
-              lineCounter++;
-              continue;
+              if (InputBunchFile.eof() || InputBunchFile.fail())
+                {EndOfFileAction();}
+              else
+                {
+                  std::getline(InputBunchFile, line);
+                  lineCounter++;
+                  continue;
+                }
             }
+          else
+            {lineIsBad = false;}
         }
-      else
-        {lineIsBad = false;}
-    }
   
-  // no check the line has the right number of 'words' in it ->
-  // split line on white space - doesn't inspect words themselves
-  // checks number of words, ie number of columns is correct
-  std::vector<std::string> results;
-  std::regex wspace("\\s+"); // any whitepsace
-  // -1 here makes it point to the suffix, ie the word rather than the wspace
-  std::sregex_token_iterator iter(line.begin(), line.end(), wspace, -1);
-  std::sregex_token_iterator end;
-  for (; iter != end; ++iter)
-    {
-      std::string res = (*iter).str();
-      results.push_back(res);
-    }
+      // no check the line has the right number of 'words' in it ->
+      // split line on white space - doesn't inspect words themselves
+      // checks number of words, ie number of columns is correct
+      std::vector<std::string> results;
+      std::regex wspace("\\s+"); // any whitepsace
+      // -1 here makes it point to the suffix, ie the word rather than the wspace
+      std::sregex_token_iterator iter(line.begin(), line.end(), wspace, -1);
+      std::sregex_token_iterator end;
+      for (; iter != end; ++iter)
+        {
+          std::string res = (*iter).str();
+          results.push_back(res);
+        }
   
-  if (results.size() < fields.size())
-    {// ensure enough columns
-      std::string message = "Invalid line at line " + std::to_string(lineCounter) +
-        ".  Expected " + std::to_string(fields.size()) +
-        " columns , but got " + std::to_string(results.size()) +
-        ".";
-      throw BDSException(__METHOD_NAME__, message);
+      if (results.size() < fields.size())
+        {// ensure enough columns
+          std::string message = "Invalid line at line " + std::to_string(lineCounter) +
+            ".  Expected " + std::to_string(fields.size()) +
+            " columns , but got " + std::to_string(results.size()) +
+            ".";
+          throw BDSException(__METHOD_NAME__, message);
+        }
     }
   
   std::stringstream ss(line);
@@ -646,7 +727,10 @@ template <class T>
 template <typename Type>
 void BDSBunchUserFile<T>::ReadValue(std::stringstream& stream, Type& value)
 {
-  stream >> value;
+  if (binaryFile)
+    {value = static_cast<Type>(recordValues[recordColumn++]);}
+  else
+    {stream >> value;}
 }
 
 template class BDSBunchUserFile<std::ifstream>;
@@ -0,0 +1,169 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBunchUserFileBinary.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+const uint32_t BDSBunchUserFileBinary::formatVersion = 1;
+const char BDSBunchUserFileBinary::magicNumber[8] = {'B','D','S','B','U','N','C','H'};
+
+BDSBunchUserFileBinary::BDSBunchUserFileBinary():
+  dataStart(0),
+  currentRecord(0),
+  writing(false)
+{
+  std::memset(&header, 0, sizeof(header));
+}
+
+BDSBunchUserFileBinary::~BDSBunchUserFileBinary()
+{
+  if (file.is_open())
+    {
+      try
+        {Close();}
+      catch (...)
+        {;} // ignore any exception as this is a destructor
+    }
+}
+
+G4bool BDSBunchUserFileBinary::IsBinaryFile(const G4String& fileNameIn)
+{
+  std::ifstream testFile(fileNameIn, std::ios::in | std::ios::binary);
+  if (!testFile.is_open())
+    {return false;}
+  char start[8] = {0};
+  testFile.read(start, sizeof(start));
+  G4bool result = testFile.gcount() == (std::streamsize)sizeof(start);
+  result = result && std::memcmp(start, magicNumber, sizeof(magicNumber)) == 0;
+  return result;
+}
+
+void BDSBunchUserFileBinary::Terminate(const G4String& message)
+{
+  file.close();
+  throw BDSException("BDSBunchUserFileBinary", message);
+}
+
+void BDSBunchUserFileBinary::OpenForReading(const G4String& fileNameIn)
+{
+  fileName = fileNameIn;
+  writing = false;
+  file.open(fileName, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    {throw BDSException(__METHOD_NAME__, "Cannot open bunch file \"" + fileName + "\"");}
+
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (file.gcount() != (std::streamsize)sizeof(header))
+    {Terminate("\"" + fileName + "\" is too short to contain a header");}
+  if (std::memcmp(header.magic, magicNumber, sizeof(magicNumber)) != 0)
+    {Terminate("\"" + fileName + "\" is not a binary BDSIM user bunch file");}
+  if (header.version != formatVersion)
+    {Terminate("unsupported format version " + std::to_string(header.version));}
+  if (header.nColumns < 1)
+    {Terminate("\"" + fileName + "\" has no columns");}
+
+  std::string formatRead(header.formatLength, ' ');
+  file.read(&formatRead[0], header.formatLength);
+  if (file.gcount() != (std::streamsize)header.formatLength)
+    {Terminate("\"" + fileName + "\" is too short to contain the column format");}
+  format = formatRead;
+  dataStart = (std::streamoff)(sizeof(header) + header.formatLength);
+
+  // check the file isn't truncated so any record can be sought to safely
+  file.seekg(0, std::ios::end);
+  std::streamoff expectedSize = dataStart + (std::streamoff)(header.nRecords * header.nColumns * sizeof(double));
+  if ((std::streamoff)file.tellg() < expectedSize)
+    {Terminate("\"" + fileName + "\" is shorter than the number of records in its header");}
+  SeekRecord(0);
+}
+
+void BDSBunchUserFileBinary::OpenForWriting(const G4String& fileNameIn,
+                                            const G4String& formatIn,
+                                            G4int           nColumns)
+{
+  if (nColumns < 1)
+    {throw BDSException(__METHOD_NAME__, "number of columns must be greater than 0");}
+  fileName = fileNameIn;
+  format   = formatIn;
+  writing  = true;
+  file.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    {throw BDSException(__METHOD_NAME__, "Cannot open \"" + fileName + "\" for writing");}
+
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, magicNumber, sizeof(magicNumber));
+  header.version      = formatVersion;
+  header.nColumns     = (uint32_t)nColumns;
+  header.formatLength = (uint32_t)format.size();
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(format.data(), (std::streamsize)format.size());
+  dataStart = (std::streamoff)(sizeof(header) + header.formatLength);
+  currentRecord = 0;
+}
+
+void BDSBunchUserFileBinary::WriteRecord(const std::vector<G4double>& values)
+{
+  if (values.size() != (std::size_t)header.nColumns)
+    {Terminate("record has " + std::to_string(values.size()) + " values but " + std::to_string(header.nColumns) + " columns are expected");}
+  file.write(reinterpret_cast<const char*>(values.data()), (std::streamsize)(values.size() * sizeof(double)));
+  header.nRecords++;
+}
+
+void BDSBunchUserFileBinary::SeekRecord(G4long index)
+{
+  if (index < 0 || index > NRecords())
+    {Terminate("record " + std::to_string(index) + " is outside the file of " + std::to_string(NRecords()) + " records");}
+  file.clear();
+  file.seekg(dataStart + (std::streamoff)(index * (G4long)header.nColumns * (G4long)sizeof(double)));
+  currentRecord = index;
+}
+
+G4bool BDSBunchUserFileBinary::ReadRecord(std::vector<G4double>& values)
+{
+  if (currentRecord >= NRecords())
+    {return false;}
+  values.resize(header.nColumns);
+  std::streamsize nBytes = (std::streamsize)(header.nColumns * sizeof(double));
+  file.read(reinterpret_cast<char*>(values.data()), nBytes);
+  if (file.gcount() != nBytes)
+    {Terminate("failed to read record " + std::to_string(currentRecord) + " from \"" + fileName + "\"");}
+  currentRecord++;
+  return true;
+}
+
+void BDSBunchUserFileBinary::Close()
+{
+  if (writing && file.is_open())
+    {
+      // the header is complete now the number of records is known
+      file.seekp(0);
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      writing = false;
+    }
+  file.close();
+}
@@ -64,7 +64,10 @@ BDSCollimator(nameIn, lengthIn, horizontalWidthIn, "jcol", collimatorMaterialIn,
   yHalfHeight(yHalfHeightIn),
   buildLeftJaw(buildLeftJawIn),
   buildRightJaw(buildRightJawIn),
-  buildAperture(true)
+  buildAperture(true),
+  leftJawPV(nullptr),
+  rightJawPV(nullptr),
+  vacuumPV(nullptr)
 {
   jawHalfWidth = 0.5 * (0.5*horizontalWidth - lengthSafetyLarge - xHalfGap);
 }
@@ -111,11 +114,7 @@ void BDSCollimatorJaw::CheckParameters()
       buildRightJaw = false;
     }
   
-  if (std::abs(jawTiltLeft) > 0 && std::tan(std::abs(jawTiltLeft)) * chordLength / 2. > std::max(xHalfGap, xSizeLeft))
-    {throw BDSException(__METHOD_NAME__, "tilted left jaw not allowed to cross the mid-plane: \"" + name + "\"");}
-
-  if (std::abs(jawTiltRight) > 0 && std::tan(std::abs(jawTiltRight)) * chordLength / 2. > std::max(xHalfGap, xSizeLeft))
-    {throw BDSException(__METHOD_NAME__, "tilted right jaw not allowed to cross the mid-plane: \"" + name + "\"");}
+  CheckJawTilts();
 
   if (!buildLeftJaw && !buildRightJaw)
     {throw BDSException(__METHOD_NAME__, "no jaws being built: \"" + name + "\"");}
@@ -124,37 +123,49 @@ void BDSCollimatorJaw::CheckParameters()
     {buildAperture = false;}
 }
 
-void BDSCollimatorJaw::BuildContainerLogicalVolume()
+void BDSCollimatorJaw::CheckJawTilts() const
+{
+  if (std::abs(jawTiltLeft) > 0 && std::tan(std::abs(jawTiltLeft)) * chordLength / 2. > std::max(xHalfGap, xSizeLeft))
+    {throw BDSException(__METHOD_NAME__, "tilted left jaw not allowed to cross the mid-plane: \"" + name + "\"");}
+
+  if (std::abs(jawTiltRight) > 0 && std::tan(std::abs(jawTiltRight)) * chordLength / 2. > std::max(xHalfGap, xSizeLeft))
+    {throw BDSException(__METHOD_NAME__, "tilted right jaw not allowed to cross the mid-plane: \"" + name + "\"");}
+}
+
+BDSExtent BDSCollimatorJaw::ContainerExtent(G4double jawTiltLeftIn,
+                                            G4double jawTiltRightIn) const
 {
   G4double horizontalHalfWidth = horizontalWidth * 0.5;
-  if (jawTiltLeft != 0 || jawTiltRight != 0)
+  if (jawTiltLeftIn != 0 || jawTiltRightIn != 0)
     {
       // The box must encompass everything, so pick the largest absolute angle
-      horizontalHalfWidth = horizontalWidth * 0.5 + chordLength * 0.5 * std::sin(std::max(std::abs(jawTiltLeft), std::abs(jawTiltRight)));
+      horizontalHalfWidth = horizontalWidth * 0.5 + chordLength * 0.5 * std::sin(std::max(std::abs(jawTiltLeftIn), std::abs(jawTiltRightIn)));
     }
-  
+  return BDSExtent(horizontalHalfWidth, yHalfHeight, chordLength*0.5);
+}
+
+void BDSCollimatorJaw::BuildContainerLogicalVolume()
+{
   // For the case of jaw tilt, adjust the horizontal size, but keep the container length the same
   // This results in small drifts either side of the collimator, but preserves the overall size
+  BDSExtent ext = ContainerExtent(jawTiltLeft, jawTiltRight);
   containerSolid = new G4Box(name + "_container_solid",
-                             horizontalHalfWidth,
+                             ext.MaximumX(),
                              yHalfHeight,
                              chordLength*0.5);
   
   containerLogicalVolume = new G4LogicalVolume(containerSolid,
                                                vacuumMaterial,
                                                name + "_container_lv");
-  BDSExtent ext(horizontalHalfWidth, yHalfHeight, chordLength*0.5);
   SetExtent(ext);
 }
 
-void BDSCollimatorJaw::Build()
+void BDSCollimatorJaw::JawHalfGaps(G4double& leftJawHalfGap,
+                                   G4double& rightJawHalfGap) const
 {
-  CheckParameters();
-  BDSAcceleratorComponent::Build(); // calls BuildContainer and sets limits and vis for container
-
   // set each jaws half gap default to aperture half size
-  G4double leftJawHalfGap = xHalfGap;
-  G4double rightJawHalfGap = xHalfGap;
+  leftJawHalfGap = xHalfGap;
+  rightJawHalfGap = xHalfGap;
 
   // update jaw half gap with offsets
   // if one jaw is not constructed, set the opening to xSize/2 for the aperture vacuum volume creation
@@ -173,11 +184,102 @@ void BDSCollimatorJaw::Build()
       else
         {rightJawHalfGap = 0.5 * horizontalWidth;}
     }
+}
+
+G4VSolid* BDSCollimatorJaw::BuildJawSolid(const G4String& jawName,
+                                          G4double        jawWidth,
+                                          G4double        jawTilt)
+{
+  G4VSolid* result = nullptr;
+  if (jawTilt != 0)
+    {
+      // Adjust the length of the parallelepiped to match the inside edges in Z
+      // Due to the straight parallelepiped edges, it will never match the volume an angled box,
+      // so it is chosen to underestimate the volume, but preserve the jaw x-y cutting plane.
+      G4double jawHalfLength = chordLength * 0.5 * std::cos(jawTilt);
+
+      result = new G4Para(name + "_" + jawName + "_solid",
+                          jawWidth * 0.5 - lengthSafety,
+                          yHalfHeight - lengthSafety,
+                          jawHalfLength - lengthSafety,
+                          0,
+                          jawTilt,
+                          0);
+    }
+  else
+    {
+      result = new G4Box(name + "_" + jawName + "_solid",
+                         jawWidth * 0.5 - lengthSafety,
+                         yHalfHeight - lengthSafety,
+                         chordLength * 0.5 - lengthSafety);
+    }
+  RegisterSolid(result);
+  return result;
+}
+
+G4VSolid* BDSCollimatorJaw::BuildVacuumSolid(G4double       leftJawHalfGap,
+                                             G4double       rightJawHalfGap,
+                                             G4ThreeVector& vacuumOffset)
+{
+  G4VSolid* result = nullptr;
+  if (jawTiltLeft != 0 || jawTiltRight != 0)
+    {
+      /// If the jaw is not built, do not take it's tilt into account for the vacuum box
+      G4double tiltLeft = buildLeftJaw ? jawTiltLeft : 0.;
+      G4double tiltRight = buildRightJaw ? jawTiltRight : 0.;
+
+      /// The vacuum volume should extend from edge to edge, but the tilted jaws themselves don't
+      /// Compute an effective length to correctly obtain the vacuum size at the edges
+      G4double halfLengthLeftEff = (chordLength  * 0.5) / std::cos(tiltLeft);
+      G4double halfLengthRightEff = (chordLength  * 0.5) / std::cos(tiltRight);
+
+      /// Rotate about y (from the z to the x axis) at x = 0 and translate
+      /// The right jaw is at a negative half-gap
+      G4double xGapLeftUpstream = -halfLengthLeftEff * std::sin(tiltLeft) + leftJawHalfGap;
+      G4double xGapLeftDownstream = halfLengthLeftEff * std::sin(tiltLeft) + leftJawHalfGap;
+      G4double xGapRightUpstream = -halfLengthRightEff * std::sin(tiltRight) - rightJawHalfGap;
+      G4double xGapRightDownstream = halfLengthRightEff * std::sin(tiltRight) - rightJawHalfGap;
+
+      std::vector<G4TwoVector> vertices {G4TwoVector(xGapRightUpstream + lengthSafety, -(yHalfHeight - lengthSafety)),
+                                         G4TwoVector(xGapRightUpstream + lengthSafety, (yHalfHeight - lengthSafety)),
+                                         G4TwoVector(xGapLeftUpstream - lengthSafety, (yHalfHeight - lengthSafety)),
+                                         G4TwoVector(xGapLeftUpstream - lengthSafety, -(yHalfHeight - lengthSafety)),
+                                         G4TwoVector(xGapRightDownstream + lengthSafety, -(yHalfHeight - lengthSafety)),
+                                         G4TwoVector(xGapRightDownstream + lengthSafety, (yHalfHeight - lengthSafety)),
+                                         G4TwoVector(xGapLeftDownstream - lengthSafety, (yHalfHeight - lengthSafety)),
+                                         G4TwoVector(xGapLeftDownstream - lengthSafety, -(yHalfHeight - lengthSafety))};
+
+      result = new G4GenericTrap(name + "_vacuum_solid",
+                                 chordLength * 0.5 - lengthSafety,
+                                 vertices);
+      // The for tilted jaws, the vacuum trapezoid is constructed from absolute coordinates
+      // need to rese the vacuum offset, which is intended for a box
+      vacuumOffset = G4ThreeVector(0, 0, 0);
+    }
+  else
+    {
+      G4double vacuumWidth = 0.5 * (leftJawHalfGap + rightJawHalfGap);
+      result = new G4Box(name + "_vacuum_solid",               // name
+                         vacuumWidth - lengthSafety,           // x half width
+                         yHalfHeight - lengthSafety,           // y half width
+                         chordLength * 0.5);                   // z half length
+    }
+  RegisterSolid(result);
+  return result;
+}
+
+void BDSCollimatorJaw::Build()
+{
+  CheckParameters();
+  BDSAcceleratorComponent::Build(); // calls BuildContainer and sets limits and vis for container
+
+  G4double leftJawHalfGap = 0;
+  G4double rightJawHalfGap = 0;
+  JawHalfGaps(leftJawHalfGap, rightJawHalfGap);
 
   // jaws have to fit inside containerLogicalVolume so calculate full jaw widths given offsets
   G4double leftJawWidth = 0.5 * horizontalWidth - leftJawHalfGap;
   G4double rightJawWidth = 0.5 * horizontalWidth - rightJawHalfGap;
-  G4double vacuumWidth = 0.5 * (leftJawHalfGap + rightJawHalfGap);
 
   // centre of jaw and vacuum volumes for placements
   G4double leftJawCentre = 0.5*leftJawWidth + leftJawHalfGap;
@@ -197,32 +299,7 @@ void BDSCollimatorJaw::Build()
   // build jaws as appropriate
   if (buildLeftJaw && buildAperture)
     {
-      G4VSolid* leftJawSolid = nullptr;
-      
-      if (jawTiltLeft != 0)
-        {
-          // Adjust the length of the parallelepiped to match the inside edges in Z
-          // Due to the straight parallelepiped edges, it will never match the volume an angled box,
-          // so it is chosen to underestimate the volume, but preserve the jaw x-y cutting plane.
-          G4double leftHalfLength = chordLength * 0.5 * std::cos(jawTiltLeft);
-          
-          leftJawSolid = new G4Para(name + "_leftjaw_solid",
-                                    leftJawWidth * 0.5 - lengthSafety,
-                                    yHalfHeight - lengthSafety,
-                                    leftHalfLength - lengthSafety,
-                                    0,
-                                    jawTiltLeft,
-                                    0);
-        }
-      else
-        {
-          leftJawSolid = new G4Box(name + "_leftjaw_solid",
-                                   leftJawWidth * 0.5 - lengthSafety,
-                                   yHalfHeight - lengthSafety,
-                                   chordLength * 0.5 - lengthSafety);
-        }
-      
-      RegisterSolid(leftJawSolid);
+      G4VSolid* leftJawSolid = BuildJawSolid("leftjaw", leftJawWidth, jawTiltLeft);
       
       G4LogicalVolume* leftJawLV = new G4LogicalVolume(leftJawSolid,       // solid
                                                        collimatorMaterial,    // material
@@ -240,44 +317,19 @@ void BDSCollimatorJaw::Build()
         {RegisterSensitiveVolume(leftJawLV, BDSSDType::collimatorcomplete);}
       
       // place the jaw
-      G4PVPlacement* leftJawPV = new G4PVPlacement(nullptr,              // rotation
-                                                   leftJawPos,              // position
-                                                   leftJawLV,               // its logical volume
-                                                   name + "_leftjaw_pv",    // its name
-                                                   containerLogicalVolume,  // its mother volume
-                                                   false,                            // no boolean operation
-                                                   0,                            // copy number
-                                                   checkOverlaps);
+      leftJawPV = new G4PVPlacement(nullptr,              // rotation
+                                    leftJawPos,              // position
+                                    leftJawLV,               // its logical volume
+                                    name + "_leftjaw_pv",    // its name
+                                    containerLogicalVolume,  // its mother volume
+                                    false,                            // no boolean operation
+                                    0,                            // copy number
+                                    checkOverlaps);
       RegisterPhysicalVolume(leftJawPV);
     }
   if (buildRightJaw && buildAperture)
     {
-      G4VSolid* rightJawSolid = nullptr;
-      
-      if (jawTiltRight != 0)
-        {
-          // Adjust the length of the parallelepiped to match the inside edges in Z
-          // Due to the straight parallelepiped edges, it will never match the volume an angled box,
-          // so it is chosen to underestimate the volume, but preserve the jaw x-y cutting plane.
-          G4double rightHalfLength = chordLength * 0.5 * std::cos(jawTiltRight);
-
-          rightJawSolid = new G4Para(name + "_rightjaw_solid",
-                                     rightJawWidth * 0.5 - lengthSafety,
-                                     yHalfHeight - lengthSafety,
-                                     rightHalfLength  - lengthSafety,
-                                     0,
-                                     jawTiltRight,
-                                     0);
-        }
-      else
-        {
-          rightJawSolid = new G4Box(name + "_rightjaw_solid",
-                                    rightJawWidth * 0.5 - lengthSafety,
-                                    yHalfHeight - lengthSafety,
-                                    chordLength * 0.5 - lengthSafety);
-        }
-
-      RegisterSolid(rightJawSolid);
+      G4VSolid* rightJawSolid = BuildJawSolid("rightjaw", rightJawWidth, jawTiltRight);
       
       G4LogicalVolume* rightJawLV = new G4LogicalVolume(rightJawSolid,      // solid
                                                         collimatorMaterial,     // material
@@ -295,14 +347,14 @@ void BDSCollimatorJaw::Build()
         {RegisterSensitiveVolume(rightJawLV, BDSSDType::collimatorcomplete);}
       
       // place the jaw
-      G4PVPlacement* rightJawPV = new G4PVPlacement(nullptr,             // rotation
-                                                    rightJawPos,             // position
-                                                    rightJawLV,              // its logical volume
-                                                    name + "_rightjaw_pv",   // its name
-                                                    containerLogicalVolume,  // its mother volume
-                                                    false,                           // no boolean operation
-                                                    0,                           // copy number
-                                                    checkOverlaps);
+      rightJawPV = new G4PVPlacement(nullptr,             // rotation
+                                     rightJawPos,             // position
+                                     rightJawLV,              // its logical volume
+                                     name + "_rightjaw_pv",   // its name
+                                     containerLogicalVolume,  // its mother volume
+                                     false,                           // no boolean operation
+                                     0,                           // copy number
+                                     checkOverlaps);
       RegisterPhysicalVolume(rightJawPV);
     }
   // if no aperture but the code has got to this stage, build the collimator as a simple box.
@@ -342,49 +394,7 @@ void BDSCollimatorJaw::Build()
   // build and place the vacuum volume only if the aperture is finite.
   if (buildAperture)
     {
-      if (jawTiltLeft != 0 || jawTiltRight != 0)
-        {
-          /// If the jaw is not built, do not take it's tilt into account for the vacuum box
-          G4double tiltLeft = buildLeftJaw ? jawTiltLeft : 0.;
-          G4double tiltRight = buildRightJaw ? jawTiltRight : 0.;
-          
-          /// The vacuum volume should extend from edge to edge, but the tilted jaws themselves don't
-          /// Compute an effective length to correctly obtain the vacuum size at the edges
-          G4double halfLengthLeftEff = (chordLength  * 0.5) / std::cos(tiltLeft);
-          G4double halfLengthRightEff = (chordLength  * 0.5) / std::cos(tiltRight);
-
-          /// Rotate about y (from the z to the x axis) at x = 0 and translate
-          /// The right jaw is at a negative half-gap
-          G4double xGapLeftUpstream = -halfLengthLeftEff * std::sin(tiltLeft) + leftJawHalfGap;
-          G4double xGapLeftDownstream = halfLengthLeftEff * std::sin(tiltLeft) + leftJawHalfGap;
-          G4double xGapRightUpstream = -halfLengthRightEff * std::sin(tiltRight) - rightJawHalfGap;
-          G4double xGapRightDownstream = halfLengthRightEff * std::sin(tiltRight) - rightJawHalfGap;
-
-          std::vector<G4TwoVector> vertices {G4TwoVector(xGapRightUpstream + lengthSafety, -(yHalfHeight - lengthSafety)),
-                                             G4TwoVector(xGapRightUpstream + lengthSafety, (yHalfHeight - lengthSafety)),
-                                             G4TwoVector(xGapLeftUpstream - lengthSafety, (yHalfHeight - lengthSafety)),
-                                             G4TwoVector(xGapLeftUpstream - lengthSafety, -(yHalfHeight - lengthSafety)),
-                                             G4TwoVector(xGapRightDownstream + lengthSafety, -(yHalfHeight - lengthSafety)),
-                                             G4TwoVector(xGapRightDownstream + lengthSafety, (yHalfHeight - lengthSafety)),
-                                             G4TwoVector(xGapLeftDownstream - lengthSafety, (yHalfHeight - lengthSafety)),
-                                             G4TwoVector(xGapLeftDownstream - lengthSafety, -(yHalfHeight - lengthSafety))};
-
-          vacuumSolid = new G4GenericTrap(name + "_vacuum_solid",
-                                          chordLength * 0.5 - lengthSafety,
-                                          vertices);
-          // The for tilted jaws, the vacuum trapezoid is constructed from absolute coordinates
-          // need to rese the vacuum offset, which is intended for a box
-          vacuumOffset = G4ThreeVector(0, 0, 0);
-        }
-      else
-        {
-          vacuumSolid = new G4Box(name + "_vacuum_solid",               // name
-                                  vacuumWidth - lengthSafety,           // x half width
-                                  yHalfHeight - lengthSafety,           // y half width
-                                  chordLength * 0.5);                   // z half length
-        }
-      
-      RegisterSolid(vacuumSolid);
+      vacuumSolid = BuildVacuumSolid(leftJawHalfGap, rightJawHalfGap, vacuumOffset);
       
       G4LogicalVolume* vacuumLV = new G4LogicalVolume(vacuumSolid,          // solid
                                                       vacuumMaterial,       // material
@@ -398,14 +408,97 @@ void BDSCollimatorJaw::Build()
       if (sensitiveVacuum)
         {RegisterSensitiveVolume(vacuumLV, BDSSDType::energydepvacuum);}
       
-      G4PVPlacement* vacPV = new G4PVPlacement(nullptr,                 // rotation
-                                               vacuumOffset,            // position
-                                               vacuumLV,                // its logical volume
-                                               name + "_vacuum_pv",     // its name
-                                               containerLogicalVolume,  // its mother  volume
-                                               false,                   // no boolean operation
-                                               0,                       // copy number
-                                               checkOverlaps);
-      RegisterPhysicalVolume(vacPV);
+      vacuumPV = new G4PVPlacement(nullptr,                 // rotation
+                                   vacuumOffset,            // position
+                                   vacuumLV,                // its logical volume
+                                   name + "_vacuum_pv",     // its name
+                                   containerLogicalVolume,  // its mother  volume
+                                   false,                   // no boolean operation
+                                   0,                       // copy number
+                                   checkOverlaps);
+      RegisterPhysicalVolume(vacuumPV);
+    }
+}
+
+void BDSCollimatorJaw::ReplaceSolid(G4LogicalVolume* lv,
+                                    G4VSolid*        newSolid)
+{
+  G4VSolid* oldSolid = lv->GetSolid();
+  lv->SetSolid(newSolid);
+  allSolids.erase(oldSolid);
+  delete oldSolid;
+}
+
+void BDSCollimatorJaw::UpdateJaws(G4double    xSizeLeftIn,
+                                  G4double    xSizeRightIn,
+                                  G4double    jawTiltLeftIn,
+                                  G4double    jawTiltRightIn,
+                                  G4Material* materialIn)
+{
+  if (!buildAperture || !vacuumPV)
+    {throw BDSException(__METHOD_NAME__, "jcol \"" + name + "\" was built without an aperture and its jaws cannot be updated");}
+  if (xSizeLeftIn < 0 || xSizeRightIn < 0)
+    {throw BDSException(__METHOD_NAME__, "jcol jaw cannot have negative half aperture size: \"" + name + "\"");}
+  if ((buildLeftJaw && xSizeLeftIn > 0.5*horizontalWidth) || (buildRightJaw && xSizeRightIn > 0.5*horizontalWidth))
+    {throw BDSException(__METHOD_NAME__, "jcol \"" + name + "\" jaw offset is greater than the element half width - a jaw cannot be removed in place");}
+
+  // keep the current values so the component is unchanged if the new ones are invalid
+  G4double xSizeLeftOld    = xSizeLeft;
+  G4double xSizeRightOld   = xSizeRight;
+  G4double jawTiltLeftOld  = jawTiltLeft;
+  G4double jawTiltRightOld = jawTiltRight;
+  // an unbuilt jaw keeps its offset so the vacuum volume is the same as when built
+  if (buildLeftJaw)
+    {xSizeLeft = xSizeLeftIn;}
+  if (buildRightJaw)
+    {xSizeRight = xSizeRightIn;}
+  jawTiltLeft  = jawTiltLeftIn;
+  jawTiltRight = jawTiltRightIn;
+  try
+    {CheckJawTilts();}
+  catch (const BDSException&)
+    {
+      xSizeLeft    = xSizeLeftOld;
+      xSizeRight   = xSizeRightOld;
+      jawTiltLeft  = jawTiltLeftOld;
+      jawTiltRight = jawTiltRightOld;
+      throw;
+    }
+
+  // the container may have to be wider for tilted jaws
+  BDSExtent ext = ContainerExtent(jawTiltLeft, jawTiltRight);
+  if (auto containerBox = dynamic_cast<G4Box*>(containerSolid))
+    {containerBox->SetXHalfLength(ext.MaximumX());}
+  SetExtent(ext);
+
+  G4double leftJawHalfGap = 0;
+  G4double rightJawHalfGap = 0;
+  JawHalfGaps(leftJawHalfGap, rightJawHalfGap);
+  G4double leftJawWidth = 0.5 * horizontalWidth - leftJawHalfGap;
+  G4double rightJawWidth = 0.5 * horizontalWidth - rightJawHalfGap;
+
+  if (leftJawPV)
+    {
+      G4LogicalVolume* leftJawLV = leftJawPV->GetLogicalVolume();
+      ReplaceSolid(leftJawLV, BuildJawSolid("leftjaw", leftJawWidth, jawTiltLeft));
+      leftJawPV->SetTranslation(G4ThreeVector(0.5*leftJawWidth + leftJawHalfGap, 0, 0));
+      if (materialIn)
+        {leftJawLV->SetMaterial(materialIn);}
+    }
+  if (rightJawPV)
+    {
+      G4LogicalVolume* rightJawLV = rightJawPV->GetLogicalVolume();
+      ReplaceSolid(rightJawLV, BuildJawSolid("rightjaw", rightJawWidth, jawTiltRight));
+      rightJawPV->SetTranslation(G4ThreeVector(-(0.5*rightJawWidth + rightJawHalfGap), 0, 0));
+      if (materialIn)
+        {rightJawLV->SetMaterial(materialIn);}
     }
-}
\ No newline at end of file
+  if (materialIn)
+    {collimatorMaterial = materialIn;}
+
+  G4ThreeVector vacuumOffset = G4ThreeVector(0.5*(leftJawHalfGap - rightJawHalfGap), 0, 0);
+  G4VSolid* newVacuumSolid = BuildVacuumSolid(leftJawHalfGap, rightJawHalfGap, vacuumOffset);
+  ReplaceSolid(vacuumPV->GetLogicalVolume(), newVacuumSolid);
+  vacuumSolid = newVacuumSolid;
+  vacuumPV->SetTranslation(vacuumOffset);
+}
@@ -1715,9 +1715,17 @@ BDSAcceleratorComponent* BDSComponentFactory::CreateCT()
   if (!HasSufficientMinimumLength(element))
     {return nullptr;}
   
+  G4String voxelMerging = BDS::LowerCase(G4String(element->dicomVoxelMerging));
+  if (voxelMerging.empty())
+    {voxelMerging = "none";}
+  if (voxelMerging != "none" && voxelMerging != "runlength")
+    {throw BDSException(__METHOD_NAME__, "unknown dicomVoxelMerging \"" + voxelMerging + "\" for element \"" + elementName + "\" - use \"none\" or \"runlength\"");}
+  
   BDSCT* result = new BDSCT(elementName,
 			    element->dicomDataPath,
-			    element->dicomDataFile);
+			    element->dicomDataFile,
+			    voxelMerging,
+			    element->dicomSkipEqualMaterials);
   new BDSDicomIntersectVolume(); // TBC
    
   return result;
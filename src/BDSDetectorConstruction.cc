@@ -64,6 +64,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSScorerMeshInfo.hh"
 #include "BDSScoringMeshBox.hh"
 #include "BDSScoringMeshCylinder.hh"
+#include "BDSScoringMeshVirtual.hh"
 #include "BDSSDEnergyDeposition.hh"
 #include "BDSSDManager.hh"
 #include "BDSSDType.hh"
@@ -76,6 +77,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "parser/blmplacement.h"
 #include "parser/element.h"
+#include "parser/expandedsequence.h"
 #include "parser/fastlist.h"
 #include "parser/options.h"
 #include "parser/physicsbiasing.h"
@@ -93,6 +95,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4VPrimitiveScorer.hh"
 #include "G4Region.hh"
 #include "G4ScoringManager.hh"
+#include "G4SDManager.hh"
 #include "G4String.hh"
 #include "G4Transform3D.hh"
 #include "G4Version.hh"
@@ -173,7 +176,7 @@ BDSDetectorConstruction::BDSDetectorConstruction(BDSComponentFactoryUser* userCo
 void BDSDetectorConstruction::UpdateSamplerDiameterAndCountSamplers()
 {
   nSamplers = 0;
-  auto beamline = BDSParser::Instance()->GetBeamline(); // main beam line
+  const auto& beamline = BDSParser::Instance()->GetBeamline(); // main beam line
   G4double maxBendingRatio = 1e-9;
   for (const auto& blElement : beamline)
     {
@@ -376,7 +379,7 @@ void BDSDetectorConstruction::BuildBeamlines()
     {
       if (placement.sequence.empty())
         {continue;} // no sequence specified -> just a placement
-      auto parserLine = BDSParser::Instance()->GetSequence(placement.sequence);
+      const auto& parserLine = BDSParser::Instance()->GetSequence(placement.sequence);
 
       // determine offset in world for extra beam line
       const BDSBeamline* mbl = mainBeamline.massWorld;
@@ -419,7 +422,7 @@ BDSSamplerInfo* BDSDetectorConstruction::BuildSamplerInfo(const GMAD::Element* e
   return result;
 }
 
-BDSBeamlineSet BDSDetectorConstruction::BuildBeamline(const GMAD::FastList<GMAD::Element>& beamLine,
+BDSBeamlineSet BDSDetectorConstruction::BuildBeamline(const GMAD::ExpandedSequence& beamLine,
                                                       const G4String&            name,
                                                       const BDSBeamlineIntegral& startingIntegral,
                                                       BDSBeamlineIntegral*&      integral,
@@ -435,7 +438,7 @@ BDSBeamlineSet BDSDetectorConstruction::BuildBeamline(const GMAD::FastList<GMAD:
     
   if (beamlineIsCircular)
     {
-      G4bool unsuitable = UnsuitableFirstElement(beamLine.begin());
+      G4bool unsuitable = UnsuitableFirstElement(beamLine);
       if (unsuitable)
         {
           G4cerr << "The first element in the beam line is unsuitable for a circular "
@@ -1312,11 +1315,14 @@ void BDSDetectorConstruction::ConstructSDandField()
   ConstructScoringMeshes();
 }
 
-G4bool BDSDetectorConstruction::UnsuitableFirstElement(GMAD::FastList<GMAD::Element>::FastListConstIterator element)
+G4bool BDSDetectorConstruction::UnsuitableFirstElement(const GMAD::ExpandedSequence& beamLine)
 {
   // skip past any line elements in parser to find first non-line element
-  while ((*element).type == GMAD::ElementType::_LINE)
+  auto element = beamLine.begin();
+  while (element != beamLine.end() && (*element).type == GMAD::ElementType::_LINE)
     {element++;}
+  if (element == beamLine.end())
+    {return false;}
   
   if ((*element).type == GMAD::ElementType::_RBEND)
     {return true;}  // unsuitable
@@ -1364,6 +1370,7 @@ void BDSDetectorConstruction::ConstructScoringMeshes()
 
       BDSScoringMeshBox* scorerBox = nullptr;
       BDSScoringMeshCylinder* scorerCylindrical = nullptr;
+      BDSScoringMeshVirtual* scorerVirtual = nullptr;
       const BDSHistBinMapper* mapper = nullptr;
 
       G4String geometryType = BDS::LowerCase(G4String(mesh.geometryType));
@@ -1378,9 +1385,14 @@ void BDSDetectorConstruction::ConstructScoringMeshes()
           scorerCylindrical = new BDSScoringMeshCylinder(meshName, meshRecipe, placement);
           mapper = scorerCylindrical->Mapper();
         }
+      else if (geometryType == "virtual")
+        {// a box filled without geometry from the stepping action
+          scorerVirtual = new BDSScoringMeshVirtual(meshName, meshRecipe, placement);
+          mapper = scorerVirtual->Mapper();
+        }
       else
         {
-          G4String msg = "mesh geometry type \"" + geometryType + "\" is not correct. The possible options are \"box\" and \"cylindrical\"";
+          G4String msg = "mesh geometry type \"" + geometryType + "\" is not correct. The possible options are \"box\", \"cylindrical\" and \"virtual\"";
           throw BDSException(__METHOD_NAME__, msg);
         }
 
@@ -1411,6 +1423,8 @@ void BDSDetectorConstruction::ConstructScoringMeshes()
             {scorerBox->SetPrimitiveScorer(ps);} 
           else if (geometryType == "cylindrical")
             {scorerCylindrical->SetPrimitiveScorer(ps);}
+          else
+            {scorerVirtual->AddScorer(ps, search->second.scorerType);}
           
           BDSScorerHistogramDef outputHistogram(meshRecipe, uniqueName, ps->GetName(), psUnit, *mapper);
           BDSAcceleratorModel::Instance()->RegisterScorerHistogramDefinition(outputHistogram);
@@ -1421,6 +1435,11 @@ void BDSDetectorConstruction::ConstructScoringMeshes()
         {scManager->RegisterScoringMesh(scorerBox);} // sets the current ps but appends to list of multiple
       else if (geometryType == "cylindrical")
         {scManager->RegisterScoringMesh(scorerCylindrical);}// sets the current ps but appends to list of multiple
+      else
+        {// the sd manager owns it and calls Initialize for each event to create the hits maps
+          G4SDManager::GetSDMpointer()->AddNewDetector(scorerVirtual);
+          BDSSDManager::Instance()->RegisterVirtualScoringMesh(scorerVirtual);
+        }
 
       // register it with the sd manager as this is where we get all collection IDs from
       // in the end of event action. This must come from the mesh as it creates the
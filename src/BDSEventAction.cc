@@ -47,6 +47,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSTrajectory.hh"
 #include "BDSTrajectoryFilter.hh"
 #include "BDSTrajectoryPointHit.hh"
+#include "BDSTrajectoryPointMemory.hh"
 #include "BDSTrajectoryPrimary.hh"
 #include "BDSUtilities.hh"
 #include "BDSWrapperMuonSplitting.hh"
@@ -222,6 +223,8 @@ void BDSEventAction::BeginOfEventAction(const G4Event* evt)
     }
   FireLaserCompton=true;
 
+  BDS::ResetTrajectoryPointBytesPeak();
+
   cpuStartTime = std::clock();
   // get the current time - last thing before we hand off to geant4
   startTime = time(nullptr);
@@ -267,6 +270,7 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
 
   G4double memoryUsedMb = BDS::GetMemoryUsage();
   eventInfo->SetMemoryUsage(memoryUsedMb);
+  eventInfo->SetTrajectoryPointsPeakMemory((G4double)BDS::trajectoryPointBytesPeak / (1024.*1024.));
 
   // cache if primary was absorbed in a collimator
   eventInfo->SetPrimaryAbsorbedInCollimator(primaryAbsorbedInCollimator);
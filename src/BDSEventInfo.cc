@@ -35,4 +35,5 @@ void BDSEventInfo::Print() const
   G4cout << "Start / stop time (ms): " << info->startTime << " " << info->stopTime << G4endl;
   G4cout << "Duration Wall (ms)    : " << info->durationWall << G4endl;
   G4cout << "Duration CPU  (ms)    : " << info->durationCPU  << G4endl;
+  G4cout << "Traj. points peak (MB): " << info->trajectoryPointsPeakMb << G4endl;
 }
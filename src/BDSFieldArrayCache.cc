@@ -0,0 +1,315 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray4DCoords.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSFieldArrayCache.hh"
+#include "BDSFieldValue.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+BDSFieldArrayCache* BDSFieldArrayCache::instance = nullptr;
+
+BDSFieldArrayCache* BDSFieldArrayCache::Instance()
+{
+  if (!instance)
+    {instance = new BDSFieldArrayCache();}
+  return instance;
+}
+
+BDSFieldArrayCache::BDSFieldArrayCache():
+  nHits(0),
+  nMisses(0),
+  nTransformedHits(0),
+  nTransformedMisses(0),
+  nReleased(0),
+  nEvicted(0),
+  peakMemory(0),
+  releaseCounter(0)
+{;}
+
+BDSFieldArrayCache::~BDSFieldArrayCache()
+{
+  ClearCachedArrays();
+  instance = nullptr;
+}
+
+void BDSFieldArrayCache::ReleaseIfCached(BDSArray4DCoords* array)
+{
+  if (instance)
+    {instance->Release(array);}
+}
+
+void BDSFieldArrayCache::ClearCachedArrays()
+{
+  // wrappers first as they refer to the arrays
+  for (auto& kv : wrappers)
+    {delete kv.first;}
+  wrappers.clear();
+  transformedArrays.clear();
+  for (auto& kv : arrays)
+    {delete kv.second.array;}
+  arrays.clear();
+  arrayKeys.clear();
+  coefficients.clear();
+}
+
+bool BDSFieldArrayCache::ArrayKey::operator<(const ArrayKey& other) const
+{
+  return std::tie(path, size, modificationTime, modificationTimeNS, nDimensions)
+    < std::tie(other.path, other.size, other.modificationTime, other.modificationTimeNS, other.nDimensions);
+}
+
+G4bool BDSFieldArrayCache::FileKey(const G4String& filePath,
+                                   G4int           nDimensions,
+                                   ArrayKey&       key)
+{
+  struct stat status;
+  if (stat(filePath.c_str(), &status) != 0)
+    {return false;}
+
+  char canonical[PATH_MAX];
+  key.path = realpath(filePath.c_str(), canonical) ? G4String(canonical) : filePath;
+  key.size = (long long)status.st_size;
+  key.modificationTime = status.st_mtime;
+#if defined(__APPLE__)
+  key.modificationTimeNS = (long)status.st_mtimespec.tv_nsec;
+#else
+  key.modificationTimeNS = (long)status.st_mtim.tv_nsec;
+#endif
+  key.nDimensions = nDimensions;
+  return true;
+}
+
+std::size_t BDSFieldArrayCache::ArrayMemory(const BDSArray4DCoords* array)
+{
+  if (!array)
+    {return 0;}
+  return (std::size_t)array->NX() * (std::size_t)array->NY() * (std::size_t)array->NZ()
+    * (std::size_t)array->NT() * sizeof(BDSFieldValue);
+}
+
+BDSArray4DCoords* BDSFieldArrayCache::FindCachedArray(const G4String& filePath,
+                                                      G4int           nDimensions)
+{
+  ArrayKey key;
+  // if the file can't be found let the loader report it
+  if (!FileKey(filePath, nDimensions, key))
+    {return nullptr;}
+  auto search = arrays.find(key);
+  if (search == arrays.end())
+    {
+      nMisses++;
+      return nullptr;
+    }
+  nHits++;
+  search->second.nReferences++;
+  return search->second.array;
+}
+
+void BDSFieldArrayCache::CacheArray(const G4String&   filePath,
+                                    G4int             nDimensions,
+                                    BDSArray4DCoords* array)
+{
+  ArrayKey key;
+  if (!FileKey(filePath, nDimensions, key))
+    {throw BDSException(__METHOD_NAME__, "unable to read the status of file \"" + filePath + "\"");}
+  auto search = arrays.find(key);
+  if (search != arrays.end())
+    {
+      if (array != search->second.array)
+        {throw BDSException(__METHOD_NAME__, "overwriting cache of field array with different array for file: " + filePath);}
+      return;
+    }
+  arrays[key] = {array, 1, 0};
+  arrayKeys[array] = key;
+
+  std::size_t totalMemory = 0;
+  for (const auto& kv : arrays)
+    {totalMemory += ArrayMemory(kv.second.array);}
+  peakMemory = std::max(peakMemory, totalMemory);
+}
+
+BDSArray4DCoords* BDSFieldArrayCache::FindCachedTransformedArray(BDSArray4DCoords*                array,
+                                                                 const BDSArrayReflectionTypeSet& reflections)
+{
+  auto search = transformedArrays.find(std::make_pair(array, reflections));
+  if (search == transformedArrays.end())
+    {
+      nTransformedMisses++;
+      return nullptr;
+    }
+  nTransformedHits++;
+  wrappers[search->second].nReferences++;
+  return search->second;
+}
+
+void BDSFieldArrayCache::CacheTransformedArray(BDSArray4DCoords*                array,
+                                               const BDSArrayReflectionTypeSet& reflections,
+                                               BDSArray4DCoords*                transformedArray)
+{
+  auto key = std::make_pair(array, reflections);
+  auto search = transformedArrays.find(key);
+  if (search != transformedArrays.end())
+    {
+      if (transformedArray != search->second)
+        {throw BDSException(__METHOD_NAME__, "overwriting cache of transformed field array with a different one");}
+      return;
+    }
+  transformedArrays[key] = transformedArray;
+  AdoptWrapper(array, transformedArray);
+}
+
+void BDSFieldArrayCache::AdoptWrapper(BDSArray4DCoords* array,
+                                      BDSArray4DCoords* wrapper)
+{
+  if (wrappers.find(wrapper) != wrappers.end())
+    {throw BDSException(__METHOD_NAME__, "wrapper of field array already held");}
+  wrappers[wrapper] = {array, 1};
+}
+
+void BDSFieldArrayCache::Release(BDSArray4DCoords* array)
+{
+  if (!array)
+    {return;}
+  
+  auto wrapper = wrappers.find(array);
+  if (wrapper != wrappers.end())
+    {
+      wrapper->second.nReferences--;
+      if (wrapper->second.nReferences > 0)
+        {return;}
+      BDSArray4DCoords* wrapped = wrapper->second.array;
+      for (auto it = transformedArrays.begin(); it != transformedArrays.end(); ++it)
+        {
+          if (it->second == array)
+            {transformedArrays.erase(it); break;}
+        }
+      wrappers.erase(wrapper);
+      delete array;
+      nReleased++;
+      Release(wrapped);
+      return;
+    }
+
+  auto keySearch = arrayKeys.find(array);
+  if (keySearch == arrayKeys.end())
+    {return;} // not one of ours
+  auto entry = arrays.find(keySearch->second);
+  if (entry->second.nReferences == 0)
+    {return;} // already unused
+  entry->second.nReferences--;
+  nReleased++;
+  // kept with its coefficients for reuse when unused
+  entry->second.lastReleased = ++releaseCounter;
+}
+
+void BDSFieldArrayCache::EvictUnusedArrays(std::size_t maxUnusedMemory)
+{
+  std::vector<std::pair<G4long, ArrayKey> > unused; // (when released, key)
+  std::size_t unusedMemory = 0;
+  for (const auto& kv : arrays)
+    {
+      if (kv.second.nReferences > 0)
+        {continue;}
+      unused.emplace_back(kv.second.lastReleased, kv.first);
+      unusedMemory += ArrayMemory(kv.second.array) + CoefficientMemory(kv.second.array);
+    }
+  std::sort(unused.begin(), unused.end(), [](const std::pair<G4long, ArrayKey>& a,
+                                             const std::pair<G4long, ArrayKey>& b){return a.first < b.first;});
+
+  for (const auto& lastAndKey : unused)
+    {
+      if (unusedMemory <= maxUnusedMemory)
+        {break;}
+      auto entry = arrays.find(lastAndKey.second);
+      BDSArray4DCoords* array = entry->second.array;
+      unusedMemory -= ArrayMemory(array) + CoefficientMemory(array);
+      coefficients.erase(array);
+      arrayKeys.erase(array);
+      arrays.erase(entry);
+      delete array;
+      nEvicted++;
+    }
+}
+
+std::size_t BDSFieldArrayCache::CoefficientMemory(const BDSArray4DCoords* array) const
+{
+  auto search = coefficients.find(array);
+  return search == coefficients.end() ? 0 : search->second->size() * sizeof(G4double);
+}
+
+std::shared_ptr<const std::vector<G4double> > BDSFieldArrayCache::FindCoefficients(const BDSArray4DCoords* array) const
+{
+  auto search = coefficients.find(array);
+  return search == coefficients.end() ? nullptr : search->second;
+}
+
+void BDSFieldArrayCache::CacheCoefficients(const BDSArray4DCoords*                              array,
+                                           const std::shared_ptr<const std::vector<G4double> >& table)
+{
+  if (arrayKeys.find(array) != arrayKeys.end())
+    {coefficients[array] = table;}
+}
+
+void BDSFieldArrayCache::PrintStatistics() const
+{
+  if (nHits + nMisses == 0)
+    {return;}
+  std::size_t totalMemory = 0;
+  std::size_t nUnused = 0;
+  G4int maxReferences = 0;
+  for (const auto& kv : arrays)
+    {
+      totalMemory  += ArrayMemory(kv.second.array);
+      maxReferences = std::max(maxReferences, kv.second.nReferences);
+      if (kv.second.nReferences == 0)
+        {nUnused++;}
+    }
+  const G4double mb = 1024.0*1024.0;
+  G4cout << "Field map array cache:" << G4endl;
+  G4cout << "  arrays held:           " << arrays.size() << " (" << totalMemory / mb << " MB, peak " << peakMemory / mb << " MB)" << G4endl;
+  G4cout << "  arrays held unused:    " << nUnused << G4endl;
+  if (!coefficients.empty())
+    {
+      std::size_t coefficientMemory = 0;
+      for (const auto& kv : coefficients)
+        {coefficientMemory += kv.second->size() * sizeof(G4double);}
+      G4cout << "  coefficient tables:    " << coefficients.size() << " (" << coefficientMemory / mb << " MB)" << G4endl;
+    }
+  G4cout << "  array (hits | misses): (" << nHits << " | " << nMisses << ")" << G4endl;
+  G4cout << "  transformed (hits | misses): (" << nTransformedHits << " | " << nTransformedMisses << ")" << G4endl;
+  G4cout << "  arrays and wrappers released: " << nReleased << G4endl;
+  G4cout << "  unused arrays evicted: " << nEvicted << G4endl;
+  G4cout << "  most users of one array: " << maxReferences << G4endl;
+}
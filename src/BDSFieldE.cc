@@ -23,6 +23,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
 
+#include <vector>
+
 BDSFieldE::BDSFieldE():
   finiteStrength(true),
   transform(G4Transform3D::Identity),
@@ -68,6 +70,49 @@ G4ThreeVector BDSFieldE::GetFieldTransformed(const G4ThreeVector& position,
     }
 }
 
+void BDSFieldE::GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+			      const std::vector<G4double>&      times,
+			      std::vector<G4ThreeVector>&       fields) const
+{
+  fields.resize(positions.size());
+  for (std::size_t i = 0; i < positions.size(); i++)
+    {fields[i] = GetField(positions[i], times[i]);}
+}
+
+void BDSFieldE::GetFieldTransformedBatch(const std::vector<G4ThreeVector>& positions,
+					 const std::vector<G4double>&      times,
+					 std::vector<G4ThreeVector>&       fields) const
+{
+  if (!finiteStrength)
+    {
+      fields.assign(positions.size(), G4ThreeVector()); // quicker than query
+      return;
+    }
+  else if (!transformIsNotIdentity && !modulator)
+    {
+      GetFieldBatch(positions, times, fields);
+      return;
+    }
+
+  const std::vector<G4ThreeVector>* localPositions = &positions;
+  std::vector<G4ThreeVector> transformedPositions;
+  if (transformIsNotIdentity)
+    {
+      transformedPositions.reserve(positions.size());
+      for (const auto& position : positions)
+	{transformedPositions.emplace_back(inverseTransform * (HepGeom::Point3D<G4double>)position);}
+      localPositions = &transformedPositions;
+    }
+  GetFieldBatch(*localPositions, times, fields);
+  for (std::size_t i = 0; i < fields.size(); i++)
+    {
+      if (modulator)
+	{fields[i] *= modulator->Factor((*localPositions)[i], times[i]);}
+      if (transformIsNotIdentity)
+	{fields[i] = transform * (HepGeom::Vector3D<G4double>)fields[i];}
+    }
+}
+
 void BDSFieldE::GetFieldValue(const G4double point[4],
 			      G4double* field) const
 {
@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Transform3D.hh"
 
 #include <utility>
+#include <vector>
 
 BDSFieldEM::BDSFieldEM():
   finiteStrength(true),
@@ -73,6 +74,65 @@ std::pair<G4ThreeVector,G4ThreeVector> BDSFieldEM::GetFieldTransformed(const G4T
     }
 }
 
+void BDSFieldEM::GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+			       const std::vector<G4double>&      times,
+			       std::vector<G4ThreeVector>&       bFields,
+			       std::vector<G4ThreeVector>&       eFields) const
+{
+  bFields.resize(positions.size());
+  eFields.resize(positions.size());
+  for (std::size_t i = 0; i < positions.size(); i++)
+    {
+      auto field = GetField(positions[i], times[i]);
+      bFields[i] = field.first;
+      eFields[i] = field.second;
+    }
+}
+
+void BDSFieldEM::GetFieldTransformedBatch(const std::vector<G4ThreeVector>& positions,
+					  const std::vector<G4double>&      times,
+					  std::vector<G4ThreeVector>&       bFields,
+					  std::vector<G4ThreeVector>&       eFields) const
+{
+  if (!finiteStrength)
+    {
+      bFields.assign(positions.size(), G4ThreeVector()); // quicker than query
+      eFields.assign(positions.size(), G4ThreeVector());
+      return;
+    }
+  else if (!transformIsNotIdentity && !modulator)
+    {
+      GetFieldBatch(positions, times, bFields, eFields);
+      return;
+    }
+
+  // as per GetFieldTransformed
+  const std::vector<G4ThreeVector>* localPositions = &positions;
+  std::vector<G4ThreeVector> transformedPositions;
+  if (transformIsNotIdentity)
+    {
+      transformedPositions.reserve(positions.size());
+      for (const auto& position : positions)
+	{transformedPositions.emplace_back(transform * (HepGeom::Point3D<G4double>)position);}
+      localPositions = &transformedPositions;
+    }
+  GetFieldBatch(*localPositions, times, bFields, eFields);
+  for (std::size_t i = 0; i < positions.size(); i++)
+    {
+      if (transformIsNotIdentity)
+	{
+	  bFields[i] = transform * (HepGeom::Vector3D<G4double>)bFields[i];
+	  eFields[i] = transform * (HepGeom::Vector3D<G4double>)eFields[i];
+	}
+      if (modulator)
+	{
+	  G4double factor = modulator->Factor(positions[i], times[i]);
+	  bFields[i] *= factor;
+	  eFields[i] *= factor;
+	}
+    }
+}
+
 void BDSFieldEM::GetFieldValue(const G4double point[4],
 			       G4double* field) const
 {
@@ -42,6 +42,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSArrayReflectionType.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
+#include "BDSFieldArrayCache.hh"
 #include "BDSFieldEInterpolated.hh"
 #include "BDSFieldEInterpolated1D.hh"
 #include "BDSFieldEInterpolated2D.hh"
@@ -56,6 +57,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldInfo.hh"
 #include "BDSFieldLoader.hh"
 #include "BDSFieldLoaderBDSIM.hh"
+#include "BDSFieldLoaderBDSIMBinary.hh"
 #include "BDSFieldLoaderPoisson.hh"
 #include "BDSFieldMagInterpolated.hh"
 #include "BDSFieldMagInterpolated1D.hh"
@@ -75,6 +77,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSInterpolator2DNearest.hh"
 #include "BDSInterpolator3D.hh"
 #include "BDSInterpolator3DCubic.hh"
+#include "BDSInterpolator3DCubicCoeff.hh"
 #include "BDSInterpolator3DLinear.hh"
 #include "BDSInterpolator3DLinearMag.hh"
 #include "BDSInterpolator3DNearest.hh"
@@ -115,20 +118,14 @@ BDSFieldLoader::BDSFieldLoader()
 
 BDSFieldLoader::~BDSFieldLoader()
 {
-  DeleteArrays();
+  // arrays are owned by BDSFieldArrayCache which may outlive this class and
+  // are released by the interpolators using them
   instance = nullptr;
 }
 
 void BDSFieldLoader::DeleteArrays()
 {
-  for (auto& a : arrays1d)
-    {delete a.second;}
-  for (auto& a : arrays2d)
-    {delete a.second;}
-  for (auto& a : arrays3d)
-    {delete a.second;}
-  for (auto& a : arrays4d)
-    {delete a.second;}
+  BDSFieldArrayCache::Instance()->ClearCachedArrays();
 }
 
 BDSFieldMagInterpolated* BDSFieldLoader::LoadMagField(const BDSFieldInfo&      info,
@@ -339,38 +336,22 @@ void BDSFieldLoader::EFilePathOK(const BDSFieldInfo& info)
 
 BDSArray1DCoords* BDSFieldLoader::Get1DCached(const G4String& filePath)
 {
-  auto result = arrays1d.find(filePath);
-  if (result != arrays1d.end())
-    {return result->second;}
-  else
-    {return nullptr;}
+  return static_cast<BDSArray1DCoords*>(BDSFieldArrayCache::Instance()->FindCachedArray(filePath, 1));
 }
 
 BDSArray2DCoords* BDSFieldLoader::Get2DCached(const G4String& filePath)
 {
-  auto result = arrays2d.find(filePath);
-  if (result != arrays2d.end())
-    {return result->second;}
-  else
-    {return nullptr;}
+  return static_cast<BDSArray2DCoords*>(BDSFieldArrayCache::Instance()->FindCachedArray(filePath, 2));
 }
 
 BDSArray3DCoords* BDSFieldLoader::Get3DCached(const G4String& filePath)
 {
-  auto result = arrays3d.find(filePath);
-  if (result != arrays3d.end())
-    {return result->second;}
-  else
-    {return nullptr;}
+  return static_cast<BDSArray3DCoords*>(BDSFieldArrayCache::Instance()->FindCachedArray(filePath, 3));
 }
 
 BDSArray4DCoords* BDSFieldLoader::Get4DCached(const G4String& filePath)
 {
-  auto result = arrays4d.find(filePath);
-  if (result != arrays4d.end())
-    {return result->second;}
-  else
-    {return nullptr;}
+  return static_cast<BDSArray4DCoords*>(BDSFieldArrayCache::Instance()->FindCachedArray(filePath, 4));
 }
 
 BDSArray2DCoords* BDSFieldLoader::LoadPoissonMag2D(const G4String& filePath)
@@ -394,7 +375,7 @@ BDSArray2DCoords* BDSFieldLoader::LoadPoissonMag2D(const G4String& filePath)
       BDSFieldLoaderPoisson<std::ifstream> loader;
       result = loader.LoadMag2D(filePath);
     }
-  arrays2d[filePath] = result;
+  BDSFieldArrayCache::Instance()->CacheArray(filePath, 2, result);
   return result;  
 }
 
@@ -407,7 +388,12 @@ BDSArray1DCoords* BDSFieldLoader::LoadBDSIM1D(const G4String& filePath)
   // Don't want to template this class and there's no base class pointer
   // for BDSFieldLoader so unfortunately, there's a wee bit of repetition.
   BDSArray1DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  if (BDSFieldLoaderBDSIMBinary::IsBinaryFile(filePath))
+    {
+      BDSFieldLoaderBDSIMBinary loader;
+      result = loader.Load1D(filePath);
+    }
+  else if (filePath.rfind("gz") != std::string::npos)
     {
 #ifdef USE_GZSTREAM
       BDSFieldLoaderBDSIM<igzstream> loader;
@@ -421,7 +407,7 @@ BDSArray1DCoords* BDSFieldLoader::LoadBDSIM1D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load1D(filePath);
     }
-  arrays1d[filePath] = result;
+  BDSFieldArrayCache::Instance()->CacheArray(filePath, 1, result);
   return result;
 }
 
@@ -432,7 +418,12 @@ BDSArray2DCoords* BDSFieldLoader::LoadBDSIM2D(const G4String& filePath)
     {return cached;}
   
   BDSArray2DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  if (BDSFieldLoaderBDSIMBinary::IsBinaryFile(filePath))
+    {
+      BDSFieldLoaderBDSIMBinary loader;
+      result = loader.Load2D(filePath);
+    }
+  else if (filePath.rfind("gz") != std::string::npos)
     {
 #ifdef USE_GZSTREAM
       BDSFieldLoaderBDSIM<igzstream> loader;
@@ -446,7 +437,7 @@ BDSArray2DCoords* BDSFieldLoader::LoadBDSIM2D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load2D(filePath);
     }
-  arrays2d[filePath] = result;
+  BDSFieldArrayCache::Instance()->CacheArray(filePath, 2, result);
   return result;
 }
 
@@ -457,7 +448,12 @@ BDSArray3DCoords* BDSFieldLoader::LoadBDSIM3D(const G4String& filePath)
     {return cached;}
 
   BDSArray3DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos )
+  if (BDSFieldLoaderBDSIMBinary::IsBinaryFile(filePath))
+    {
+      BDSFieldLoaderBDSIMBinary loader;
+      result = loader.Load3D(filePath);
+    }
+  else if (filePath.rfind("gz") != std::string::npos)
     {
 #ifdef USE_GZSTREAM
       BDSFieldLoaderBDSIM<igzstream> loader;
@@ -471,7 +467,7 @@ BDSArray3DCoords* BDSFieldLoader::LoadBDSIM3D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load3D(filePath);
 }
-  arrays3d[filePath] = result;
+  BDSFieldArrayCache::Instance()->CacheArray(filePath, 3, result);
   return result;
 }
 
@@ -482,7 +478,12 @@ BDSArray4DCoords* BDSFieldLoader::LoadBDSIM4D(const G4String& filePath)
     {return cached;}
 
   BDSArray4DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  if (BDSFieldLoaderBDSIMBinary::IsBinaryFile(filePath))
+    {
+      BDSFieldLoaderBDSIMBinary loader;
+      result = loader.Load4D(filePath);
+    }
+  else if (filePath.rfind("gz") != std::string::npos)
     {
 #ifdef USE_GZSTREAM
       BDSFieldLoaderBDSIM<igzstream> loader;
@@ -496,7 +497,7 @@ BDSArray4DCoords* BDSFieldLoader::LoadBDSIM4D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load4D(filePath);
     }
-  arrays4d[filePath] = result;
+  BDSFieldArrayCache::Instance()->CacheArray(filePath, 4, result);
   return result;
 }
 
@@ -554,6 +555,8 @@ BDSInterpolator3D* BDSFieldLoader::CreateInterpolator3D(BDSArray3DCoords*   arra
       {result = new BDSInterpolator3DLinearMag(array); break;}
     case BDSInterpolatorType::cubic3d:
       {result = new BDSInterpolator3DCubic(array); break;}
+    case BDSInterpolatorType::cubiccoeff3d:
+      {result = new BDSInterpolator3DCubicCoeff(array); break;}
     default:
       {throw BDSException(__METHOD_NAME__, "Invalid interpolator type for 3D field: " + interpolatorType.ToString()); break;}
     }
@@ -755,10 +758,19 @@ BDSArray1DCoords* BDSFieldLoader::CreateArrayReflected(BDSArray1DCoords* existin
   if (!NeedToProvideTransform(reflectionTypes))
     {return existingArray;}
   
+  BDSFieldArrayCache* cache = BDSFieldArrayCache::Instance();
+  BDSArray4DCoords* cached = cache->FindCachedTransformedArray(existingArray, *reflectionTypes);
+  if (cached)
+    {
+      cache->Release(existingArray); // the cached wrapper already holds a reference to it
+      return static_cast<BDSArray1DCoords*>(cached);
+    }
+
   BDSArrayOperatorIndex* indexOperator = nullptr;
   BDSArrayOperatorValue* valueOperator = nullptr;
   CreateOperators(reflectionTypes, existingArray, indexOperator, valueOperator);
   BDSArray1DCoords* result = new BDSArray1DCoordsTransformed(existingArray, indexOperator, valueOperator);
+  cache->CacheTransformedArray(existingArray, *reflectionTypes, result);
   return result;
 }
 
@@ -768,10 +780,19 @@ BDSArray2DCoords* BDSFieldLoader::CreateArrayReflected(BDSArray2DCoords* existin
   if (!NeedToProvideTransform(reflectionTypes))
     {return existingArray;}
 
+  BDSFieldArrayCache* cache = BDSFieldArrayCache::Instance();
+  BDSArray4DCoords* cached = cache->FindCachedTransformedArray(existingArray, *reflectionTypes);
+  if (cached)
+    {
+      cache->Release(existingArray); // the cached wrapper already holds a reference to it
+      return static_cast<BDSArray2DCoords*>(cached);
+    }
+
   BDSArrayOperatorIndex* indexOperator = nullptr;
   BDSArrayOperatorValue* valueOperator = nullptr;
   CreateOperators(reflectionTypes, existingArray, indexOperator, valueOperator);
   BDSArray2DCoords* result = new BDSArray2DCoordsTransformed(existingArray, indexOperator, valueOperator);
+  cache->CacheTransformedArray(existingArray, *reflectionTypes, result);
   return result;
 }
 
@@ -781,10 +802,19 @@ BDSArray3DCoords* BDSFieldLoader::CreateArrayReflected(BDSArray3DCoords* existin
   if (!NeedToProvideTransform(reflectionTypes))
     {return existingArray;}
 
+  BDSFieldArrayCache* cache = BDSFieldArrayCache::Instance();
+  BDSArray4DCoords* cached = cache->FindCachedTransformedArray(existingArray, *reflectionTypes);
+  if (cached)
+    {
+      cache->Release(existingArray); // the cached wrapper already holds a reference to it
+      return static_cast<BDSArray3DCoords*>(cached);
+    }
+
   BDSArrayOperatorIndex* indexOperator = nullptr;
   BDSArrayOperatorValue* valueOperator = nullptr;
   CreateOperators(reflectionTypes, existingArray, indexOperator, valueOperator);
   BDSArray3DCoords* result = new BDSArray3DCoordsTransformed(existingArray, indexOperator, valueOperator);
+  cache->CacheTransformedArray(existingArray, *reflectionTypes, result);
   return result;
 }
 
@@ -794,10 +824,19 @@ BDSArray4DCoords* BDSFieldLoader::CreateArrayReflected(BDSArray4DCoords* existin
   if (!NeedToProvideTransform(reflectionTypes))
     {return existingArray;}
 
+  BDSFieldArrayCache* cache = BDSFieldArrayCache::Instance();
+  BDSArray4DCoords* cached = cache->FindCachedTransformedArray(existingArray, *reflectionTypes);
+  if (cached)
+    {
+      cache->Release(existingArray); // the cached wrapper already holds a reference to it
+      return static_cast<BDSArray4DCoords*>(cached);
+    }
+
   BDSArrayOperatorIndex* indexOperator = nullptr;
   BDSArrayOperatorValue* valueOperator = nullptr;
   CreateOperators(reflectionTypes, existingArray, indexOperator, valueOperator);
   BDSArray4DCoords* result = new BDSArray4DCoordsTransformed(existingArray, indexOperator, valueOperator);
+  cache->CacheTransformedArray(existingArray, *reflectionTypes, result);
   return result;
 }
 
@@ -882,8 +921,12 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadPoissonSuperFishBQuad(const G4Strin
   BDSArray2DCoords* array = LoadPoissonMag2D(filePath);
   //BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   if (std::abs(array->XStep() - array->YStep()) > 1e-9)
-    {throw BDSException(__METHOD_NAME__, "asymmetric grid spacing for reflected quadrupole will result in a distorted field map - please regenerate the map with even spatial samples.");}
+    {
+      BDSFieldArrayCache::Instance()->Release(array);
+      throw BDSException(__METHOD_NAME__, "asymmetric grid spacing for reflected quadrupole will result in a distorted field map - please regenerate the map with even spatial samples.");
+    }
   BDSArray2DCoordsRQuad* rArray = new BDSArray2DCoordsRQuad(array);
+  BDSFieldArrayCache::Instance()->AdoptWrapper(array, rArray);
   BDSInterpolator2D*         ar = CreateInterpolator2D(rArray, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated2D(ar, transform, bScalingUnits);
   return result;
@@ -899,6 +942,7 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadPoissonSuperFishBDipole(const G4Str
   BDSArray2DCoords* array = LoadPoissonMag2D(filePath);
   //BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSArray2DCoordsRDipole* rArray = new BDSArray2DCoordsRDipole(array);
+  BDSFieldArrayCache::Instance()->AdoptWrapper(array, rArray);
   BDSInterpolator2D*           ar = CreateInterpolator2D(rArray, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated2D(ar, transform, bScalingUnits);
   return result;
@@ -0,0 +1,342 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray1DCoords.hh"
+#include "BDSArray2DCoords.hh"
+#include "BDSArray3DCoords.hh"
+#include "BDSArray4DCoords.hh"
+#include "BDSDebug.hh"
+#include "BDSDimensionType.hh"
+#include "BDSException.hh"
+#include "BDSFieldLoaderBDSIMBinary.hh"
+#include "BDSFieldValue.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  /// Field values used in place from a memory mapped file. The mapping is
+  /// private so a write to the array copies only that page.
+  class MappedFieldValues: public BDSArray4D::ExternalStorage
+  {
+  public:
+    MappedFieldValues(char* mappedDataIn, std::size_t mappedSizeIn, std::size_t offset):
+      BDSArray4D::ExternalStorage(reinterpret_cast<BDSFieldValue*>(mappedDataIn + offset)),
+      mappedData(mappedDataIn),
+      mappedSize(mappedSizeIn)
+    {;}
+    virtual ~MappedFieldValues(){munmap(mappedData, mappedSize);}
+  private:
+    char*       mappedData;
+    std::size_t mappedSize;
+  };
+}
+
+const uint32_t BDSFieldLoaderBDSIMBinary::formatVersion = 1;
+const char BDSFieldLoaderBDSIMBinary::magicNumber[8] = {'B','D','S','F','I','E','L','D'};
+
+BDSFieldLoaderBDSIMBinary::BDSFieldLoaderBDSIMBinary():
+  fileDescriptor(-1),
+  mappedData(nullptr),
+  mappedSize(0)
+{
+  std::memset(&header, 0, sizeof(header));
+}
+
+BDSFieldLoaderBDSIMBinary::~BDSFieldLoaderBDSIMBinary()
+{
+  UnmapFile();
+}
+
+G4bool BDSFieldLoaderBDSIMBinary::IsBinaryFile(const G4String& fileName)
+{
+  std::ifstream testFile(fileName, std::ios::in | std::ios::binary);
+  if (!testFile.is_open())
+    {return false;}
+  char start[8] = {0};
+  testFile.read(start, sizeof(start));
+  G4bool result = testFile.gcount() == (std::streamsize)sizeof(start);
+  result = result && std::memcmp(start, magicNumber, sizeof(magicNumber)) == 0;
+  return result;
+}
+
+void BDSFieldLoaderBDSIMBinary::Terminate(const G4String& message)
+{
+  UnmapFile();
+  throw BDSException("BDSFieldLoaderBDSIMBinary", message);
+}
+
+void BDSFieldLoaderBDSIMBinary::MapFile(const G4String& fileName)
+{
+  UnmapFile();
+  fileDescriptor = open(fileName.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+    {throw BDSException(__METHOD_NAME__, "Invalid file name or no such file named \"" + fileName + "\"");}
+  struct stat status;
+  if (fstat(fileDescriptor, &status) != 0)
+    {Terminate("unable to read the status of \"" + fileName + "\"");}
+  mappedSize = (std::size_t)status.st_size;
+  if (mappedSize == 0)
+    {Terminate("\"" + fileName + "\" is empty");}
+  void* data = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+  if (data == MAP_FAILED)
+    {Terminate("unable to map \"" + fileName + "\" into memory");}
+  mappedData = static_cast<char*>(data);
+}
+
+void BDSFieldLoaderBDSIMBinary::UnmapFile()
+{
+  if (mappedData)
+    {munmap(mappedData, mappedSize);}
+  mappedData = nullptr;
+  mappedSize = 0;
+  if (fileDescriptor >= 0)
+    {close(fileDescriptor);}
+  fileDescriptor = -1;
+}
+
+BDSArray4D::ExternalStorage* BDSFieldLoaderBDSIMBinary::ReleaseMapping()
+{
+  auto storage = new MappedFieldValues(mappedData, mappedSize, sizeof(header));
+  mappedData = nullptr;
+  mappedSize = 0;
+  UnmapFile(); // only closes the file - the mapping stays valid
+  return storage;
+}
+
+BDSArray1DCoords* BDSFieldLoaderBDSIMBinary::Load1D(const G4String& fileName)
+{
+  return static_cast<BDSArray1DCoords*>(Load(fileName, 1));
+}
+
+BDSArray2DCoords* BDSFieldLoaderBDSIMBinary::Load2D(const G4String& fileName)
+{
+  return static_cast<BDSArray2DCoords*>(Load(fileName, 2));
+}
+
+BDSArray3DCoords* BDSFieldLoaderBDSIMBinary::Load3D(const G4String& fileName)
+{
+  return static_cast<BDSArray3DCoords*>(Load(fileName, 3));
+}
+
+BDSArray4DCoords* BDSFieldLoaderBDSIMBinary::Load4D(const G4String& fileName)
+{
+  return Load(fileName, 4);
+}
+
+BDSArray4DCoords* BDSFieldLoaderBDSIMBinary::Load(const G4String& fileName,
+                                                  const G4int     nDim)
+{
+  G4String functionName = "BDSIM Binary Field Format> ";
+  MapFile(fileName);
+  G4cout << functionName << "Loading \"" << fileName << "\"" << G4endl;
+
+  if (mappedSize < sizeof(header))
+    {Terminate(functionName + "file too short to contain header");}
+  std::memcpy(&header, mappedData, sizeof(header));
+  if (std::memcmp(header.magic, magicNumber, sizeof(magicNumber)) != 0)
+    {Terminate(functionName + "\"" + fileName + "\" is not a binary BDSIM field map");}
+  if (header.version != formatVersion)
+    {Terminate(functionName + "unsupported format version " + std::to_string(header.version));}
+  if ((G4int)header.nDim != nDim)
+    {
+      G4String msg = functionName + "file contains a " + std::to_string(header.nDim) + "D field but a ";
+      msg += std::to_string(nDim) + "D field format was specified";
+      Terminate(msg);
+    }
+  for (G4int i = 0; i < 4; i++)
+    {
+      if (header.n[i] < 1)
+        {Terminate(functionName + "number of points in dimension must be greater than 0");}
+      if (header.dimensionType[i] < 0 || header.dimensionType[i] > 3)
+        {Terminate(functionName + "invalid dimension type " + std::to_string(header.dimensionType[i]));}
+    }
+  if (header.valueSize != sizeof(float) && header.valueSize != sizeof(double))
+    {Terminate(functionName + "invalid value size " + std::to_string(header.valueSize));}
+  std::size_t nValues = 3;
+  for (G4int i = 0; i < 4; i++)
+    {nValues *= (std::size_t)header.n[i];}
+  if (mappedSize < sizeof(header) + nValues*header.valueSize)
+    {Terminate(functionName + "unexpected end to file");}
+
+  BDSDimensionType dims[4];
+  for (G4int i = 0; i < 4; i++)
+    {dims[i] = BDSDimensionType(header.dimensionType[i]);}
+
+  // If the values are stored as BDSFieldValue the array uses the mapped file in place
+  // and keeps the mapping for its lifetime. Otherwise they're converted into the array.
+  static_assert(sizeof(BDSFieldValue) == 3*sizeof(FIELDTYPET), "BDSFieldValue must be 3 packed values");
+  static_assert(sizeof(Header) % alignof(BDSFieldValue) == 0, "values after the header must be aligned");
+  G4bool inPlace = header.valueSize == sizeof(FIELDTYPET);
+  BDSArray4D::ExternalStorage* storage = inPlace ? ReleaseMapping() : nullptr;
+
+  BDSArray4DCoords* result = nullptr;
+  switch (nDim)
+    {
+    case 1:
+      {
+        result = new BDSArray1DCoords(header.n[0], header.min[0], header.max[0], dims[0], storage);
+        break;
+      }
+    case 2:
+      {
+        result = new BDSArray2DCoords(header.n[0], header.n[1],
+                                      header.min[0], header.max[0],
+                                      header.min[1], header.max[1],
+                                      dims[0], dims[1], storage);
+        break;
+      }
+    case 3:
+      {
+        result = new BDSArray3DCoords(header.n[0], header.n[1], header.n[2],
+                                      header.min[0], header.max[0],
+                                      header.min[1], header.max[1],
+                                      header.min[2], header.max[2],
+                                      dims[0], dims[1], dims[2], storage);
+        break;
+      }
+    case 4:
+      {
+        result = new BDSArray4DCoords(header.n[0], header.n[1], header.n[2], header.n[3],
+                                      header.min[0], header.max[0],
+                                      header.min[1], header.max[1],
+                                      header.min[2], header.max[2],
+                                      header.min[3], header.max[3],
+                                      dims[0], dims[1], dims[2], dims[3], storage);
+        break;
+      }
+    default:
+      {delete storage; Terminate(functionName + "invalid number of dimensions"); break;}
+    }
+
+  if (!inPlace)
+    {
+      // the values are converted front to back only once
+      madvise(mappedData, mappedSize, MADV_SEQUENTIAL);
+      if (header.valueSize == sizeof(float))
+        {ReadValues<float>(result);}
+      else
+        {ReadValues<double>(result);}
+      UnmapFile();
+    }
+  G4cout << functionName << "Loaded " << header.n[0]*header.n[1]*header.n[2]*header.n[3]
+         << " field values from file" << G4endl;
+  return result;
+}
+
+template <typename T>
+void BDSFieldLoaderBDSIMBinary::ReadValues(BDSArray4DCoords* array)
+{
+  const G4int nX = array->NX();
+  const G4int nY = array->NY();
+  const G4int nZ = array->NZ();
+  const G4int nT = array->NT();
+  // the file is in the same order as the array so walk it once front to back
+  // copy rather than cast as the values in the file are not necessarily aligned
+  const char* values = mappedData + sizeof(header);
+  T v[3];
+  for (G4int l = 0; l < nT; l++)
+    {
+      for (G4int k = 0; k < nZ; k++)
+        {
+          for (G4int j = 0; j < nY; j++)
+            {
+              for (G4int i = 0; i < nX; i++)
+                {
+                  std::memcpy(v, values, sizeof(v));
+                  values += sizeof(v);
+                  (*array)(i, j, k, l) = BDSFieldValue((FIELDTYPET)v[0], (FIELDTYPET)v[1], (FIELDTYPET)v[2]);
+                }
+            }
+        }
+    }
+}
+
+void BDSFieldLoaderBDSIMBinary::Write(const BDSArray4DCoords* array,
+                                      G4int                   nDim,
+                                      const G4String&         fileName,
+                                      G4bool                  doublePrecision)
+{
+  if (!array)
+    {throw BDSException(__METHOD_NAME__, "no array to write");}
+  
+  std::ofstream outFile(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!outFile.is_open())
+    {throw BDSException(__METHOD_NAME__, "unable to open output file \"" + fileName + "\"");}
+
+  Header h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, magicNumber, sizeof(magicNumber));
+  h.version   = formatVersion;
+  h.nDim      = (uint32_t)nDim;
+  h.valueSize = doublePrecision ? (uint32_t)sizeof(double) : (uint32_t)sizeof(float);
+  h.dimensionType[0] = (int32_t)array->FirstDimension().underlying();
+  h.dimensionType[1] = (int32_t)array->SecondDimension().underlying();
+  h.dimensionType[2] = (int32_t)array->ThirdDimension().underlying();
+  h.dimensionType[3] = (int32_t)array->FourthDimension().underlying();
+  h.n[0] = array->NX();
+  h.n[1] = array->NY();
+  h.n[2] = array->NZ();
+  h.n[3] = array->NT();
+  h.min[0] = array->XMin(); h.max[0] = array->XMax();
+  h.min[1] = array->YMin(); h.max[1] = array->YMax();
+  h.min[2] = array->ZMin(); h.max[2] = array->ZMax();
+  h.min[3] = array->TMin(); h.max[3] = array->TMax();
+  outFile.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+  // always T,Z,Y,X order as per the array storage
+  for (G4int l = 0; l < h.n[3]; l++)
+    {
+      for (G4int k = 0; k < h.n[2]; k++)
+        {
+          for (G4int j = 0; j < h.n[1]; j++)
+            {
+              for (G4int i = 0; i < h.n[0]; i++)
+                {
+                  const BDSFieldValue& v = array->GetConst(i, j, k, l);
+                  if (doublePrecision)
+                    {
+                      double values[3] = {(double)v.x(), (double)v.y(), (double)v.z()};
+                      outFile.write(reinterpret_cast<const char*>(values), sizeof(values));
+                    }
+                  else
+                    {
+                      float values[3] = {(float)v.x(), (float)v.y(), (float)v.z()};
+                      outFile.write(reinterpret_cast<const char*>(values), sizeof(values));
+                    }
+                }
+            }
+        }
+    }
+  
+  if (!outFile.good())
+    {throw BDSException(__METHOD_NAME__, "error writing file \"" + fileName + "\"");}
+  outFile.close();
+}
@@ -23,7 +23,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 BDSFieldMag::BDSFieldMag():
   finiteStrength(true),
@@ -70,6 +72,61 @@ G4ThreeVector BDSFieldMag::GetFieldTransformed(const G4ThreeVector& position,
     }
 }
 
+void BDSFieldMag::GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+				const std::vector<G4double>&      times,
+				std::vector<G4ThreeVector>&       fields) const
+{
+  fields.resize(positions.size());
+  for (std::size_t i = 0; i < positions.size(); i++)
+    {fields[i] = GetField(positions[i], times[i]);}
+}
+
+void BDSFieldMag::GetFieldTransformedBatch(const std::vector<G4ThreeVector>& positions,
+					   const std::vector<G4double>&      times,
+					   std::vector<G4ThreeVector>&       fields) const
+{
+  if (!finiteStrength)
+    {
+      fields.assign(positions.size(), G4ThreeVector()); // quicker than query
+      return;
+    }
+
+  // as per GetFieldValue, an undefined time is taken as 0
+  const std::vector<G4double>* localTimes = &times;
+  std::vector<G4double> definedTimes;
+  auto isNaN = [](G4double t){return std::isnan(t);};
+  if (std::any_of(times.begin(), times.end(), isNaN))
+    {
+      definedTimes = times;
+      std::replace_if(definedTimes.begin(), definedTimes.end(), isNaN, 0.0);
+      localTimes = &definedTimes;
+    }
+  
+  if (!transformIsNotIdentity && !modulator)
+    {
+      GetFieldBatch(positions, *localTimes, fields);
+      return;
+    }
+
+  const std::vector<G4ThreeVector>* localPositions = &positions;
+  std::vector<G4ThreeVector> transformedPositions;
+  if (transformIsNotIdentity)
+    {
+      transformedPositions.reserve(positions.size());
+      for (const auto& position : positions)
+	{transformedPositions.emplace_back(inverseTransform * (HepGeom::Point3D<G4double>)position);}
+      localPositions = &transformedPositions;
+    }
+  GetFieldBatch(*localPositions, *localTimes, fields);
+  for (std::size_t i = 0; i < fields.size(); i++)
+    {
+      if (modulator)
+	{fields[i] *= modulator->Factor((*localPositions)[i], (*localTimes)[i]);}
+      if (transformIsNotIdentity)
+	{fields[i] = transform * (HepGeom::Vector3D<G4double>)fields[i];}
+    }
+}
+
 void BDSFieldMag::GetFieldValue(const G4double point[4],
 				G4double* field) const
 {
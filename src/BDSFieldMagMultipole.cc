@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSFieldMagMultipole.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSMultipoleRoutines.hh"
 #include "BDSUtilities.hh"
 
 #include "globals.hh"
@@ -62,56 +63,70 @@ BDSFieldMagMultipole::BDSFieldMagMultipole(BDSMagnetStrength const* strength,
   // class supports.
   if (std::abs(order) > (G4int)normalComponents.size())
     {order = (G4int)normalComponents.size();}
+
+  // In cylindrical coordinates, for each order n (n=2 for quadrupole) with r^(n-1) and
+  // the dipole coefficient sign convention (i.e. opposite sign), the field is
+  // Br  (normal) = -Bn/(n-1)! * r^(n-1) * sin(n*phi)
+  // Bphi(normal) = -Bn/(n-1)! * r^(n-1) * cos(n*phi)
+  // Br  (skew)   = +Bn/(n-1)! * r^(n-1) * cos(n*phi)
+  // Bphi(skew)   = -Bn/(n-1)! * r^(n-1) * sin(n*phi)
+  // Converted to cartesian this is By + iBx = (-Bn_normal + iBn_skew)/(n-1)! * (x+iy)^(n-1)
+  // so precompute the coefficients of this polynomial and use Horner's method.
+  coefficientsReal.assign(maximumNonZeroOrder + 1, 0);
+  coefficientsImag.assign(maximumNonZeroOrder + 1, 0);
+  G4double factorial = 1;
+  for (G4int i = 0; i < maximumNonZeroOrder; i++)
+    {
+      factorial *= (G4double)(i+1);
+      if (i < (G4int)normalComponents.size())
+	{coefficientsReal[i+1] = -normalComponents[i] / factorial;}
+      if (i < (G4int)skewComponents.size())
+	{coefficientsImag[i+1] = skewComponents[i] / factorial;}
+    }
 }
 
 G4ThreeVector BDSFieldMagMultipole::GetField(const G4ThreeVector &position,
 					     const G4double       /*t*/) const
 {
-  // Translate cartesian to polar coordinates
-  G4double r   = std::hypot(position.x(),position.y());
-  G4double phi = 0;
-  if (BDS::IsFiniteStrength(std::abs(r)))
-    {phi = atan2(position.y(),position.x());}
-
-  // compute B field in cylindrical coordinates first then convert to cartesian
-  // Bx = Br * cos(phi) - Bphi * sin(phi)
-  // By = Br * sin(phi) + Bphi * cos(phi)
-  // where, if n=1 is for dipole:
-  // Br  (n) (normal) = +Bn/(n-1)! * r^(n-1) * sin(n*phi)
-  // Bphi(n) (normal) = +Bn/(n-1)! * r^(n-1) * cos(n*phi)
-  // Br  (n) (skewed) = +Bn/(n-1)! * r^(n-1) * cos(n*phi)
-  // Bphi(n) (skewed) = -Bn/(n-1)! * r^(n-1) * sin(n*phi)
-  // cumulative variables for calculating the field
+  G4double by = 0;
+  G4double bx = 0;
+  BDS::ComplexHorner(coefficientsReal.data(), coefficientsImag.data(), (G4int)coefficientsReal.size(),
+		     position.x(), position.y(), by, bx);
+  return G4ThreeVector(bx, by, 0);
+}
 
-  G4double br = 0;
-  G4double bphi = 0;
-  // I want to use the strange convention of dipole coeff. with opposite sign -
-  // then it is the same sign as angle.
-  G4double ffact = -1;
-  for (G4int i = 0; i < maximumNonZeroOrder; i++)
+void BDSFieldMagMultipole::GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+					 const std::vector<G4double>&      /*times*/,
+					 std::vector<G4ThreeVector>&       fields) const
+{
+  const std::size_t nPoints = positions.size();
+  fields.resize(nPoints);
+  // structure of arrays so that each step of Horner's method is applied to all points
+  // in a simple inner loop the compiler can vectorise - same arithmetic as GetField
+  std::vector<G4double> x(nPoints);
+  std::vector<G4double> y(nPoints);
+  for (std::size_t i = 0; i < nPoints; i++)
     {
-      // Here we add to so order represents kn properly
-      G4double o = (G4double)i+2; // the current order
-      br   += normalComponents[i] * std::pow(r, o - 1) * std::sin(o * phi) / ffact; //normal
-      br   -= skewComponents[i]   * std::pow(r, o - 1) * std::cos(o * phi) / ffact; //skewed
-
-      bphi += normalComponents[i] * std::pow(r, o - 1) * std::cos(o * phi) / ffact; //normal
-      bphi += skewComponents[i]   * std::pow(r, o - 1) * std::sin(o * phi) / ffact; //skewed
-
-      // Ignore dipole component for now!
-      //if(o==1) // for the angle convention
-	  //{br *= -1; bphi *=-1; }
-
-      ffact *= o;
+      x[i] = positions[i].x();
+      y[i] = positions[i].y();
     }
-
-  G4ThreeVector cartesianField;
-  cartesianField[0] = (br * std::cos(phi) - bphi * std::sin(phi)); // B_x
-  cartesianField[1] = (br * std::sin(phi) + bphi * std::cos(phi)); // B_y
-  cartesianField[2] = 0;                                           // B_z
-
-  return cartesianField;
+  std::vector<G4double> re(nPoints, 0);
+  std::vector<G4double> im(nPoints, 0);
+  G4double* const reP = re.data();
+  G4double* const imP = im.data();
+  const G4double* const xP = x.data();
+  const G4double* const yP = y.data();
+  for (G4int m = (G4int)coefficientsReal.size() - 1; m >= 0; m--)
+    {
+      const G4double cReal = coefficientsReal[m];
+      const G4double cImag = coefficientsImag[m];
+      for (std::size_t i = 0; i < nPoints; i++)
+	{
+	  G4double reNew = reP[i]*xP[i] - imP[i]*yP[i] + cReal;
+	  imP[i] = reP[i]*yP[i] + imP[i]*xP[i] + cImag;
+	  reP[i] = reNew;
+	}
+    }
+  for (std::size_t i = 0; i < nPoints; i++)
+    {fields[i].set(im[i], re[i], 0);} // (Bx, By, Bz)
 }
-
-
-
@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSFieldMagDipole.hh"
 #include "BDSFieldMagMultipoleOuter.hh"
+#include "BDSMultipoleRoutines.hh"
 #include "BDSUtilities.hh"
 
 #include "globals.hh"
@@ -44,7 +45,11 @@ BDSFieldMagMultipoleOuter::BDSFieldMagMultipoleOuter(G4int              orderIn,
   poleNOffset(0),
   poleTipRadius(poleTipRadiusIn),
   maxField(1e100),
-  initialisationPhase(true)
+  initialisationPhase(true),
+  inverseAReal(0),
+  inverseAImag(0),
+  prefactorReal(0),
+  prefactorImag(0)
 {
   // index of which current to start at when summing - will in effect start us at + or - current
   // and therefore control the sign of the field.
@@ -81,6 +86,16 @@ BDSFieldMagMultipoleOuter::BDSFieldMagMultipoleOuter(G4int              orderIn,
       currents.push_back(c);
     }
 
+  // The currents are at c_k = R exp(i(phiOffset + k pi/N)) for k = 0..2N-1 with alternating
+  // sign s_k. Each contributes s_k i / conj(z - c_k), which summed over all currents is
+  // s_0 i (2N/a) u^(N-1) / (u^(2N) - 1) with u = conj(z)/a and a = R exp(-i phiOffset).
+  // Precompute 1/a and the prefactor s_0 i 2N/a.
+  G4double firstSign = (poleNOffset + 1) % 2 == 0 ? 1 : -1;
+  inverseAReal = std::cos(phiOffset) / poleTipRadius;
+  inverseAImag = std::sin(phiOffset) / poleTipRadius;
+  prefactorReal = -firstSign * (G4double)nPoles * inverseAImag;
+  prefactorImag =  firstSign * (G4double)nPoles * inverseAReal;
+
   // work out a radial extent close to a current source where we artificially saturate
   // do this based on the distance between two current sources
   G4TwoVector pointA(poleTipRadius, 0);
@@ -132,7 +147,50 @@ G4ThreeVector BDSFieldMagMultipoleOuter::GetField(const G4ThreeVector& position,
 						  const G4double       /*t*/) const
 {
   G4TwoVector pos(position.x(), position.y());
+  G4TwoVector result;
+  G4bool closeToPole = false;
+
+  if (std::abs(pos.mag() - poleTipRadius) > spatialLimit)
+    {// can't be close to any current source, so use the closed form of the sum
+      G4double uReal = pos.x()*inverseAReal + pos.y()*inverseAImag; // u = conj(z) / a
+      G4double uImag = pos.x()*inverseAImag - pos.y()*inverseAReal;
+      G4double pReal, pImag; // u^(N-1)
+      BDS::ComplexPower(uReal, uImag, order-1, pReal, pImag);
+      G4double uNReal = pReal*uReal - pImag*uImag;
+      G4double uNImag = pReal*uImag + pImag*uReal;
+      G4double qReal  = uNReal*uNReal - uNImag*uNImag - 1; // u^(2N) - 1
+      G4double qImag  = 2*uNReal*uNImag;
+      G4double qMag2  = qReal*qReal + qImag*qImag;
+      G4double fReal  = (pReal*qReal + pImag*qImag) / qMag2;
+      G4double fImag  = (pImag*qReal - pReal*qImag) / qMag2;
+      G4TwoVector val(prefactorReal*fReal - prefactorImag*fImag,
+		      prefactorReal*fImag + prefactorImag*fReal);
+      if (std::isfinite(val.x()) && std::isfinite(val.y())) // tolerate bad values
+	{result = val;}
+    }
+  else
+    {result = SumCurrents(pos, closeToPole);}
 
+  // get sign right to match convention
+  if (positiveField)
+    {result *= -1;}
+
+  // normalisation
+  result *= normalisation;
+
+  // limit to pole tip maximum
+  if (!initialisationPhase)
+    {
+      if ((result.mag() > maxField) || closeToPole)
+	{result = result.unit() * maxField;}
+    }
+  
+  return G4ThreeVector(result.x(), result.y(), 0);
+}
+
+G4TwoVector BDSFieldMagMultipoleOuter::SumCurrents(G4TwoVector pos,
+						   G4bool&     closeToPole) const
+{
   // temporary variables
   G4TwoVector result;
   G4TwoVector cToPos;
@@ -142,7 +200,6 @@ G4ThreeVector BDSFieldMagMultipoleOuter::GetField(const G4ThreeVector& position,
 
   // loop over linear sum from all infinite wire sources
   G4int pole = 1; // counter
-  G4bool closeToPole = false;
   for (const auto& c : currents)
     {
       cToPos    = pos - c; // distance to this wire
@@ -166,20 +223,5 @@ G4ThreeVector BDSFieldMagMultipoleOuter::GetField(const G4ThreeVector& position,
 	{result += val;}
       pole++;
     }
-
-  // get sign right to match convention
-  if (positiveField)
-    {result *= -1;}
-
-  // normalisation
-  result *= normalisation;
-
-  // limit to pole tip maximum
-  if (!initialisationPhase)
-    {
-      if ((result.mag() > maxField) || closeToPole)
-	{result = result.unit() * maxField;}
-    }
-  
-  return G4ThreeVector(result.x(), result.y(), 0);
+  return result;
 }
@@ -26,6 +26,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <vector>
+
 BDSFieldMagQuadrupole::BDSFieldMagQuadrupole(BDSMagnetStrength const* strength,
 					     G4double          const  brho)
 {
@@ -47,3 +49,15 @@ G4ThreeVector BDSFieldMagQuadrupole::GetField(const G4ThreeVector &position,
 
   return field;
 }
+
+void BDSFieldMagQuadrupole::GetFieldBatch(const std::vector<G4ThreeVector>& positions,
+					  const std::vector<G4double>&      /*times*/,
+					  std::vector<G4ThreeVector>&       fields) const
+{
+  fields.resize(positions.size());
+  for (std::size_t i = 0; i < positions.size(); i++)
+    {
+      const G4ThreeVector& position = positions[i];
+      fields[i].set(position.y() * bPrime, position.x() * bPrime, 0);
+    }
+}
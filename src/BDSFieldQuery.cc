@@ -36,6 +36,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <array>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -137,7 +138,6 @@ void BDSFieldQuery::QueryField(const BDSFieldQueryInfo* query)
     {tStep = 1.0;}
   CheckNStepsAndRange(query->tInfo, "t", query->name);
   
-  G4ThreeVector xyzGlobal = G4ThreeVector();
   const G4AffineTransform& localToGlobalTransform = query->globalTransform;
   G4AffineTransform globalToLocalTransform = localToGlobalTransform.Inverse();
   
@@ -146,8 +146,13 @@ void BDSFieldQuery::QueryField(const BDSFieldQueryInfo* query)
   
   OpenFiles(query);
   
-  G4double globalFieldValue[6];
   G4double localFieldValue[6];
+
+  // query one row in x at a time so the field can be evaluated for many points together
+  std::vector<G4ThreeVector> rowGlobal(query->xInfo.n);
+  std::vector<G4ThreeVector> rowLocal(query->xInfo.n);
+  std::vector<G4double> rowT(query->xInfo.n);
+  std::vector<std::array<G4double, 6> > rowFieldValues;
   
   G4double tLocal = tMin;
   for (G4int i = 0; i < query->tInfo.n; i++)
@@ -161,14 +166,18 @@ void BDSFieldQuery::QueryField(const BDSFieldQueryInfo* query)
               G4double xLocal = xMin;
               for (G4int l = 0; l < query->xInfo.n; l++)
                 {
-                  xyzGlobal = LocalToGlobalPoint(localToGlobalTransform, xLocal, yLocal, zLocal);
-                  GetFieldValue(xyzGlobal, generalUnitZ, tLocal, globalFieldValue);
+                  rowLocal[l] = G4ThreeVector(xLocal, yLocal, zLocal);
+                  rowGlobal[l] = LocalToGlobalPoint(localToGlobalTransform, xLocal, yLocal, zLocal);
+                  rowT[l] = tLocal;
+                  xLocal += xStep;
+                }
+              GetFieldValues(rowGlobal, generalUnitZ, rowT, rowFieldValues);
+              for (G4int l = 0; l < query->xInfo.n; l++)
+                {
                   GlobalToLocalAxisField(globalToLocalTransform,
-                                         globalFieldValue,
+                                         rowFieldValues[l].data(),
                                          localFieldValue);
-                  WriteFieldValue({xLocal, yLocal, zLocal}, tLocal, localFieldValue);
-                  
-                  xLocal += xStep;
+                  WriteFieldValue(rowLocal[l], tLocal, localFieldValue);
                 }
               yLocal += yStep;
             }
@@ -217,17 +226,20 @@ void BDSFieldQuery::QuerySpecificPoints(const BDSFieldQueryInfo* query)
   PrintBAndEInfo(query);
   
   OpenFiles(query);
-  G4ThreeVector xyz;
-  G4double t;
-  G4ThreeVector generalUnitZ(0,0,1);
-  G4double globalFieldValue[6];
+  std::vector<G4ThreeVector> xyz;
+  std::vector<G4double> t;
+  xyz.reserve(points.size());
+  t.reserve(points.size());
   for (auto const& xyzt : points)
     {
-      xyz = G4ThreeVector(xyzt.x(), xyzt.y(), xyzt.z());
-      t = xyzt.t();
-      GetFieldValue(xyz, generalUnitZ, t, globalFieldValue);
-      WriteFieldValue(xyz, t, globalFieldValue);
+      xyz.emplace_back(xyzt.x(), xyzt.y(), xyzt.z());
+      t.push_back(xyzt.t());
     }
+  G4ThreeVector generalUnitZ(0,0,1);
+  std::vector<std::array<G4double, 6> > globalFieldValues;
+  GetFieldValues(xyz, generalUnitZ, t, globalFieldValues);
+  for (std::size_t i = 0; i < xyz.size(); i++)
+    {WriteFieldValue(xyz[i], t[i], globalFieldValues[i].data());}
   CloseFiles();
   G4cout << "FieldQuery> Complete" << G4endl;
 }
@@ -381,6 +393,16 @@ void BDSFieldQuery::GetFieldValue(const G4ThreeVector& globalXYZ,
     }
 }
 
+void BDSFieldQuery::GetFieldValues(const std::vector<G4ThreeVector>&      globalXYZ,
+                                   const G4ThreeVector&                   globalDirection,
+                                   const std::vector<G4double>&           tGlobal,
+                                   std::vector<std::array<G4double, 6> >& fieldValues)
+{
+  fieldValues.resize(globalXYZ.size());
+  for (std::size_t i = 0; i < globalXYZ.size(); i++)
+    {GetFieldValue(globalXYZ[i], globalDirection, tGlobal[i], fieldValues[i].data());}
+}
+
 void BDSFieldQuery::WriteFieldValue(const G4ThreeVector& xyzLocal,
                                     G4double tLocal,
                                     const G4double fieldValue[6])
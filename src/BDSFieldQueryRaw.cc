@@ -16,6 +16,9 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSFieldE.hh"
+#include "BDSFieldEM.hh"
+#include "BDSFieldMag.hh"
 #include "BDSFieldQueryInfo.hh"
 #include "BDSFieldQueryRaw.hh"
 #include "BDSWarning.hh"
@@ -25,8 +28,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <array>
+#include <vector>
+
 BDSFieldQueryRaw::BDSFieldQueryRaw():
-  field(nullptr)
+  field(nullptr),
+  fieldMag(nullptr),
+  fieldE(nullptr),
+  fieldEM(nullptr)
 {;}
 
 BDSFieldQueryRaw::~BDSFieldQueryRaw()
@@ -36,6 +45,9 @@ void BDSFieldQueryRaw::QueryFieldRaw(G4Field* fieldIn,
 				     const BDSFieldQueryInfo* query)
 {
   field = fieldIn;
+  fieldMag = dynamic_cast<const BDSFieldMag*>(field);
+  fieldE   = dynamic_cast<const BDSFieldE*>(field);
+  fieldEM  = dynamic_cast<const BDSFieldEM*>(field);
   QueryField(query);
 }
 
@@ -52,6 +64,42 @@ void BDSFieldQueryRaw::GetFieldValue(const G4ThreeVector& globalXYZ,
   field->GetFieldValue(position, fieldValue);
 }
 
+void BDSFieldQueryRaw::GetFieldValues(const std::vector<G4ThreeVector>&      globalXYZ,
+				      const G4ThreeVector&                   globalDirection,
+				      const std::vector<G4double>&           tGlobal,
+				      std::vector<std::array<G4double, 6> >& fieldValues)
+{
+  if (!fieldMag && !fieldE && !fieldEM)
+    {
+      BDSFieldQuery::GetFieldValues(globalXYZ, globalDirection, tGlobal, fieldValues);
+      return;
+    }
+
+  const std::array<G4double, 6> zero = {{0, 0, 0, 0, 0, 0}};
+  fieldValues.assign(globalXYZ.size(), zero);
+  std::vector<G4ThreeVector> bFields;
+  std::vector<G4ThreeVector> eFields;
+  if (fieldMag)
+    {fieldMag->GetFieldTransformedBatch(globalXYZ, tGlobal, bFields);}
+  else if (fieldE)
+    {fieldE->GetFieldTransformedBatch(globalXYZ, tGlobal, eFields);}
+  else
+    {fieldEM->GetFieldTransformedBatch(globalXYZ, tGlobal, bFields, eFields);}
+
+  for (std::size_t i = 0; i < bFields.size(); i++)
+    {
+      fieldValues[i][0] = bFields[i].x();
+      fieldValues[i][1] = bFields[i].y();
+      fieldValues[i][2] = bFields[i].z();
+    }
+  for (std::size_t i = 0; i < eFields.size(); i++)
+    {
+      fieldValues[i][3] = eFields[i].x();
+      fieldValues[i][4] = eFields[i].y();
+      fieldValues[i][5] = eFields[i].z();
+    }
+}
+
 void BDSFieldQueryRaw::CheckIfFieldObjectSpecified(const BDSFieldQueryInfo* query) const
 {
   if (query->fieldObject.empty())
@@ -206,6 +206,12 @@ BDSGlobalConstants::BDSGlobalConstants(const GMAD::Options& opt):
       options.modelSplitLevel = 2;
     }
 
+  // compact sampler output is stored in columns (one branch per variable) unless a split level is given
+  if (options.storeSamplerCompact && !options.HasBeenSet("samplersSplitLevel"))
+    {options.samplersSplitLevel = 1;}
+  if (options.samplerSignificantBits < 0)
+    {throw BDSException(__METHOD_NAME__, "option \"samplerSignificantBits\" must be >= 0");}
+
 #if G4VERSION_NUMBER > 1079
   if (options.HasBeenSet("scintYieldFactor"))
     {BDS::Warning("The option \"scintYieldFactor\" has no effect with Geant4 11.0 onwards");}
@@ -41,6 +41,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "CLHEP/Units/SystemOfUnits.h"
 
 #include "BDSAcceleratorModel.hh"
+#include "BDSActionInitialization.hh"
 #include "BDSAperturePointsLoader.hh"
 #include "BDSBeamPipeFactory.hh"
 #include "BDSBunch.hh"
@@ -50,8 +51,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSComponentFactoryUser.hh"
 #include "BDSDebug.hh"
 #include "BDSDetectorConstruction.hh"
-#include "BDSEventAction.hh"
 #include "BDSException.hh"
+#include "BDSFieldArrayCache.hh"
 #include "BDSFieldFactory.hh"
 #include "BDSFieldLoader.hh"
 #include "BDSGeometryFactory.hh"
@@ -65,16 +66,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSParser.hh" // Parser
 #include "BDSParticleDefinition.hh"
 #include "BDSPhysicsUtilities.hh"
-#include "BDSPrimaryGeneratorAction.hh"
 #include "BDSRandom.hh" // for random number generator from CLHEP
-#include "BDSRunAction.hh"
 #include "BDSRunManager.hh"
 #include "BDSSamplerRegistry.hh"
 #include "BDSSDManager.hh"
-#include "BDSSteppingAction.hh"
-#include "BDSStackingAction.hh"
 #include "BDSTemporaryFiles.hh"
-#include "BDSTrackingAction.hh"
 #include "BDSUtilities.hh"
 #include "BDSVisManager.hh"
 #include "BDSWarning.hh"
@@ -287,44 +283,11 @@ int BDSIM::Initialise()
       G4cout << __METHOD_NAME__ << std::setw(12) << "Radial: "  << std::setw(7) << theGeometryTolerance->GetRadialTolerance()  << " mm"   << G4endl;
     }
   
-  /// Set user action classes
-  BDSEventAction* eventAction = new BDSEventAction(bdsOutput);
-  runManager->SetUserAction(eventAction);
-  
-  BDSRunAction* runAction = new BDSRunAction(bdsOutput,
-                                             bdsBunch,
-                                             bdsBunch->ParticleDefinition()->IsAnIon(),
-                                             eventAction,
-                                             globals->StoreTrajectorySamplerID());
-  runManager->SetUserAction(runAction);
-  
-  // Only add stepping action if it is actually used, so do check here (for performance reasons)
-  G4int verboseSteppingEventStart = globals->VerboseSteppingEventStart();
-  G4int verboseSteppingEventStop  = BDS::VerboseEventStop(verboseSteppingEventStart,
-                                                          globals->VerboseSteppingEventContinueFor());
-  if (globals->VerboseSteppingBDSIM())
-    {
-      runManager->SetUserAction(new BDSSteppingAction(true,
-                                                      verboseSteppingEventStart,
-                                                      verboseSteppingEventStop));
-    }
-  
-  runManager->SetUserAction(new BDSTrackingAction(globals->Batch(),
-                                                  globals->StoreTrajectory(),
-                                                  globals->StoreTrajectoryOptions(),
-                                                  eventAction,
-                                                  verboseSteppingEventStart,
-                                                  verboseSteppingEventStop,
-                                                  globals->VerboseSteppingPrimaryOnly(),
-                                                  globals->VerboseSteppingLevel()));
-
-  runManager->SetUserAction(new BDSStackingAction(globals));
-  
-  auto primaryGeneratorAction = new BDSPrimaryGeneratorAction(bdsBunch, parser->GetBeam(), globals->Batch());
-  // possibly updated after the primary generator as loaded a beam file
-  eventAction->SetPrintModulo(BDSGlobalConstants::Instance()->PrintModuloEvents());
-  runManager->SetUserAction(primaryGeneratorAction);
-  BDSFieldFactory::SetPrimaryGeneratorAction(primaryGeneratorAction);
+  /// Set user action classes. These are constructed by the action initialisation.
+  runManager->SetUserInitialization(new BDSActionInitialization(bdsOutput,
+                                                                bdsBunch,
+                                                                parser->GetBeam(),
+                                                                globals));
 
   /// Initialize G4 kernel
   runManager->Initialize();
@@ -440,6 +403,8 @@ BDSIM::~BDSIM()
         {
           delete BDSColours::Instance();
           delete BDSFieldLoader::Instance();
+          BDSFieldArrayCache::Instance()->PrintStatistics();
+          delete BDSFieldArrayCache::Instance();
           delete BDSSamplerRegistry::Instance();
           BDSAperturePointsCache::Instance()->ClearCachedFiles();
         }
@@ -25,6 +25,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4EventManager.hh" // Geant4 includes
 #include "G4GeometryManager.hh"
 #include "G4GeometryTolerance.hh"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
 #include "G4Version.hh"
 #include "G4VModularPhysicsList.hh"
 
@@ -40,6 +42,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSExecOptions.hh"
+#include "BDSFieldArrayCache.hh"
 #include "BDSFieldFactory.hh"
 #include "BDSFieldLoader.hh"
 #include "BDSGeometryFactory.hh"
@@ -69,6 +72,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSUtilities.hh"
 #include "BDSVisManager.hh"
 
+#include <chrono>
 #include <map>
 #include <set>
 
@@ -270,6 +274,7 @@ int BDSIMLink::Initialise(double minimumKineticEnergy,
     }
   /// Set user action classes
   runAction = new BDSLinkRunAction();
+  BDSSDManager::Instance()->SetLinkRunAction(runAction);
   BDSLinkEventAction* eventAction = new BDSLinkEventAction(bdsOutput, runAction, trackerDebug);
   runManager->SetUserAction(eventAction);
   runManager->SetUserAction(runAction);
@@ -392,6 +397,44 @@ void BDSIMLink::BeamOn(int nGenerate)
     } 
 }
 
+void BDSIMLink::TrackBatch(const BDSLinkBatchInput& input,
+                           BDSLinkBatchOutput&      output)
+{
+  auto tStart = std::chrono::steady_clock::now();
+  output.size         = 0;
+  output.nPrimaries   = 0;
+  output.nSecondaries = 0;
+  output.nNotStored   = 0;
+  output.timing       = BDSLinkBatchTiming();
+
+  auto bunch = dynamic_cast<BDSBunchSixTrackLink*>(bdsBunch);
+  if (!bunch)
+    {throw BDSException(__METHOD_NAME__, "batch tracking requires a BDSBunchSixTrackLink bunch");}
+  if (!runAction)
+    {throw BDSException(__METHOD_NAME__, "not initialised");}
+  if (input.n == 0)
+    {return;}
+  if (!input.x || !input.xp || !input.y || !input.yp || !input.t || !input.totalEnergy || !input.pdgID || !input.id)
+    {throw BDSException(__METHOD_NAME__, "all input arrays apart from parentID must be given");}
+
+  bunch->SetBatch(&input);
+  runAction->SetBatchOutput(&output);
+  auto tTrack = std::chrono::steady_clock::now();
+  BeamOn((int)input.n);
+  auto tEnd = std::chrono::steady_clock::now();
+  // the coordinates and particle definitions are made as each event starts
+  G4double batchInputTime = bunch->BatchInputTime();
+  bunch->SetBatch(nullptr);
+  runAction->SetBatchOutput(nullptr);
+
+  std::chrono::duration<double> setupDuration    = tTrack - tStart;
+  std::chrono::duration<double> trackingDuration = tEnd - tTrack;
+  std::chrono::duration<double> totalDuration    = tEnd - tStart;
+  output.timing.input    = setupDuration.count() + batchInputTime;
+  output.timing.tracking = trackingDuration.count() - batchInputTime - output.timing.output;
+  output.timing.total    = totalDuration.count();
+}
+
 BDSIMLink::~BDSIMLink()
 {
   /// Termination & clean up.
@@ -421,6 +464,8 @@ BDSIMLink::~BDSIMLink()
 	{
 	  delete BDSColours::Instance();
 	  delete BDSFieldLoader::Instance();
+	  // field arrays are purposively kept for reuse by a subsequent instance
+	  BDSFieldArrayCache::Instance()->PrintStatistics();
 	  //delete BDSSDManager::Instance();
 	  delete BDSSamplerRegistry::Instance();
     BDSAperturePointsCache::Instance()->ClearCachedFiles();
@@ -552,6 +597,51 @@ int BDSIMLink::AddLinkCollimatorJaw(const std::string& collimatorName,
   return (int)linkID;
 }
 
+void BDSIMLink::UpdateLinkCollimatorJaw(const std::string& collimatorName,
+                                        double halfApertureLeft,
+                                        double halfApertureRight,
+                                        double jawTiltLeft,
+                                        double jawTiltRight,
+                                        const std::string& materialName)
+{
+  G4VPhysicalVolume* placement = construction->LinkPlacement(collimatorName);
+  if (!placement)
+    {throw BDSException(__METHOD_NAME__, "no link element named \"" + collimatorName + "\"");}
+
+  // Only open and close the geometry for this element so the voxels of everything else
+  // are kept. We purposively don't tell the run manager the geometry has been modified
+  // as that would reoptimise the whole geometry. A new material only adds a material-cuts
+  // couple and the physics tables are built for that couple alone at the next run.
+  G4GeometryManager* gm = G4GeometryManager::GetInstance();
+  G4bool wasClosed = gm->IsGeometryClosed();
+  if (wasClosed)
+    {gm->OpenGeometry(placement);}
+  try
+    {
+      construction->UpdateLinkCollimatorJaw(collimatorName,
+					    halfApertureLeft,
+					    halfApertureRight,
+					    jawTiltLeft,
+					    jawTiltRight,
+					    materialName);
+    }
+  catch (const BDSException&)
+    {
+      if (wasClosed)
+	{gm->CloseGeometry(true, false, placement);}
+      throw;
+    }
+  
+  if (wasClosed)
+    {
+      G4bool bCloseGeometry = gm->CloseGeometry(true, false, placement);
+      if (!bCloseGeometry)
+	{throw BDSException(__METHOD_NAME__, "error - geometry not closed.");}
+    }
+  // the navigator may have cached the old volumes from the last step
+  G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->ResetStackAndState();
+}
+
 BDSHitsCollectionSamplerLink* BDSIMLink::SamplerHits() const
 {
   return runAction ? runAction->SamplerHits() : nullptr;
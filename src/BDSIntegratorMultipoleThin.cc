@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSIntegratorMultipoleThin.hh"
 #include "BDSMagnetStrength.hh"
+#include "BDSMultipoleRoutines.hh"
 #include "BDSStep.hh"
 #include "BDSUtilities.hh"
 
@@ -25,7 +26,6 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 
 #include <cmath>
-#include <list>
 #include <vector>
 #include <include/BDSGlobalConstants.hh>
 
@@ -45,18 +45,20 @@ BDSIntegratorMultipoleThin::BDSIntegratorMultipoleThin(BDSMagnetStrength const*
   std::vector<G4String> skewKeys = strength->SkewComponentKeys();
   std::vector<G4String>::iterator nkey = normKeys.begin();
   std::vector<G4String>::iterator skey = skewKeys.begin();
+  // coefficients of the polynomials in z = x + iy, i.e. kn / n! for the power n,
+  // so the kicks can be calculated with Horner's method - the 0th power is 0
+  normalCoefficients.push_back(0);
+  skewCoefficients.push_back(0);
+  G4bool finiteStrength = false;
   for (G4double i = 0; i < normKeys.size(); i++, ++nkey, ++skey)
     {
-      bnl.push_back((*strength)[*nkey] / (l*std::pow(CLHEP::m,i+1)));
-      bsl.push_back((*strength)[*skey] / (l*std::pow(CLHEP::m,i+1)));
-      nfact.push_back(Factorial(i));
+      G4double bnl = (*strength)[*nkey] / (l*std::pow(CLHEP::m,i+1));
+      G4double bsl = (*strength)[*skey] / (l*std::pow(CLHEP::m,i+1));
+      finiteStrength = finiteStrength || BDS::IsFiniteStrength(bnl) || BDS::IsFiniteStrength(bsl);
+      G4double nFactorial = (G4double)Factorial((G4int)i + 1);
+      normalCoefficients.push_back(std::isnan(bnl) ? 0 : bnl / nFactorial);
+      skewCoefficients.push_back(std::isnan(bsl) ? 0 : bsl / nFactorial);
     }
-
-  G4bool finiteStrength = false;
-  for (const auto& nl : bnl)
-    {finiteStrength = finiteStrength || BDS::IsFiniteStrength(nl);}
-  for (const auto& sl : bsl)
-    {finiteStrength = finiteStrength || BDS::IsFiniteStrength(sl);}
   zeroStrength = !finiteStrength;
 }
 
@@ -142,60 +144,18 @@ void BDSIntegratorMultipoleThin::OneStep(const G4ThreeVector& posIn,
   G4double zp1 = zp;
 
   // kicks come from pg 27 of mad-8 physical methods manual
-  G4complex kick(0,0);
-  G4complex position(x0, y0);
-  G4complex result(0,0);
-  // components of complex vector
-  G4double knReal = 0;
-  G4double knImag = 0;
-  G4double momx;
-  G4double momy;
-
   // normalise to momentum and charge
   G4double ratio = eqOfM->FCof() * std::abs(brho) / momIn;
 
-  G4int n = 1;
-  std::list<double>::const_iterator kn = bnl.begin();
-
-  // sum higher order components into one kick
-  for (; kn != bnl.end(); n++, ++kn)
-    {
-      momx = 0; //reset to zero
-      momy = 0;
-      knReal = (*kn) * ratio * std::pow(position,n).real() / nfact[n];
-      knImag = (*kn) * ratio * std::pow(position,n).imag() / nfact[n];
-      if (!std::isnan(knReal))
-    {momx = knReal;}
-      if (!std::isnan(knImag))
-    {momy = knImag;}
-      result = {momx,momy};
-      kick += result;
-    }
-
-  // reset n for skewed kicks.
-  n=1;
-  G4double ksReal = 0;
-  G4double ksImag = 0;
-  G4complex skewkick(0,0);
-
-  std::list<double>::const_iterator ks = bsl.begin();
-  for (; ks != bsl.end(); n++, ++ks)
-    {
-      if (BDS::IsFinite(*ks))
-        {
-          //reset to zero
-          momx = 0;
-          momy = 0;
-          ksReal = (*ks) * ratio * std::pow(position, n).real() / nfact[n];
-          ksImag = (*ks) * ratio * std::pow(position, n).imag() / nfact[n];
-          if (!std::isnan(ksReal))
-            {momx = ksReal;}
-          if (!std::isnan(ksImag))
-            {momy = ksImag;}
-          result = {momx,momy};
-          skewkick += result;
-        }
-    }
+  // sum of kn z^n / n! for normal and skew components
+  G4double kickReal = 0;
+  G4double kickImag = 0;
+  BDS::ComplexHorner(normalCoefficients.data(), (G4int)normalCoefficients.size(), x0, y0, kickReal, kickImag);
+  G4double skewReal = 0;
+  G4double skewImag = 0;
+  BDS::ComplexHorner(skewCoefficients.data(), (G4int)skewCoefficients.size(), x0, y0, skewReal, skewImag);
+  G4complex kick(ratio * kickReal, ratio * kickImag);
+  G4complex skewkick(ratio * skewReal, ratio * skewImag);
 
   // apply normal kick
   xp1 -= kick.real();
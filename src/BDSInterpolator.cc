@@ -0,0 +1,40 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray4DCoords.hh"
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSFieldArrayCache.hh"
+#include "BDSInterpolator.hh"
+
+#include <limits>
+
+BDSInterpolator::BDSInterpolator(BDSArray4DCoords* arrayIn):
+  smallestSpatialStep(std::numeric_limits<double>::max()),
+  arrayReference(arrayIn)
+{
+  if (arrayIn)
+    {smallestSpatialStep = arrayIn->SmallestSpatialStep();}
+  else
+    {throw BDSException(__METHOD_NAME__, "Invalid array to construct interpolator on.");}
+}
+
+BDSInterpolator::~BDSInterpolator()
+{
+  BDSFieldArrayCache::ReleaseIfCached(arrayReference);
+}
@@ -23,8 +23,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4Types.hh"
 
+#include <cmath>
+
 BDSInterpolator3DCubic::BDSInterpolator3DCubic(BDSArray3DCoords* arrayIn):
-  BDSInterpolator3D(arrayIn)
+  BDSInterpolator3D(arrayIn),
+  directAccess(arrayIn->DirectAccess())
 {;}
 
 BDSInterpolator3DCubic::~BDSInterpolator3DCubic()
@@ -34,6 +37,27 @@ BDSFieldValue BDSInterpolator3DCubic::GetInterpolatedValueT(G4double x,
                                                             G4double y,
                                                             G4double z) const
 {
+  if (directAccess)
+    {
+      G4double xArr = array->ArrayCoordsFromX(x);
+      G4double yArr = array->ArrayCoordsFromY(y);
+      G4double zArr = array->ArrayCoordsFromZ(z);
+      auto x1 = (G4int)std::floor(xArr);
+      auto y1 = (G4int)std::floor(yArr);
+      auto z1 = (G4int)std::floor(zArr);
+      G4int nX = array->NX();
+      G4int nY = array->NY();
+      // all 4x4x4 points must be inside the array, otherwise use the general
+      // method below that returns the default value for points outside
+      if (x1 >= 1 && x1 + 2 < nX && y1 >= 1 && y1 + 2 < nY && z1 >= 1 && z1 + 2 < array->NZ())
+        {
+          long strideY = (long)nX;
+          long strideZ = (long)nX * (long)nY;
+          const BDSFieldValue* origin = array->Data() + (z1-1)*strideZ + (y1-1)*strideY + (x1-1);
+          return BDS::Cubic3DContiguous(origin, strideY, strideZ, xArr - x1, yArr - y1, zArr - z1);
+        }
+    }
+  
   BDSFieldValue localData[4][4][4];
   G4double xFrac, yFrac, zFrac;
   array->ExtractSection4x4x4(x, y, z, localData, xFrac, yFrac, zFrac);
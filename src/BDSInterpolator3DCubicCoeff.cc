@@ -0,0 +1,215 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray3DCoords.hh"
+#include "BDSFieldArrayCache.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3DCubicCoeff.hh"
+#include "BDSInterpolatorRoutines.hh"
+
+#include "globals.hh"
+#include "G4Types.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  /// Catmull-Rom cubic in matrix form. Row is the power of the fractional coordinate
+  /// and column is the point index. This matches BDS::Cubic1D.
+  const G4double cubicMatrix[4][4] = {{ 0.0,  1.0,  0.0,  0.0},
+                                      {-0.5,  0.0,  0.5,  0.0},
+                                      { 1.0, -2.5,  2.0, -0.5},
+                                      {-0.5,  1.5, -1.5,  0.5}};
+}
+
+BDSInterpolator3DCubicCoeff::BDSInterpolator3DCubicCoeff(BDSArray3DCoords* arrayIn):
+  BDSInterpolator3D(arrayIn),
+  nCellsX(std::max(arrayIn->NX() - 1, 0)),
+  nCellsY(std::max(arrayIn->NY() - 1, 0)),
+  nCellsZ(std::max(arrayIn->NZ() - 1, 0))
+{
+  if (!array->DirectAccess())
+    {
+      G4cout << "BDSInterpolator3DCubicCoeff> array is transformed - no coefficients prepared, "
+             << "using regular cubic interpolation" << G4endl;
+      nCellsX = 0;
+      nCellsY = 0;
+      nCellsZ = 0;
+      return;
+    }
+  
+  BDSFieldArrayCache* cache = BDSFieldArrayCache::Instance();
+  coefficients = cache->FindCoefficients(array);
+  if (coefficients)
+    {
+      G4cout << "BDSInterpolator3DCubicCoeff> using coefficients already prepared for this array ("
+             << (G4double)CoefficientMemory() / (1024.*1024.) << " MB)" << G4endl;
+      return;
+    }
+  
+  auto start = std::chrono::high_resolution_clock::now();
+  coefficients = PrepareCoefficients();
+  cache->CacheCoefficients(array, coefficients);
+  auto stop = std::chrono::high_resolution_clock::now();
+  G4double duration = std::chrono::duration<G4double>(stop - start).count();
+  G4cout << "BDSInterpolator3DCubicCoeff> prepared coefficients for " << nCellsX*nCellsY*nCellsZ
+         << " cells in " << duration << " s using " << (G4double)CoefficientMemory() / (1024.*1024.)
+         << " MB (field map: " << (G4double)array->NX()*array->NY()*array->NZ()*sizeof(BDSFieldValue) / (1024.*1024.)
+         << " MB)" << G4endl;
+}
+
+BDSInterpolator3DCubicCoeff::~BDSInterpolator3DCubicCoeff()
+{;}
+
+std::shared_ptr<const std::vector<G4double> > BDSInterpolator3DCubicCoeff::PrepareCoefficients() const
+{
+  auto table = std::make_shared<std::vector<G4double> >((size_t)nCellsX * (size_t)nCellsY * (size_t)nCellsZ * 64 * 3);
+  G4double* cell = table->data();
+  // the coefficients are the separable product of the matrix along each dimension
+  // so apply it one dimension at a time
+  G4double p[4][4][4][3];
+  G4double a[4][4][4][3];
+  for (G4int k = 0; k < nCellsZ; k++)
+    {
+      for (G4int j = 0; j < nCellsY; j++)
+	{
+	  for (G4int i = 0; i < nCellsX; i++)
+	    {
+	      // same points as ExtractSection4x4x4 - default value outside the array
+	      for (G4int ix = 0; ix < 4; ix++)
+		{
+		  for (G4int iy = 0; iy < 4; iy++)
+		    {
+		      for (G4int iz = 0; iz < 4; iz++)
+			{
+			  const BDSFieldValue& v = array->GetConst(i-1+ix, j-1+iy, k-1+iz);
+			  p[ix][iy][iz][0] = v.x();
+			  p[ix][iy][iz][1] = v.y();
+			  p[ix][iy][iz][2] = v.z();
+			}
+		    }
+		}
+	      // x: a[power x][iy][iz]
+	      for (G4int px = 0; px < 4; px++)
+		{
+		  for (G4int iy = 0; iy < 4; iy++)
+		    {
+		      for (G4int iz = 0; iz < 4; iz++)
+			{
+			  for (G4int c = 0; c < 3; c++)
+			    {
+			      G4double s = 0;
+			      for (G4int ix = 0; ix < 4; ix++)
+				{s += cubicMatrix[px][ix] * p[ix][iy][iz][c];}
+			      a[px][iy][iz][c] = s;
+			    }
+			}
+		    }
+		}
+	      // y: p[power x][power y][iz]
+	      for (G4int px = 0; px < 4; px++)
+		{
+		  for (G4int py = 0; py < 4; py++)
+		    {
+		      for (G4int iz = 0; iz < 4; iz++)
+			{
+			  for (G4int c = 0; c < 3; c++)
+			    {
+			      G4double s = 0;
+			      for (G4int iy = 0; iy < 4; iy++)
+				{s += cubicMatrix[py][iy] * a[px][iy][iz][c];}
+			      p[px][py][iz][c] = s;
+			    }
+			}
+		    }
+		}
+	      // z: final coefficients
+	      for (G4int px = 0; px < 4; px++)
+		{
+		  for (G4int py = 0; py < 4; py++)
+		    {
+		      for (G4int pz = 0; pz < 4; pz++)
+			{
+			  G4double s[3] = {0, 0, 0};
+			  for (G4int iz = 0; iz < 4; iz++)
+			    {
+			      for (G4int c = 0; c < 3; c++)
+				{s[c] += cubicMatrix[pz][iz] * p[px][py][iz][c];}
+			    }
+			  G4double* coefficient = cell + ((pz*4 + py)*4 + px)*3;
+			  coefficient[0] = s[0];
+			  coefficient[1] = s[1];
+			  coefficient[2] = s[2];
+			}
+		    }
+		}
+	      cell += 64*3;
+	    }
+	}
+    }
+  return table;
+}
+
+BDSFieldValue BDSInterpolator3DCubicCoeff::GetInterpolatedValueT(G4double x,
+								 G4double y,
+								 G4double z) const
+{
+  G4double xArr = array->ArrayCoordsFromX(x);
+  G4double yArr = array->ArrayCoordsFromY(y);
+  G4double zArr = array->ArrayCoordsFromZ(z);
+  auto x1 = (G4int)std::floor(xArr);
+  auto y1 = (G4int)std::floor(yArr);
+  auto z1 = (G4int)std::floor(zArr);
+  if (x1 < 0 || x1 >= nCellsX || y1 < 0 || y1 >= nCellsY || z1 < 0 || z1 >= nCellsZ)
+    {// outside the prepared cells (or none prepared) - use the general method
+      BDSFieldValue localData[4][4][4];
+      G4double xFrac, yFrac, zFrac;
+      array->ExtractSection4x4x4(x, y, z, localData, xFrac, yFrac, zFrac);
+      return BDS::Cubic3D(localData, xFrac, yFrac, zFrac);
+    }
+
+  G4double xFrac = xArr - x1;
+  G4double yFrac = yArr - y1;
+  G4double zFrac = zArr - z1;
+  const G4double* cell = coefficients->data() + (((size_t)z1*nCellsY + y1)*nCellsX + x1)*64*3;
+
+  // Horner's method in x, then y, then z
+  G4double result[3] = {0, 0, 0};
+  for (G4int pz = 3; pz >= 0; pz--)
+    {
+      G4double sumY[3] = {0, 0, 0};
+      for (G4int py = 3; py >= 0; py--)
+	{
+	  const G4double* row = cell + (pz*4 + py)*4*3;
+	  G4double rx = ((row[9]*xFrac  + row[6])*xFrac + row[3])*xFrac + row[0];
+	  G4double ry = ((row[10]*xFrac + row[7])*xFrac + row[4])*xFrac + row[1];
+	  G4double rz = ((row[11]*xFrac + row[8])*xFrac + row[5])*xFrac + row[2];
+	  sumY[0] = sumY[0]*yFrac + rx;
+	  sumY[1] = sumY[1]*yFrac + ry;
+	  sumY[2] = sumY[2]*yFrac + rz;
+	}
+      result[0] = result[0]*zFrac + sumY[0];
+      result[1] = result[1]*zFrac + sumY[1];
+      result[2] = result[2]*zFrac + sumY[2];
+    }
+  return BDSFieldValue(result[0], result[1], result[2]);
+}
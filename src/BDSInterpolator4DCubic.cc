@@ -23,8 +23,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4Types.hh"
 
+#include <cmath>
+
 BDSInterpolator4DCubic::BDSInterpolator4DCubic(BDSArray4DCoords* arrayIn):
-  BDSInterpolator4D(arrayIn)
+  BDSInterpolator4D(arrayIn),
+  directAccess(arrayIn->DirectAccess())
 {;}
 
 BDSInterpolator4DCubic::~BDSInterpolator4DCubic()
@@ -35,6 +38,33 @@ BDSFieldValue BDSInterpolator4DCubic::GetInterpolatedValueT(G4double x,
 							    G4double z,
 							    G4double t) const
 {
+  if (directAccess)
+    {
+      G4double xArr = array->ArrayCoordsFromX(x);
+      G4double yArr = array->ArrayCoordsFromY(y);
+      G4double zArr = array->ArrayCoordsFromZ(z);
+      G4double tArr = array->ArrayCoordsFromT(t);
+      auto x1 = (G4int)std::floor(xArr);
+      auto y1 = (G4int)std::floor(yArr);
+      auto z1 = (G4int)std::floor(zArr);
+      auto t1 = (G4int)std::floor(tArr);
+      G4int nX = array->NX();
+      G4int nY = array->NY();
+      G4int nZ = array->NZ();
+      // all 4x4x4x4 points must be inside the array, otherwise use the general
+      // method below that returns the default value for points outside
+      if (x1 >= 1 && x1 + 2 < nX && y1 >= 1 && y1 + 2 < nY &&
+          z1 >= 1 && z1 + 2 < nZ && t1 >= 1 && t1 + 2 < array->NT())
+        {
+          long strideY = (long)nX;
+          long strideZ = (long)nX * (long)nY;
+          long strideT = strideZ * (long)nZ;
+          const BDSFieldValue* origin = array->Data() + (t1-1)*strideT + (z1-1)*strideZ + (y1-1)*strideY + (x1-1);
+          return BDS::Cubic4DContiguous(origin, strideY, strideZ, strideT,
+                                        xArr - x1, yArr - y1, zArr - z1, tArr - t1);
+        }
+    }
+  
   BDSFieldValue localData[4][4][4][4];
   G4double xFrac, yFrac, zFrac, tFrac;
   array->ExtractSection4x4x4x4(x, y, z, t, localData, xFrac, yFrac, zFrac, tFrac);
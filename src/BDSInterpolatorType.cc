@@ -51,7 +51,8 @@ std::map<BDSInterpolatorType, std::string>* BDSInterpolatorType::dictionary =
       {BDSInterpolatorType::cubic1d,    "cubic1d"},
       {BDSInterpolatorType::cubic2d,    "cubic2d"},
       {BDSInterpolatorType::cubic3d,    "cubic3d"},
-      {BDSInterpolatorType::cubic4d,    "cubic4d"}
+      {BDSInterpolatorType::cubic4d,    "cubic4d"},
+      {BDSInterpolatorType::cubiccoeff3d, "cubiccoeff3d"}
     });
 
 BDSInterpolatorType BDS::DetermineInterpolatorType(G4String interpolatorType)
@@ -77,6 +78,7 @@ BDSInterpolatorType BDS::DetermineInterpolatorType(G4String interpolatorType)
   types["cubic2d"]     = BDSInterpolatorType::cubic2d;
   types["cubic3d"]     = BDSInterpolatorType::cubic3d;
   types["cubic4d"]     = BDSInterpolatorType::cubic4d;
+  types["cubiccoeff3d"] = BDSInterpolatorType::cubiccoeff3d;
 
   interpolatorType = BDS::LowerCase(interpolatorType);
 
@@ -115,6 +117,7 @@ G4int BDS::NDimensionsOfInterpolatorType(const BDSInterpolatorType& it)
       case BDSInterpolatorType::linear3d:
       case BDSInterpolatorType::linearmag3d:
       case BDSInterpolatorType::cubic3d:
+      case BDSInterpolatorType::cubiccoeff3d:
 	{result = 3; break;}
       case BDSInterpolatorType::nearest4d:
       case BDSInterpolatorType::linear4d:	
@@ -58,6 +58,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ChannelingOptrMultiParticleChangeCrossSection.hh"
 #endif
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -95,7 +96,7 @@ G4VPhysicalVolume* BDSLinkDetectorConstruction::Construct()
   BDSGlobalConstants* globalConstants = BDSGlobalConstants::Instance();
 
   auto componentFactory = new BDSComponentFactory(nullptr, false);
-  auto beamline = BDSParser::Instance()->GetBeamline();
+  const auto& beamline = BDSParser::Instance()->GetBeamline();
 
   std::vector<BDSLinkOpaqueBox*> opaqueBoxes = {};
   linkBeamline = new BDSBeamline();
@@ -227,20 +228,7 @@ G4int BDSLinkDetectorConstruction::AddLinkCollimatorJaw(const std::string& colli
   if (isACrystal)
     {G4cout << "crystal name " << searchC->first << " " << searchC->second << G4endl;}
 
-  std::map<std::string, std::string> sixtrackToBDSIM =
-      {
-          {"CU", "Cu"},
-          {"W",  "W"},
-          {"C",  "G4_GRAPHITE_POROUS"},
-          {"Si", "Si"},
-          {"SI", "Si"}
-      };
-  std::string g4material;
-  auto search = sixtrackToBDSIM.find(materialName);
-  if (search != sixtrackToBDSIM.end())
-    {g4material = search->second;}
-  else
-    {g4material = materialName;}
+  std::string g4material = LinkMaterialName(materialName);
 
   // build component
   GMAD::Element el = GMAD::Element();
@@ -346,6 +334,59 @@ G4int BDSLinkDetectorConstruction::AddLinkCollimatorJaw(const std::string& colli
   return linkID;
 }
 
+std::string BDSLinkDetectorConstruction::LinkMaterialName(const std::string& materialName) const
+{
+  std::map<std::string, std::string> sixtrackToBDSIM =
+      {
+          {"CU", "Cu"},
+          {"W",  "W"},
+          {"C",  "G4_GRAPHITE_POROUS"},
+          {"Si", "Si"},
+          {"SI", "Si"}
+      };
+  auto search = sixtrackToBDSIM.find(materialName);
+  return search != sixtrackToBDSIM.end() ? search->second : materialName;
+}
+
+void BDSLinkDetectorConstruction::UpdateLinkCollimatorJaw(const std::string& collimatorName,
+                                                          G4double halfApertureLeft,
+                                                          G4double halfApertureRight,
+                                                          G4double jawTiltLeft,
+                                                          G4double jawTiltRight,
+                                                          const std::string& materialName)
+{
+  auto search = nameToElementIndex.find(collimatorName);
+  if (search == nameToElementIndex.end())
+    {throw BDSException(__METHOD_NAME__, "no link element named \"" + collimatorName + "\"");}
+  auto boxSearch = linkIDToOpaqueBox.find(search->second);
+  if (boxSearch == linkIDToOpaqueBox.end())
+    {throw BDSException(__METHOD_NAME__, "link element \"" + collimatorName + "\" has not been placed");}
+  BDSLinkOpaqueBox* opaqueBox = boxSearch->second;
+
+  auto jaw = dynamic_cast<BDSCollimatorJaw*>(opaqueBox->AcceleratorComponent());
+  if (!jaw) // e.g. a crystal or a drift that replaced an invalid collimator
+    {throw BDSException(__METHOD_NAME__, "link element \"" + collimatorName + "\" is not a jaw collimator");}
+
+  // the opaque box is kept as is so the world and its voxels are unaffected
+  if (!opaqueBox->Encompasses(jaw->ContainerExtent(jawTiltLeft, jawTiltRight)))
+    {throw BDSException(__METHOD_NAME__, "jaw tilts too large to update link element \"" + collimatorName + "\" in place");}
+
+  G4Material* material = nullptr;
+  if (!materialName.empty())
+    {material = BDSMaterials::Instance()->GetMaterial(LinkMaterialName(materialName));}
+
+  jaw->UpdateJaws(halfApertureLeft, halfApertureRight, jawTiltLeft, jawTiltRight, material);
+}
+
+G4VPhysicalVolume* BDSLinkDetectorConstruction::LinkPlacement(const std::string& elementName) const
+{
+  auto search = nameToElementIndex.find(elementName);
+  if (search == nameToElementIndex.end())
+    {return nullptr;}
+  auto pvSearch = linkIDToPlacement.find(search->second);
+  return pvSearch != linkIDToPlacement.end() ? pvSearch->second : nullptr;
+}
+
 void BDSLinkDetectorConstruction::UpdateWorldSolid()
 {
   BDSExtentGlobal we = linkBeamline->GetExtentGlobal();
@@ -386,6 +427,9 @@ G4int BDSLinkDetectorConstruction::PlaceOneComponent(const BDSBeamlineElement* e
   G4Transform3D elCentreToStart = el->TransformToStart();
   G4Transform3D globalToStart = elCentreToStart * (*placementTransform);
   G4int linkID = linkRegistry->Register(el, globalToStart);
+  linkIDToOpaqueBox[linkID] = el;
+  if (!pvs.empty())
+    {linkIDToPlacement[linkID] = *pvs.begin();}
   
   G4ThreeVector zOffset = G4ThreeVector(0,0,BDSGlobalConstants::Instance()->LengthSafety()+BDSSamplerPlane::ChordLength());
   G4Transform3D samplerPosition = globalToStart * G4Transform3D(G4RotationMatrix(), globalToStart.getRotation()*zOffset);
@@ -57,6 +57,9 @@ BDSLinkOpaqueBox::BDSLinkOpaqueBox(BDSAcceleratorComponent* acceleratorComponent
   BDSGeometryComponent(nullptr, nullptr),
   component(acceleratorComponentIn),
   outputSamplerRadius(outputSamplerRadiusIn),
+  tiltOffset(*tiltOffsetIn),
+  innerHalfWidth(0),
+  innerHalfLength(0),
   sampler(nullptr)
 {
   if (tiltOffsetIn->HasFiniteTilt() && BDS::IsFinite(component->GetAngle()))
@@ -75,6 +78,8 @@ BDSLinkOpaqueBox::BDSLinkOpaqueBox(BDSAcceleratorComponent* acceleratorComponent
   G4double my = extent.MaximumY();
   G4double mr = std::max({mx, my, outputSamplerRadius});
   G4double mz = extent.MaximumZ();
+  innerHalfWidth  = mr + gap;
+  innerHalfLength = mz + gap;
   G4Box* terminatorBoxOuter = new G4Box(name + "_terminator_box_outer_solid",
 					mr + gap + opaqueBoxThickness,
 					mr + gap + opaqueBoxThickness,
@@ -159,6 +164,13 @@ BDSLinkOpaqueBox::~BDSLinkOpaqueBox()
   delete sampler;
 }
 
+G4bool BDSLinkOpaqueBox::Encompasses(const BDSExtent& componentExtent) const
+{
+  BDSExtent extent = componentExtent.TiltOffset(&tiltOffset);
+  G4double mr = std::max(extent.MaximumX(), extent.MaximumY());
+  return mr < innerHalfWidth && extent.MaximumZ() < innerHalfLength;
+}
+
 G4int BDSLinkOpaqueBox::PlaceOutputSampler()
 {  
   G4String samplerName = component->GetName() + "_out";
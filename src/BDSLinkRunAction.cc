@@ -18,11 +18,19 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSAuxiliaryNavigator.hh"
 #include "BDSHitSamplerLink.hh"
+#include "BDSLinkBatch.hh"
 #include "BDSLinkEventAction.hh"
 #include "BDSLinkRunAction.hh"
+#include "BDSParticleCoordsFull.hh"
+
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <chrono>
 
 BDSLinkRunAction::BDSLinkRunAction():
   allHits(nullptr),
+  batchOutput(nullptr),
   nSecondariesToReturn(0),
   nPrimariesToReturn(0),
   maximumExternalParticleID(0)
@@ -65,21 +73,90 @@ void BDSLinkRunAction::AppendHits(G4int currentEventIndex,
     {return;}
   for (G4int i = 0; i < (G4int)hits->entries(); i++)
     {
-      auto hit = new BDSHitSamplerLink(*(*hits)[i]);
+      const BDSHitSamplerLink* hitIn = (*hits)[i];
+      auto hit = new BDSHitSamplerLink(*hitIn);
       hit->eventID = currentEventIndex;
-      if (hit->parentID == 0)
-	{// use same ones from event which are the original ones for this primary
-	  hit->externalParticleID = externalParticleID;
-	  hit->externalParentID   = externalParentID;
-	  nPrimariesToReturn++;
-	}
-      else
-	{// new secondary - give it a new index (caching that), and new parentID
-	  maximumExternalParticleID++;
-	  hit->externalParticleID = maximumExternalParticleID;
-	  hit->externalParentID   = externalParticleID;
-	  nSecondariesToReturn++;
-	}
+      AssignExternalIDs(hitIn->parentID,
+			externalParticleID,
+			externalParentID,
+			hit->externalParticleID,
+			hit->externalParentID);
       allHits->insert(hit);
     }
 }
+
+void BDSLinkRunAction::AssignExternalIDs(G4int  parentID,
+					 G4int  externalParticleID,
+					 G4int  externalParentID,
+					 G4int& hitExternalParticleID,
+					 G4int& hitExternalParentID)
+{
+  if (parentID == 0)
+    {// use same ones from event which are the original ones for this primary
+      hitExternalParticleID = externalParticleID;
+      hitExternalParentID   = externalParentID;
+      nPrimariesToReturn++;
+    }
+  else
+    {// new secondary - give it a new index (caching that), and new parentID
+      maximumExternalParticleID++;
+      hitExternalParticleID = maximumExternalParticleID;
+      hitExternalParentID   = externalParticleID;
+      nSecondariesToReturn++;
+    }
+}
+
+void BDSLinkRunAction::WriteToBatch(const BDSParticleCoordsFull& coords,
+				    G4double mass,
+				    G4double charge,
+				    G4int    pdgID,
+				    G4int    Z,
+				    G4int    A,
+				    G4int    parentID,
+				    G4int    externalParticleID,
+				    G4int    externalParentID)
+{
+  auto tStart = std::chrono::steady_clock::now();
+  G4int hitExternalParticleID;
+  G4int hitExternalParentID;
+  AssignExternalIDs(parentID, externalParticleID, externalParentID, hitExternalParticleID, hitExternalParentID);
+
+  BDSLinkBatchOutput& b = *batchOutput;
+  if (parentID == 0)
+    {b.nPrimaries++;}
+  else
+    {b.nSecondaries++;}
+  if (b.size >= b.capacity)
+    {b.nNotStored++; return;}
+
+  std::size_t i = b.size;
+  b.size++;
+  if (b.x)
+    {b.x[i] = coords.x / CLHEP::m;}
+  if (b.xp)
+    {b.xp[i] = coords.xp;}
+  if (b.y)
+    {b.y[i] = coords.y / CLHEP::m;}
+  if (b.yp)
+    {b.yp[i] = coords.yp;}
+  if (b.t)
+    {b.t[i] = coords.T / CLHEP::s;}
+  if (b.totalEnergy)
+    {b.totalEnergy[i] = coords.totalEnergy / CLHEP::GeV;}
+  if (b.mass)
+    {b.mass[i] = mass / CLHEP::GeV;}
+  if (b.charge)
+    {b.charge[i] = charge / CLHEP::eplus;}
+  if (b.pdgID)
+    {b.pdgID[i] = pdgID;}
+  if (b.Z)
+    {b.Z[i] = Z;}
+  if (b.A)
+    {b.A[i] = A;}
+  if (b.id)
+    {b.id[i] = hitExternalParticleID;}
+  if (b.parentID)
+    {b.parentID[i] = hitExternalParentID;}
+  std::chrono::duration<double> duration = std::chrono::steady_clock::now() - tStart;
+  b.timing.output += duration.count();
+}
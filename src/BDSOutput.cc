@@ -150,6 +150,8 @@ BDSOutput::BDSOutput(const G4String& baseFileNameIn,
   storeSamplerMass           = g->StoreSamplerMass();
   storeSamplerRigidity       = g->StoreSamplerRigidity();
   storeSamplerIon            = g->StoreSamplerIon();
+  storeSamplerCompact        = g->StoreSamplerCompact();
+  samplerSignificantBits     = g->SamplerSignificantBits();
   storeTrajectory            = g->StoreTrajectory();
   storeTrajectoryStepPoints  = g->StoreTrajectoryStepPoints();
   storeTrajectoryStepPointLast = g->StoreTrajectoryStepPointLast();
@@ -183,6 +185,7 @@ void BDSOutput::InitialiseGeometryDependent()
 
 void BDSOutput::FillHeader()
 {
+  WaitForEventLevelWrite(); // other trees are in the same file as the event tree
   headerOutput->Flush();
   headerOutput->Fill(); // updates time stamp
   WriteHeader();
@@ -191,6 +194,7 @@ void BDSOutput::FillHeader()
 
 void BDSOutput::FillParticleData(G4bool writeIons)
 {
+  WaitForEventLevelWrite();
   // always prepare particle data and link to other classes, but optionally fill it
   particleDataOutput->Flush();
   particleDataOutput->Fill(writeIons);
@@ -209,6 +213,7 @@ void BDSOutput::FillParticleData(G4bool writeIons)
 
 void BDSOutput::FillBeam(const GMAD::BeamBase* beam)
 {
+  WaitForEventLevelWrite();
   *beamOutput = BDSOutputROOTEventBeam(beam);
   WriteBeam();
   ClearStructuresBeam();
@@ -216,6 +221,7 @@ void BDSOutput::FillBeam(const GMAD::BeamBase* beam)
 
 void BDSOutput::FillOptions(const GMAD::OptionsBase* options)
 {
+  WaitForEventLevelWrite();
   *optionsOutput = BDSOutputROOTEventOptions(options);
   WriteOptions();
   ClearStructuresOptions();
@@ -223,6 +229,7 @@ void BDSOutput::FillOptions(const GMAD::OptionsBase* options)
 
 void BDSOutput::FillModel()
 {
+  WaitForEventLevelWrite();
   if (storeModel)
     {
       const auto& smpm = BDSAcceleratorModel::Instance()->ScorerMeshPlacementsMap();
@@ -272,6 +279,7 @@ void BDSOutput::FillPrimary(const G4PrimaryVertex* vertex,
 void BDSOutput::FillEventPrimaryOnly(const BDSParticleCoordsFullGlobal& coords,
                                      const BDSParticleDefinition*       particle)
 {
+  WaitForEventLevelWrite();
   G4bool isIon = particle->IsAnIon();
   G4int  ionA  = 0;
   G4int  ionZ  = 0;
@@ -291,8 +299,7 @@ void BDSOutput::FillEventPrimaryOnly(const BDSParticleCoordsFullGlobal& coords,
       true,
       &isIon, &ionA, &ionZ);
   primaryGlobal->Fill(coords.global);
-  WriteFileEventLevel();
-  ClearStructuresEventLevel();
+  WriteAndClearEventLevel();
 }
 
 void BDSOutput::FillEvent(const BDSEventInfo*                            info,
@@ -316,6 +323,8 @@ void BDSOutput::FillEvent(const BDSEventInfo*                            info,
                           const std::map<G4String, G4THitsMap<G4double>*>& scorerHits,
                           const G4int                                    turnsTaken)
 {
+  WaitForEventLevelWrite();
+  
   // Clear integrals in this class -> here instead of BDSOutputStructures as
   // looped over here -> do only once as expensive as lots of hits
   energyDeposited              = 0;
@@ -336,6 +345,7 @@ void BDSOutput::FillEvent(const BDSEventInfo*                            info,
   FillSamplerSphereHitsVector(samplerHitsSphere);
   if (samplerHitsLink)
     {FillSamplerHitsLink(samplerHitsLink);}
+  CompactSamplers();
   if (energyLoss)
     {FillEnergyLoss(energyLoss,        BDSOutput::LossType::energy);}
   if (energyLossFull)
@@ -366,12 +376,18 @@ void BDSOutput::FillEvent(const BDSEventInfo*                            info,
   if (info)
     {FillEventInfo(info);}
   
+  WriteAndClearEventLevel();
+}
+
+void BDSOutput::WriteAndClearEventLevel()
+{
   WriteFileEventLevel();
   ClearStructuresEventLevel();
 }
 
 void BDSOutput::CloseAndOpenNewFile()
 {
+  WaitForEventLevelWrite();
   ClearStructuresHeader();
   CloseFile();
   NewFile();
@@ -385,6 +401,7 @@ void BDSOutput::FillRun(const BDSEventInfo* info,
                         unsigned long long int nEventsDistrFileSkippedIn,
                         unsigned int distrFileLoopNTimesIn)
 {
+  WaitForEventLevelWrite();
   FillRunInfoAndUpdateHeader(info, nOriginalEventsIn, nEventsRequestedIn, nEventsInOriginalDistrFileIn, nEventsDistrFileSkippedIn, distrFileLoopNTimesIn);
   WriteFileRunLevel();
   WriteHeaderEndOfFile();
@@ -834,6 +851,14 @@ void BDSOutput::FillSamplerHitsLink(const BDSHitsCollectionSamplerLink* hits)
     }
 }
 
+void BDSOutput::CompactSamplers()
+{
+  if (!storeSamplerCompact && samplerSignificantBits == 0)
+    {return;}
+  for (auto& sampler : samplerTrees)
+    {sampler->Compact(storeSamplerCompact, samplerSignificantBits);}
+}
+
 void BDSOutput::FillEnergyLoss(const BDSHitsCollectionEnergyDepositionGlobal* hits,
                                const LossType lossType)
 {
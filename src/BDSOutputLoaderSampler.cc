@@ -28,9 +28,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "RtypesCore.h"
 #include "TFile.h"
 #include "TTree.h"
+#include "TTreeCache.h"
 
 #include <string>
 
+const G4long BDSOutputLoaderSampler::cacheSize = 32000000; // 32 MB
+
 BDSOutputLoaderSampler::BDSOutputLoaderSampler(const G4String& filePath,
 					       const G4String& samplerName):
   BDSOutputLoader(filePath),
@@ -55,6 +58,13 @@ BDSOutputLoaderSampler::BDSOutputLoaderSampler(const G4String& filePath,
   else
     {eventTree->SetBranchAddress(samplerNameLocal, &localSamplerFloat);}
   nEvents = (G4long)eventTree->GetEntries();
+
+  // only read (and decompress) the one sampler branch rather than the whole event
+  eventTree->SetBranchStatus("*", false);
+  eventTree->SetBranchStatus((samplerNameLocal + "*").c_str(), true);
+  eventTree->SetCacheSize((Long64_t)cacheSize);
+  eventTree->AddBranchToCache((samplerNameLocal + "*").c_str(), true);
+  eventTree->StopCacheLearningPhase();
 }
 
 BDSOutputLoaderSampler::~BDSOutputLoaderSampler()
@@ -77,6 +87,20 @@ const BDSOutputROOTEventSampler<double>* BDSOutputLoaderSampler::SamplerDataDoub
   return localSamplerDouble;
 }
 
+G4long BDSOutputLoaderSampler::ClusterStart(G4long eventNumber) const
+{
+  if (eventNumber <= 0 || eventNumber >= nEvents)
+    {return eventNumber < 0 ? 0 : eventNumber;}
+  TTree::TClusterIterator clusters = eventTree->GetClusterIterator((Long64_t)eventNumber);
+  return (G4long)clusters.Next();
+}
+
+void BDSOutputLoaderSampler::SetReadStart(G4long eventNumber)
+{
+  file->cd();
+  eventTree->SetCacheEntryRange((Long64_t)ClusterStart(eventNumber), (Long64_t)nEvents);
+}
+
 void BDSOutputLoaderSampler::Common(G4long eventNumber)
 {
   if (eventNumber > nEvents)
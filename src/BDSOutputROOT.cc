@@ -37,18 +37,26 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSOutputROOTEventSamplerS.hh"
 #include "BDSOutputROOTEventTrajectory.hh"
 #include "BDSOutputROOTParticleData.hh"
+#include "BDSWarning.hh"
 
 #include "parser/options.h"
 
+#include "RConfigure.h"
 #include "TFile.h"
 #include "TObject.h"
+#include "TROOT.h"
 #include "TTree.h"
 
+#include <exception>
+#include <mutex>
+#include <thread>
+
 BDSOutputROOT::BDSOutputROOT(const G4String& fileName,
 			     G4int           fileNumberOffset,
 			     G4int           compressionLevelIn):
   BDSOutput(fileName, ".root", fileNumberOffset),
   compressionLevel(compressionLevelIn),
+  asynchronous(false),
   theRootOutputFile(nullptr),
   theHeaderOutputTree(nullptr),
   theParticleDataTree(nullptr),
@@ -56,16 +64,36 @@ BDSOutputROOT::BDSOutputROOT(const G4String& fileName,
   theOptionsOutputTree(nullptr),
   theModelOutputTree(nullptr),
   theEventOutputTree(nullptr),
-  theRunOutputTree(nullptr)
-{;}
+  theRunOutputTree(nullptr),
+  eventPending(false),
+  stopWriting(false)
+{
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+  asynchronous = globals->OutputAsynchronous();
+  G4int compressionThreads = globals->OutputCompressionThreads();
+  if (asynchronous || compressionThreads > 0)
+    {ROOT::EnableThreadSafety();}
+  if (compressionThreads > 0)
+    {// baskets are compressed in parallel by TTree::Fill
+#ifdef R__USE_IMT
+      ROOT::EnableImplicitMT((UInt_t)compressionThreads);
+#else
+      BDS::Warning(__METHOD_NAME__, "ROOT is built without implicit multithreading - \"outputCompressionThreads\" has no effect");
+#endif
+    }
+  if (asynchronous)
+    {writer = std::thread(&BDSOutputROOT::WriterLoop, this);}
+}
 
 BDSOutputROOT::~BDSOutputROOT()
 {
+  StopWriter();
   Close();
 }
 
 void BDSOutputROOT::NewFile() 
 {
+  WaitForEventLevelWrite(); // the previous file may still be written to
   G4String newFileName = GetNextFileName();
   BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
 
@@ -216,6 +244,83 @@ void BDSOutputROOT::WriteFileEventLevel()
   theEventOutputTree->Fill();
 }
 
+void BDSOutputROOT::WriteAndClearEventLevel()
+{
+  if (!asynchronous)
+    {
+      WriteFileEventLevel();
+      ClearStructuresEventLevel();
+      return;
+    }
+  {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    eventPending = true;
+  }
+  writerCondition.notify_all();
+}
+
+void BDSOutputROOT::WaitForEventLevelWrite()
+{
+  if (!asynchronous)
+    {return;}
+  std::unique_lock<std::mutex> lock(writerMutex);
+  writerCondition.wait(lock, [this]{return !eventPending;});
+  if (writerException)
+    {// report it once only
+      std::exception_ptr exception = writerException;
+      writerException = nullptr;
+      std::rethrow_exception(exception);
+    }
+}
+
+void BDSOutputROOT::WriterLoop()
+{
+  std::unique_lock<std::mutex> lock(writerMutex);
+  while (true)
+    {
+      writerCondition.wait(lock, [this]{return eventPending || stopWriting;});
+      if (!eventPending)
+        {break;} // stopping and nothing left to write
+      lock.unlock();
+      std::exception_ptr exception = nullptr;
+      try
+        {
+          WriteFileEventLevel();
+          ClearStructuresEventLevel();
+        }
+      catch (...)
+        {exception = std::current_exception();}
+      lock.lock();
+      if (exception)
+        {writerException = exception;}
+      eventPending = false;
+      writerCondition.notify_all();
+    }
+}
+
+void BDSOutputROOT::StopWriter()
+{
+  if (!writer.joinable())
+    {return;}
+  {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    stopWriting = true;
+  }
+  writerCondition.notify_all();
+  writer.join(); // any pending event is written first
+  asynchronous = false;
+  if (writerException)
+    {
+      try
+        {std::rethrow_exception(writerException);}
+      catch (const std::exception& e)
+        {G4cerr << __METHOD_NAME__ << "error writing event: " << e.what() << G4endl;}
+      catch (...)
+        {G4cerr << __METHOD_NAME__ << "unknown error writing event" << G4endl;}
+      writerException = nullptr;
+    }
+}
+
 void BDSOutputROOT::WriteFileRunLevel()
 {
   if (theRootOutputFile)
@@ -236,6 +341,7 @@ void BDSOutputROOT::CloseFile()
 
 void BDSOutputROOT::Close()
 {
+  WaitForEventLevelWrite();
   if (theRootOutputFile)
     {
       if (theRootOutputFile->IsOpen())
@@ -252,6 +358,7 @@ void BDSOutputROOT::Close()
 
 void BDSOutputROOT::UpdateSamplers()
 {
+  WaitForEventLevelWrite();
   G4int nNewSamplers = BDSOutputStructures::UpdateSamplerStructures();
   G4int nSamplers = (G4int)samplerTrees.size();
   for (G4int i = nSamplers - nNewSamplers; i < nSamplers; ++i)
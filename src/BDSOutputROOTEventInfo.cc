@@ -32,6 +32,7 @@ BDSOutputROOTEventInfo::BDSOutputROOTEventInfo():
   primaryHitMachine(false),
   primaryAbsorbedInCollimator(false),
   memoryUsageMb(0),
+  trajectoryPointsPeakMb(0),
   energyDeposited(0),
   energyDepositedVacuum(0),
   energyDepositedWorld(0),
@@ -63,6 +64,7 @@ void BDSOutputROOTEventInfo::Flush()
   primaryHitMachine = false;
   primaryAbsorbedInCollimator = false;
   memoryUsageMb         = 0;
+  trajectoryPointsPeakMb = 0;
   energyDeposited       = 0;
   energyDepositedVacuum = 0;
   energyDepositedWorld  = 0;
@@ -94,6 +96,7 @@ void BDSOutputROOTEventInfo::Fill(const BDSOutputROOTEventInfo* other)
   primaryHitMachine       = other->primaryHitMachine;
   primaryAbsorbedInCollimator = other->primaryAbsorbedInCollimator;
   memoryUsageMb           = other->memoryUsageMb;
+  trajectoryPointsPeakMb  = other->trajectoryPointsPeakMb;
   energyDeposited         = other->energyDeposited;
   energyDepositedVacuum   = other->energyDepositedVacuum;
   energyDepositedWorld    = other->energyDepositedWorld;
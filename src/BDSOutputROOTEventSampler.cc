@@ -21,6 +21,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "TTree.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 class BDSOutputROOTParticleData;
 
 #ifndef __ROOTBUILD__
@@ -31,11 +36,25 @@ class BDSOutputROOTParticleData;
 
 #include "globals.hh"
 #include "CLHEP/Units/SystemOfUnits.h"
-#include <cmath>
 #endif
 
 templateClassImp(BDSOutputROOTEventSampler)
 
+namespace
+{
+  /// Round each value to a number of significant bits in the mantissa.
+  template <class U>
+  void RoundToSignificantBits(std::vector<U>& values, int significantBits)
+  {
+    for (auto& value : values)
+      {
+        int exponent = 0;
+        U fraction = std::frexp(value, &exponent);
+        value = std::ldexp(std::round(std::ldexp(fraction, significantBits)), exponent - significantBits);
+      }
+  }
+}
+
 template <class U>
 BDSOutputROOTEventSampler<U>::BDSOutputROOTEventSampler():
   samplerName("sampler")
@@ -256,6 +275,28 @@ void BDSOutputROOTEventSampler<U>::Fill(const BDSOutputROOTEventSampler<U>* othe
   nElectrons = other->nElectrons;
 }
 
+template <class U>
+void BDSOutputROOTEventSampler<U>::Compact(bool compactDerived, int significantBits)
+{
+  const int digits = std::numeric_limits<U>::digits;
+  if (significantBits > 0 && significantBits < digits)
+    {
+      for (auto values : {&energy, &x, &y, &xp, &yp, &zp, &r, &rp, &phi, &phip, &theta, &mass})
+        {RoundToSignificantBits(*values, significantBits);}
+    }
+
+  // the same precision as a Float16_t without a range
+  const int compactDerivedBits = 12;
+  int derivedBits = significantBits > 0 ? significantBits : digits;
+  if (compactDerived)
+    {derivedBits = std::min(derivedBits, compactDerivedBits);}
+  if (derivedBits < digits)
+    {
+      for (auto values : {&p, &kineticEnergy, &rigidity})
+        {RoundToSignificantBits(*values, derivedBits);}
+    }
+}
+
 template <class U> void BDSOutputROOTEventSampler<U>::SetBranchAddress(TTree *)
 {;}
 
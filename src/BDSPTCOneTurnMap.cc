@@ -29,8 +29,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <fstream>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
@@ -44,7 +47,8 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
   pxLastTurn(0),
   yLastTurn(0),
   pyLastTurn(0),
-  deltaPLastTurn(0)
+  deltaPLastTurn(0),
+  maximumOrder(0)
 {
   referenceMomentum = designParticle->Momentum();
   mass = designParticle->Mass();
@@ -68,6 +72,7 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
   G4int ndeltaP = 0;
   G4int nt = 0;
 
+  std::map<std::array<G4int, 5>, std::size_t> monomialIndex;
   G4String line = "";
   while (std::getline(infile, line))
     {
@@ -80,30 +85,50 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
 
       PTCMapTerm term{coefficient, nx, npx, ny, npy, ndeltaP};
 
-      switch (nVector)
-	{
-	case 1:
-	  {xTerms.push_back(term); break;}
-	case 2:
-	  {pxTerms.push_back(term); break;}
-	case 3:
-	  {yTerms.push_back(term);  break;}
-	case 4:
-	  {pyTerms.push_back(term); break;}
-	case 5:
-	  {deltaPTerms.push_back(term); break;}
-	default:
-	  {
-	    throw BDSException(__METHOD_NAME__, "Unrecognised PTC term index - maptable file is perhaps malformed.");
-	    break;
-	  }
-	}
+      // nVector is 1 to 5 for x, px, y, py, deltaP
+      if (nVector < 1 || nVector > 5)
+	{throw BDSException(__METHOD_NAME__, "Unrecognised PTC term index - maptable file is perhaps malformed.");}
+      AddTerm(nVector - 1, term, monomialIndex);
     }
+
+  // the power indices can only be set once the highest order is known
+  for (auto& monomial : monomials)
+    {
+      for (G4int v = 0; v < 5; v++)
+	{monomial.powerIndex[v] += v * (maximumOrder + 1);}
+    }
+  powers.resize(5 * (maximumOrder + 1), 1.0);
+  
+  G4cout << __METHOD_NAME__ << monomials.size() << " unique monomials up to order "
+	 << maximumOrder << " in each coordinate" << G4endl;
 #ifdef BDSDEBUG
       G4cout << __METHOD_NAME__ << "> Loaded Map:" << maptableFile << G4endl;
 #endif
 }
 
+void BDSPTCOneTurnMap::AddTerm(G4int             outputIndex,
+			       const PTCMapTerm& term,
+			       std::map<std::array<G4int, 5>, std::size_t>& monomialIndex)
+{
+  std::array<G4int, 5> key = {term.nx, term.npx, term.ny, term.npy, term.ndeltaP};
+  for (auto n : key)
+    {
+      if (n < 0)
+	{throw BDSException(__METHOD_NAME__, "Negative power in PTC term - maptable file is perhaps malformed.");}
+      maximumOrder = std::max(maximumOrder, n);
+    }
+  
+  auto search = monomialIndex.find(key);
+  if (search == monomialIndex.end())
+    {
+      // power indices are offset by coordinate once all terms are loaded
+      PTCMonomial monomial = {key, {0, 0, 0, 0, 0}};
+      search = monomialIndex.emplace(key, monomials.size()).first;
+      monomials.push_back(monomial);
+    }
+  monomials[search->second].coefficient[outputIndex] += term.coefficient;
+}
+
 void BDSPTCOneTurnMap::SetInitialPrimaryCoordinates(const BDSParticleCoordsFullGlobal& coords,
 						    G4bool beamOffsetS0In)
 {
@@ -160,26 +185,13 @@ void BDSPTCOneTurnMap::GetThisTurn(G4double& x,
 #endif
 
       lastTurnNumber = turnsTaken;
-      xOut = Evaluate(xTerms,
-		      xLastTurn, pxLastTurn,
-		      yLastTurn, pyLastTurn,
-		      deltaPLastTurn);
-      pxOut = Evaluate(pxTerms,
-		       xLastTurn, pxLastTurn,
-		       yLastTurn, pyLastTurn,
-		       deltaPLastTurn);
-      yOut = Evaluate(yTerms,
-		      xLastTurn, pxLastTurn,
-		      yLastTurn, pyLastTurn,
-		      deltaPLastTurn);
-      pyOut = Evaluate(pyTerms,
-		       xLastTurn, pxLastTurn,
-		       yLastTurn, pyLastTurn,
-		       deltaPLastTurn);
-      deltaPOut = Evaluate(deltaPTerms,
-			   xLastTurn, pxLastTurn,
-			   yLastTurn, pyLastTurn,
-			   deltaPLastTurn);
+      G4double coords[5] = {xLastTurn, pxLastTurn, yLastTurn, pyLastTurn, deltaPLastTurn};
+      Evaluate(coords, coords);
+      xOut      = coords[0];
+      pxOut     = coords[1];
+      yOut      = coords[2];
+      pyOut     = coords[3];
+      deltaPOut = coords[4];
       // Cache results for next turn.  Do it here, before we convert to BDSIM coordinates.
       xLastTurn      = xOut;
       pxLastTurn     = pxOut;
@@ -244,24 +256,95 @@ void BDSPTCOneTurnMap::GetThisTurn(G4double& x,
 #endif
 }
 
-G4double BDSPTCOneTurnMap::Evaluate(std::vector<PTCMapTerm>& terms,
-				    G4double x,
-                                    G4double px,
-				    G4double y,
-				    G4double py,
-                                    G4double deltaP) const
+void BDSPTCOneTurnMap::FillPowers(const G4double coords[5])
 {
-  G4double result = 0;
-  for (const auto& term : terms)
+  // powers[v*(maximumOrder+1)] is always 1
+  G4int stride = maximumOrder + 1;
+  for (G4int v = 0; v < 5; v++)
     {
-      result += (term.coefficient
-		 * std::pow(x, term.nx)
-		 * std::pow(px, term.npx)
-		 * std::pow(y, term.ny)
-		 * std::pow(py, term.npy)
-		 * std::pow(deltaP, term.ndeltaP));
+      G4double* p = powers.data() + v*stride;
+      for (G4int n = 1; n < stride; n++)
+	{p[n] = p[n-1] * coords[v];}
+    }
+}
+
+void BDSPTCOneTurnMap::Evaluate(const G4double coordsIn[5],
+				G4double       coordsOut[5])
+{
+  FillPowers(coordsIn);
+  const G4double* p = powers.data();
+  G4double result[5] = {0, 0, 0, 0, 0};
+  for (const auto& monomial : monomials)
+    {
+      const auto& pi = monomial.powerIndex;
+      G4double value = p[pi[0]] * p[pi[1]] * p[pi[2]] * p[pi[3]] * p[pi[4]];
+      const auto& c = monomial.coefficient;
+      result[0] += c[0] * value;
+      result[1] += c[1] * value;
+      result[2] += c[2] * value;
+      result[3] += c[3] * value;
+      result[4] += c[4] * value;
+    }
+  std::copy(result, result + 5, coordsOut);
+}
+
+void BDSPTCOneTurnMap::EvaluateBatch(std::size_t n,
+				     G4double*   x,
+				     G4double*   px,
+				     G4double*   y,
+				     G4double*   py,
+				     G4double*   deltaP)
+{
+  // Particles are evaluated in blocks so each monomial is read once per block and
+  // the inner loop over the block is contiguous. The table of powers is ordered by
+  // power index then particle. For a final partial block the unused entries are
+  // left from the previous block and are computed but not used.
+  const std::size_t blockSize = 8;
+  const G4int stride = maximumOrder + 1;
+  std::vector<G4double> blockPowers(5 * stride * blockSize, 1.0);
+  G4double* coords[5] = {x, px, y, py, deltaP};
+  
+  for (std::size_t start = 0; start < n; start += blockSize)
+    {
+      std::size_t nInBlock = std::min(blockSize, n - start);
+      for (G4int v = 0; v < 5; v++)
+	{
+	  G4double* p = blockPowers.data() + v*stride*blockSize;
+	  if (stride < 2)
+	    {continue;} // only constant terms
+	  for (std::size_t j = 0; j < nInBlock; j++)
+	    {p[blockSize + j] = coords[v][start + j];}
+	  for (G4int k = 2; k < stride; k++)
+	    {
+	      for (std::size_t j = 0; j < nInBlock; j++)
+		{p[k*blockSize + j] = p[(k-1)*blockSize + j] * p[blockSize + j];}
+	    }
+	}
+
+      G4double result[5][blockSize] = {};
+      const G4double* p = blockPowers.data();
+      for (const auto& monomial : monomials)
+	{
+	  const auto& pi = monomial.powerIndex;
+	  const G4double* p0 = p + pi[0]*blockSize;
+	  const G4double* p1 = p + pi[1]*blockSize;
+	  const G4double* p2 = p + pi[2]*blockSize;
+	  const G4double* p3 = p + pi[3]*blockSize;
+	  const G4double* p4 = p + pi[4]*blockSize;
+	  const auto& c = monomial.coefficient;
+	  for (std::size_t j = 0; j < blockSize; j++)
+	    {
+	      G4double value = p0[j] * p1[j] * p2[j] * p3[j] * p4[j];
+	      result[0][j] += c[0] * value;
+	      result[1][j] += c[1] * value;
+	      result[2][j] += c[2] * value;
+	      result[3][j] += c[3] * value;
+	      result[4][j] += c[4] * value;
+	    }
+	}
+      for (G4int v = 0; v < 5; v++)
+	{std::copy(result[v], result[v] + nInBlock, coords[v] + start);}
     }
-  return result;
 }
 
 G4bool BDSPTCOneTurnMap::ShouldApplyToPrimary(G4double momentum,
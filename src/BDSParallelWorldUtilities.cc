@@ -33,6 +33,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSUtilities.hh"
 
 #include "parser/element.h"
+#include "parser/expandedsequence.h"
 #include "parser/fastlist.h"
 #include "parser/placement.h"
 
@@ -25,6 +25,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 BDSPhysicalVolumeInfoRegistry* BDSPhysicalVolumeInfoRegistry::instance = nullptr;
 
@@ -36,10 +37,7 @@ BDSPhysicalVolumeInfoRegistry* BDSPhysicalVolumeInfoRegistry::Instance()
 }
 
 BDSPhysicalVolumeInfoRegistry::BDSPhysicalVolumeInfoRegistry()
-{
-  readOutSearch = readOutRegister.begin();
-  backupSearch  = backupRegister.begin();
-}
+{;}
 
 BDSPhysicalVolumeInfoRegistry::~BDSPhysicalVolumeInfoRegistry()
 {
@@ -70,6 +68,8 @@ void BDSPhysicalVolumeInfoRegistry::RegisterInfo(G4VPhysicalVolume*     physical
   if (isTunnel)
     {
       tunnelRegister[physicalVolume] = info;
+      if (excludedVolumes.find(physicalVolume) == excludedVolumes.end())
+	{tunnelLookup[physicalVolume] = info;}
       return;
     }
   // doesn't already exist so register it
@@ -77,6 +77,8 @@ void BDSPhysicalVolumeInfoRegistry::RegisterInfo(G4VPhysicalVolume*     physical
     {readOutRegister[physicalVolume] = info;}
   else
     {backupRegister[physicalVolume] = info;}
+  if (excludedVolumes.find(physicalVolume) == excludedVolumes.end())
+    {lookup[physicalVolume] = info;} // excluded volumes always give a nullptr
 #ifdef BDSDEBUG
   G4cout << __METHOD_NAME__ << "component registered" << G4endl;
 #endif
@@ -92,26 +94,14 @@ void BDSPhysicalVolumeInfoRegistry::RegisterInfo(const std::set<G4VPhysicalVolum
 }
 
 BDSPhysicalVolumeInfo* BDSPhysicalVolumeInfoRegistry::GetInfo(G4VPhysicalVolume* physicalVolume,
-							      G4bool             isTunnel)
+							      G4bool             isTunnel) const
 {
   if (!physicalVolume)
     {return nullptr;}
-  if (excludedVolumes.find(physicalVolume) != excludedVolumes.end())
-    {// it was found in excluded volumes
-      return nullptr;
-    }
-  if (isTunnel)
-    {
-      tunnelSearch = tunnelRegister.find(physicalVolume);
-      if (tunnelSearch == tunnelRegister.end())
-	{return nullptr;}
-      else
-	{return tunnelSearch->second;}
-    }
-  else if (IsRegisteredToReadOutRegister(physicalVolume))
-    {return readOutSearch->second;}
-  else if (IsRegisteredToBackupRegister(physicalVolume))
-    {return backupSearch->second;}
+  const auto& table = isTunnel ? tunnelLookup : lookup;
+  auto search = table.find(physicalVolume);
+  if (search != table.end())
+    {return search->second;} // nullptr for excluded volumes
   else
     {//uh oh - not found!
 #ifdef BDSDEBUG
@@ -125,6 +115,8 @@ BDSPhysicalVolumeInfo* BDSPhysicalVolumeInfoRegistry::GetInfo(G4VPhysicalVolume*
 void BDSPhysicalVolumeInfoRegistry::RegisterExcludedPV(G4VPhysicalVolume* physicalVolume)
 {
   excludedVolumes.insert(physicalVolume);
+  lookup[physicalVolume] = nullptr;
+  tunnelLookup[physicalVolume] = nullptr;
 }
 
 void BDSPhysicalVolumeInfoRegistry::RegisterPVsForOutput(const BDSBeamlineElement* element,
@@ -133,37 +125,25 @@ void BDSPhysicalVolumeInfoRegistry::RegisterPVsForOutput(const BDSBeamlineElemen
   pvsForAGivenElement[element] = physicalVolumes;
 }
 
-G4bool BDSPhysicalVolumeInfoRegistry::IsRegistered(G4VPhysicalVolume* physicalVolume)
+G4bool BDSPhysicalVolumeInfoRegistry::IsRegistered(G4VPhysicalVolume* physicalVolume) const
 {
   return (IsRegisteredToReadOutRegister(physicalVolume) || IsRegisteredToBackupRegister(physicalVolume));
 }
   
-G4bool BDSPhysicalVolumeInfoRegistry::IsRegisteredToReadOutRegister(G4VPhysicalVolume* physicalVolume)
+G4bool BDSPhysicalVolumeInfoRegistry::IsRegisteredToReadOutRegister(G4VPhysicalVolume* physicalVolume) const
 {
-  readOutSearch = readOutRegister.find(physicalVolume);
-  if (readOutSearch == readOutRegister.end())
-    {return false;}
-  else
-    {return true;}
+  return readOutRegister.find(physicalVolume) != readOutRegister.end();
 }
 
-G4bool BDSPhysicalVolumeInfoRegistry::IsRegisteredToBackupRegister(G4VPhysicalVolume* physicalVolume)
+G4bool BDSPhysicalVolumeInfoRegistry::IsRegisteredToBackupRegister(G4VPhysicalVolume* physicalVolume) const
 {
-  backupSearch = backupRegister.find(physicalVolume);
-  if (backupSearch == backupRegister.end())
-    {return false;}
-  else
-    {return true;}
+  return backupRegister.find(physicalVolume) != backupRegister.end();
 }
 
- G4bool BDSPhysicalVolumeInfoRegistry::IsRegisteredToTunnelRegister(G4VPhysicalVolume* physicalVolume)
- {
-   tunnelSearch = tunnelRegister.find(physicalVolume);
-   if (tunnelSearch == tunnelRegister.end())
-     {return false;}
-   else
-     {return true;}
- }
+G4bool BDSPhysicalVolumeInfoRegistry::IsRegisteredToTunnelRegister(G4VPhysicalVolume* physicalVolume) const
+{
+  return tunnelRegister.find(physicalVolume) != tunnelRegister.end();
+}
 
 std::ostream& operator<< (std::ostream& out, BDSPhysicalVolumeInfoRegistry const &r)
 {
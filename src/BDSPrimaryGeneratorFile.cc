@@ -131,7 +131,8 @@ BDSPrimaryGeneratorFile* BDSPrimaryGeneratorFile::ConstructGenerator(const GMAD:
                                                                  beg,
                                                                  shouldLoopFile,
                                                                  beam.removeUnstableWithoutDecay,
-                                                                 beam.eventGeneratorWarnSkippedParticles);
+                                                                 beam.eventGeneratorWarnSkippedParticles,
+                                                                 beam.distrFilePrefetch);
           
         }
       
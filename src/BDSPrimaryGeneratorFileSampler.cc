@@ -40,19 +40,37 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "globals.hh"
 
+#include "TROOT.h"
+
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
+
+const G4int BDSPrimaryGeneratorFileSampler::filterUnknown = -1;
+const G4int BDSPrimaryGeneratorFileSampler::filterPassed  = -2;
 
 BDSPrimaryGeneratorFileSampler::BDSPrimaryGeneratorFileSampler(const G4String& distrType,
                                                                const G4String& fileNameIn,
                                                                BDSBunchEventGenerator* bunchIn,
                                                                G4bool loopFileIn,
                                                                G4bool removeUnstableWithoutDecayIn,
-                                                               G4bool warnAboutSkippedParticlesIn):
+                                                               G4bool warnAboutSkippedParticlesIn,
+                                                               G4int  prefetchDepthIn):
   BDSPrimaryGeneratorFile(loopFileIn, bunchIn),
   reader(nullptr),
   fileName(fileNameIn),
   removeUnstableWithoutDecay(removeUnstableWithoutDecayIn),
-  warnAboutSkippedParticles(warnAboutSkippedParticlesIn)
+  warnAboutSkippedParticles(warnAboutSkippedParticlesIn),
+  lastIndexRead(-1),
+  prefetchDepth(prefetchDepthIn),
+  ringHead(0),
+  ringCount(0),
+  nextPrefetchIndex(0),
+  prefetchGeneration(0),
+  prefetchAtEnd(false),
+  stopPrefetching(false)
 {
   std::pair<G4String, G4String> ba = BDS::SplitOnColon(distrType); // before:after
   samplerName = ba.second;
@@ -65,11 +83,21 @@ BDSPrimaryGeneratorFileSampler::BDSPrimaryGeneratorFileSampler(const G4String& d
   G4cout << __METHOD_NAME__ << nEventsInFile << " events found in file" << G4endl;
   if (!bunch)
     {throw BDSException(__METHOD_NAME__, "must be constructed with a valid BDSBunchEventGenerator instance");}
+  filterCache.assign((std::size_t)nEventsInFile, filterUnknown);
+  if (prefetchDepth < 0)
+    {throw BDSException(__METHOD_NAME__, "distrFilePrefetch must be 0 or greater");}
+  if (prefetchDepth > 0)
+    {// the thread is started when the first event is requested
+      G4cout << __METHOD_NAME__ << "reading " << prefetchDepth << " events ahead in a separate thread" << G4endl;
+      ROOT::EnableThreadSafety();
+      ring.resize((std::size_t)prefetchDepth);
+    }
   SkipEvents(bunch->eventGeneratorNEventsSkip);
 }
 
 BDSPrimaryGeneratorFileSampler::~BDSPrimaryGeneratorFileSampler()
 {
+  StopPrefetch();
   delete reader;
 }
 
@@ -117,9 +145,10 @@ void BDSPrimaryGeneratorFileSampler::RecreateAdvanceToEvent(G4int eventOffset)
   SkipEvents(eventOffset);
 }
 
-void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesFloat(G4long index)
+void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesFloat(G4long index,
+                                                               std::vector<SamplerParticle>& particles)
 {
-  vertices.clear();
+  particles.clear();
   const auto sampler = reader->SamplerDataFloat(index);
   
   int n = sampler->n;
@@ -136,15 +165,14 @@ void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesFloat(G4long index)
       G4double T = (G4double)sampler->T[i] * CLHEP::s;
       G4ThreeVector localPosition(x,y,0);
       G4double weight = (G4double)sampler->weight[i];
-      auto g4prim = new G4PrimaryParticle(pdgID, momentum.x(), momentum.y(), momentum.z());
-      g4prim->SetWeight(weight);
-      vertices.emplace_back(DisplacedVertex{localPosition, T, g4prim});
+      particles.emplace_back(SamplerParticle{pdgID, momentum, localPosition, T, weight});
     }
 }
 
-void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesDouble(G4long index)
+void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesDouble(G4long index,
+                                                                std::vector<SamplerParticle>& particles)
 {
-  vertices.clear();
+  particles.clear();
   const auto sampler = reader->SamplerDataDouble(index);
   
   int n = sampler->n;
@@ -161,20 +189,55 @@ void BDSPrimaryGeneratorFileSampler::ReadPrimaryParticlesDouble(G4long index)
       G4double T = (G4double)sampler->T[i] * CLHEP::s;
       G4ThreeVector localPosition(x,y,0);
       G4double weight = (G4double)sampler->weight[i];
-      auto g4prim = new G4PrimaryParticle(pdgID, momentum.x(), momentum.y(), momentum.z());
-      g4prim->SetWeight(weight);
-      vertices.emplace_back(DisplacedVertex{localPosition, T, g4prim});
+      particles.emplace_back(SamplerParticle{pdgID, momentum, localPosition, T, weight});
     }
 }
 
-void BDSPrimaryGeneratorFileSampler::ReadSingleEvent(G4long index, G4Event* anEvent)
+void BDSPrimaryGeneratorFileSampler::ReadParticles(G4long index,
+                                                   std::vector<SamplerParticle>& particles)
 {
+  // Only restart the read cache when looping back or jumping to another cluster. Events
+  // skipped by the filter cache within the cluster being read are already in the cache.
+  if (index < lastIndexRead || reader->ClusterStart(index) != reader->ClusterStart(lastIndexRead + 1))
+    {reader->SetReadStart(index);}
   if (reader->DoublePrecision())
-    {ReadPrimaryParticlesDouble(index);}
+    {ReadPrimaryParticlesDouble(index, particles);}
+  else
+    {ReadPrimaryParticlesFloat(index, particles);}
+  lastIndexRead = index;
+}
+
+void BDSPrimaryGeneratorFileSampler::ReadSingleEvent(G4long index, G4Event* anEvent)
+{
+  // an event where no particles passed the filters before isn't read again
+  G4bool read = false;
+  G4int  cachedResult = filterUnknown;
+  if (prefetchDepth > 0)
+    {
+      read = TakePrefetchedEvent(index, particlesLoaded);
+      std::lock_guard<std::mutex> lock(prefetchMutex);
+      cachedResult = filterCache[(std::size_t)index];
+    }
   else
-    {ReadPrimaryParticlesFloat(index);}
+    {
+      cachedResult = filterCache[(std::size_t)index];
+      read = cachedResult < 0;
+      if (read)
+        {ReadParticles(index, particlesLoaded);}
+    }
+
+  vertices.clear();
+  if (read)
+    {
+      for (const auto& particle : particlesLoaded)
+        {
+          auto g4prim = new G4PrimaryParticle(particle.pdgID, particle.momentum.x(), particle.momentum.y(), particle.momentum.z());
+          g4prim->SetWeight(particle.weight);
+          vertices.emplace_back(DisplacedVertex{particle.xyz, particle.T, g4prim});
+        }
+    }
   
-  G4int nParticlesSkipped = 0;
+  G4int nParticlesSkipped = read ? 0 : cachedResult;
   for (const auto& xyzVertex : vertices)
     {
       const auto vertex = xyzVertex.vertex;
@@ -271,6 +334,19 @@ void BDSPrimaryGeneratorFileSampler::ReadSingleEvent(G4long index, G4Event* anEv
       vertexGeneratedSuccessfully = true;
       nEventsReadThatPassedFilters++;
     }
+
+  // the filters don't change so remember the result for the next pass of the file
+  if (cachedResult == filterUnknown)
+    {
+      G4int result = currentVertices.empty() ? nParticlesSkipped : filterPassed;
+      if (prefetchDepth > 0)
+        {
+          std::lock_guard<std::mutex> lock(prefetchMutex);
+          filterCache[(std::size_t)index] = result;
+        }
+      else
+        {filterCache[(std::size_t)index] = result;}
+    }
   
   // clear initially loaded ones
   for (auto& v : vertices)
@@ -301,6 +377,107 @@ void BDSPrimaryGeneratorFileSampler::SkipEvents(G4long nEventsToSkip)
       msg += ") in this file.";
       throw BDSException("BDSBunchUserFile::RecreateAdvanceToEvent>", msg);
     }
-  G4long nToSkipSinglePass = nAvailable % nEventsToSkip;
+  G4long nToSkipSinglePass = nEventsToSkip % nEventsInFile;
   currentFileEventIndex = nToSkipSinglePass;
+  // the file is only read from here when the next event is read so no entries are
+  // read in between - reading restarts at the cluster containing this event
+}
+
+G4bool BDSPrimaryGeneratorFileSampler::TakePrefetchedEvent(G4long index,
+                                                           std::vector<SamplerParticle>& particles)
+{
+  std::unique_lock<std::mutex> lock(prefetchMutex);
+  if (!prefetcher.joinable())
+    {
+      nextPrefetchIndex = index;
+      prefetcher = std::thread(&BDSPrimaryGeneratorFileSampler::PrefetchLoop, this);
+    }
+
+  G4bool inOrder = ringCount > 0 ? ring[ringHead].index == index : nextPrefetchIndex == index;
+  if (!inOrder)
+    {// e.g. skipped - discard what has been read and restart from this event
+      ringCount          = 0;
+      nextPrefetchIndex  = index;
+      prefetchAtEnd      = false;
+      prefetchGeneration++;
+      prefetchCondition.notify_all();
+    }
+
+  prefetchCondition.wait(lock, [this]{return ringCount > 0 || prefetchException;});
+  if (ringCount == 0)
+    {// report it once only
+      std::exception_ptr exception = prefetchException;
+      prefetchException = nullptr;
+      prefetchCondition.notify_all();
+      std::rethrow_exception(exception);
+    }
+
+  // swap so the buffers are reused rather than reallocated for every event
+  PrefetchedEvent& event = ring[ringHead];
+  std::swap(particles, event.particles);
+  G4bool read = event.read;
+  ringHead = (ringHead + 1) % ring.size();
+  ringCount--;
+  prefetchCondition.notify_all();
+  return read;
+}
+
+void BDSPrimaryGeneratorFileSampler::PrefetchLoop()
+{
+  std::unique_lock<std::mutex> lock(prefetchMutex);
+  while (true)
+    {
+      prefetchCondition.wait(lock, [this]{return stopPrefetching ||
+                                           (ringCount < ring.size() && !prefetchAtEnd && !prefetchException);});
+      if (stopPrefetching)
+        {break;}
+      G4long index      = nextPrefetchIndex;
+      G4long generation = prefetchGeneration;
+      G4bool read       = filterCache[(std::size_t)index] < 0; // unknown or passed
+      // the consumer only uses slots up to ringCount so the next one is free to fill
+      PrefetchedEvent& slot = ring[(ringHead + ringCount) % ring.size()];
+      lock.unlock();
+      std::exception_ptr exception = nullptr;
+      try
+        {
+          slot.particles.clear();
+          if (read)
+            {ReadParticles(index, slot.particles);}
+        }
+      catch (...)
+        {exception = std::current_exception();}
+      lock.lock();
+      if (exception)
+        {
+          prefetchException = exception;
+          prefetchCondition.notify_all();
+          continue;
+        }
+      if (generation != prefetchGeneration)
+        {continue;} // restarted while reading - this event isn't wanted
+      slot.index = index;
+      slot.read  = read;
+      ringCount++;
+      nextPrefetchIndex = index + 1;
+      if (nextPrefetchIndex >= nEventsInFile)
+        {
+          if (loopFile)
+            {nextPrefetchIndex = 0;}
+          else
+            {prefetchAtEnd = true;}
+        }
+      prefetchCondition.notify_all();
+    }
+}
+
+void BDSPrimaryGeneratorFileSampler::StopPrefetch()
+{
+  if (!prefetcher.joinable())
+    {return;}
+  {
+    std::lock_guard<std::mutex> lock(prefetchMutex);
+    stopPrefetching = true;
+  }
+  prefetchCondition.notify_all();
+  prefetcher.join();
 }
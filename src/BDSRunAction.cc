@@ -29,6 +29,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSOutput.hh"
 #include "BDSParser.hh"
 #include "BDSRunAction.hh"
+#include "BDSSDEnergyDeposition.hh"
 #include "BDSSamplerPlacementRecord.hh"
 #include "BDSSamplerRegistry.hh"
 #include "BDSWarning.hh"
@@ -176,6 +177,9 @@ void BDSRunAction::EndOfRunAction(const G4Run* aRun)
   output->CloseFile();
   info->Flush();
 
+  BDSAuxiliaryNavigator::PrintTransformCacheStatistics();
+  BDSSDEnergyDeposition::PrintFallbackStatistics();
+
   // note difftime only calculates to the integer second
   G4cout << __METHOD_NAME__ << "Run Duration >> " << (int)duration << " s" << G4endl;
 }
@@ -228,7 +232,9 @@ void BDSRunAction::SetTrajectorySamplerIDs() const
         {throw BDSException(__METHOD_NAME__, "Error: sampler \"" + tok + "\" named in the option storeTrajectorySamplerID was not found.");}
     }
 
-  eventAction->SetSamplerIDsForTrajectories(samplerIDs);
+  // a run action built without an event action (BuildForMaster) has nothing to set
+  if (eventAction)
+    {eventAction->SetSamplerIDsForTrajectories(samplerIDs);}
 }
 
 void BDSRunAction::CheckTrajectoryOptions() const
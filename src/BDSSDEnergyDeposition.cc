@@ -40,6 +40,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4VTouchable.hh"
 #include "Randomize.hh"
 
+G4ThreadLocal G4long BDSSDEnergyDeposition::nLookups              = 0;
+G4ThreadLocal G4long BDSSDEnergyDeposition::nFallbackPreStepPoint = 0;
+G4ThreadLocal G4long BDSSDEnergyDeposition::nFallbackShiftedPoint = 0;
+G4ThreadLocal G4long BDSSDEnergyDeposition::nFallbackFailed       = 0;
 
 BDSSDEnergyDeposition::BDSSDEnergyDeposition(const G4String& name,
                                              G4bool          storeExtrasIn,
@@ -60,6 +64,16 @@ BDSSDEnergyDeposition::~BDSSDEnergyDeposition()
   delete auxNavigator;
 }
 
+void BDSSDEnergyDeposition::PrintFallbackStatistics()
+{
+  if (nLookups == 0)
+    {return;}
+  G4cout << "BDSSDEnergyDeposition> volume info lookups: " << nLookups
+         << ", pre-step point fallbacks: " << nFallbackPreStepPoint
+         << ", shifted point fallbacks: "  << nFallbackShiftedPoint
+         << ", not found: "                << nFallbackFailed << G4endl;
+}
+
 void BDSSDEnergyDeposition::Initialize(G4HCofThisEvent* HCE)
 {
   hits = new BDSHitsCollectionEnergyDeposition(GetName(),colName);
@@ -127,8 +141,10 @@ G4bool BDSSDEnergyDeposition::ProcessHits(G4Step* aStep,
 
   // get the s coordinate (central s + local z)
   // volume is from curvilinear coordinate parallel geometry
-  BDSPhysicalVolumeInfo* theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal.VolumeForTransform());
+  const BDSPhysicalVolumeInfoRegistry* registry = BDSPhysicalVolumeInfoRegistry::Instance();
+  BDSPhysicalVolumeInfo* theInfo = registry->GetInfo(stepLocal.VolumeForTransform());
   G4int beamlineIndex = -1;
+  nLookups++;
   
   // declare lambda for updating parameters if info found (avoid duplication of code)
   G4double sBefore = -1000;
@@ -146,17 +162,19 @@ G4bool BDSSDEnergyDeposition::ProcessHits(G4Step* aStep,
   else
     {
       // Try again but with the pre step point only
+      nFallbackPreStepPoint++;
       G4ThreeVector unitDirection = (posafter - posbefore).unit();
       BDSStep stepLocal2 = auxNavigator->ConvertToLocal(posbefore, unitDirection);
-      theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal2.VolumeForTransform());
+      theInfo = registry->GetInfo(stepLocal2.VolumeForTransform());
       if (theInfo)
         {UpdateParams(theInfo);}
       else
         {
           // Try yet again with just a slight shift (100um is bigger than any padding space).
+          nFallbackShiftedPoint++;
           G4ThreeVector shiftedPos = posbefore + 0.1*CLHEP::mm*unitDirection;
           stepLocal2 = auxNavigator->ConvertToLocal(shiftedPos, unitDirection);
-          theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal2.VolumeForTransform());
+          theInfo = registry->GetInfo(stepLocal2.VolumeForTransform());
           if (theInfo)
             {UpdateParams(theInfo);}
           else
@@ -169,6 +187,7 @@ G4bool BDSSDEnergyDeposition::ProcessHits(G4Step* aStep,
               else
                 {G4cerr << "Unknown" << G4endl;}
 #endif
+              nFallbackFailed++;
               // unphysical default value to allow easy identification in output
               sAfter        = -1000;
               sBefore       = -1000;
@@ -255,8 +274,10 @@ G4bool BDSSDEnergyDeposition::ProcessHitsTrack(const G4Track* track,
   
   // get the s coordinate (central s + local z)
   // volume is from curvilinear coordinate parallel geometry
-  BDSPhysicalVolumeInfo* theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal.VolumeForTransform());
+  const BDSPhysicalVolumeInfoRegistry* registry = BDSPhysicalVolumeInfoRegistry::Instance();
+  BDSPhysicalVolumeInfo* theInfo = registry->GetInfo(stepLocal.VolumeForTransform());
   G4int beamlineIndex = -1;
+  nLookups++;
   
   // declare lambda for updating parameters if info found (avoid duplication of code)
   G4double sBefore = -1000;
@@ -274,9 +295,10 @@ G4bool BDSSDEnergyDeposition::ProcessHitsTrack(const G4Track* track,
   else
     {
       // Try yet again with just a slight shift (100um is bigger than any padding space).
+      nFallbackShiftedPoint++;
       G4ThreeVector shiftedPos = posGlobal + 0.1*CLHEP::mm * momGlobalUnit;
       BDSStep stepLocal2 = auxNavigator->ConvertToLocal(shiftedPos, momGlobalUnit);
-      theInfo = BDSPhysicalVolumeInfoRegistry::Instance()->GetInfo(stepLocal2.VolumeForTransform());
+      theInfo = registry->GetInfo(stepLocal2.VolumeForTransform());
       if (theInfo)
         {UpdateParams(theInfo);}
       else
@@ -289,6 +311,7 @@ G4bool BDSSDEnergyDeposition::ProcessHitsTrack(const G4Track* track,
           else
             {G4cerr << "Unknown" << G4endl;}
 #endif
+          nFallbackFailed++;
           // unphysical default value to allow easy identification in output
           sAfter        = -1000;
           sBefore       = -1000;
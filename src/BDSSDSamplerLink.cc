@@ -18,12 +18,16 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSDebug.hh"
 #include "BDSHitSamplerLink.hh"
+#include "BDSLinkEventInfo.hh"
 #include "BDSLinkRegistry.hh"
+#include "BDSLinkRunAction.hh"
 #include "BDSParticleCoordsFull.hh"
 #include "BDSPhysicsUtilities.hh"
 #include "BDSSDSamplerLink.hh"
 
 #include "G4DynamicParticle.hh"
+#include "G4Event.hh"
+#include "G4EventManager.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4SDManager.hh"
 #include "G4Step.hh"
@@ -44,6 +48,7 @@ BDSSDSamplerLink::BDSSDSamplerLink(const G4String& name):
   itsCollectionName(name),
   itsHCID(-1),
   registry(nullptr),
+  linkRunAction(nullptr),
   minimumEK(0),
   protonsAndIonsOnly(true)
 {
@@ -153,6 +158,15 @@ G4bool BDSSDSamplerLink::ProcessHits(G4Step* aStep, G4TouchableHistory* /*readOu
 			       energy,
 			       weight);
 
+  if (linkRunAction && linkRunAction->Batching())
+    {// write straight to the batch output without making a hit
+      auto eventInfo = static_cast<const BDSLinkEventInfo*>(G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetUserInformation());
+      linkRunAction->WriteToBatch(coords, mass, charge, PDGtype, z, a, parentID,
+				  eventInfo->externalParticleIDofPrimary,
+				  eventInfo->externalParentIDofPrimary);
+      return true;
+    }
+
   BDSHitSamplerLink* smpHit = new BDSHitSamplerLink(samplerID,
                                                     coords,
                                                     momentum,
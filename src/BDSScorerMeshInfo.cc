@@ -47,7 +47,7 @@ BDSScorerMeshInfo::BDSScorerMeshInfo(const GMAD::ScorerMesh& mesh)
   nBinsPhi = mesh.nphi;
   nBinsE = mesh.ne;
 
-  if (geometryType == "box")
+  if (geometryType == "box" || geometryType == "virtual")
     {
       if (!BDS::IsFinite(mesh.xsize))
         {throw BDSException(__METHOD_NAME__, "xsize must be > 0 and finite in mesh \"" + mesh.name + "\"");}
@@ -0,0 +1,281 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSHistBinMapper.hh"
+#include "BDSScorerMeshInfo.hh"
+#include "BDSScoringMeshVirtual.hh"
+
+#include "globals.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4Material.hh"
+#include "G4Point3D.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4THitsMap.hh"
+#include "G4Track.hh"
+#include "G4VPrimitiveScorer.hh"
+#include "G4VSDFilter.hh"
+
+#ifdef USE_BOOST
+#include <boost/variant.hpp>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+BDSScoringMeshVirtual::BDSScoringMeshVirtual(const G4String&          name,
+                                             const BDSScorerMeshInfo& recipe,
+                                             const G4Transform3D&     placementTransform):
+  G4VSensitiveDetector(name),
+  globalToLocal(placementTransform.inverse()),
+  halfSize(recipe.ScoringMeshX(), recipe.ScoringMeshY(), recipe.ScoringMeshZ()),
+  nBins{recipe.nBinsX, recipe.nBinsY, recipe.nBinsZ},
+  voxelVolume(1.0),
+  mapper(nullptr)
+{
+  for (G4int axis = 0; axis < 3; ++axis)
+    {
+      binWidth[axis] = 2 * halfSize[axis] / (G4double)nBins[axis];
+      voxelVolume *= binWidth[axis];
+    }
+#ifdef USE_BOOST
+  mapper = new BDSHistBinMapper(nBins[0], nBins[1], nBins[2], recipe.nBinsE, recipe.energyAxis);
+#else
+  mapper = new BDSHistBinMapper(nBins[0], nBins[1], nBins[2], recipe.nBinsE);
+#endif
+}
+
+BDSScoringMeshVirtual::~BDSScoringMeshVirtual()
+{
+  for (auto& quantity : quantities)
+    {delete quantity.scorer;}
+  delete mapper;
+}
+
+void BDSScoringMeshVirtual::AddScorer(G4VPrimitiveScorer*  scorer,
+                                      const BDSScorerType& scorerType)
+{
+  switch (scorerType.underlying())
+    {
+    case BDSScorerType::depositedenergy:
+    case BDSScorerType::depositedenergy3d:
+    case BDSScorerType::depositeddose:
+    case BDSScorerType::depositeddose3d:
+    case BDSScorerType::population:
+    case BDSScorerType::population3d:
+    case BDSScorerType::cellflux:
+    case BDSScorerType::cellflux3d:
+    case BDSScorerType::cellflux4d:
+      {break;}
+    default:
+      {
+        G4String msg = "scorer type \"" + scorerType.ToString() + "\" is not possible with a \"virtual\" mesh (\"";
+        msg += GetName() + "\") - use a \"box\" mesh instead";
+        throw BDSException(__METHOD_NAME__, msg);
+        break;
+      }
+    }
+  collectionName.insert(scorer->GetName());
+  quantities.push_back({scorer, scorerType, nullptr, {}});
+}
+
+void BDSScoringMeshVirtual::Initialize(G4HCofThisEvent* HCE)
+{
+  for (G4int i = 0; i < (G4int)quantities.size(); ++i)
+    {
+      auto& quantity = quantities[i];
+      quantity.hits = new G4THitsMap<G4double>(GetName(), GetCollectionName(i));
+      HCE->AddHitsCollection(GetCollectionID(i), quantity.hits);
+      quantity.cellAndTrackIDs.clear();
+    }
+}
+
+template <typename F>
+void BDSScoringMeshVirtual::Traverse(const G4ThreeVector& a,
+                                     const G4ThreeVector& b,
+                                     F&&                  visit) const
+{
+  G4ThreeVector d = b - a;
+  if (d.mag2() == 0)
+    {// no length but possibly energy deposited at rest
+      G4int cell[3];
+      for (G4int axis = 0; axis < 3; ++axis)
+        {
+          if (a[axis] < 0 || a[axis] > 2 * halfSize[axis])
+            {return;}
+          cell[axis] = std::min((G4int)(a[axis] / binWidth[axis]), nBins[axis] - 1);
+        }
+      visit(cell[0], cell[1], cell[2], 1.0);
+      return;
+    }
+
+  // clip the line a + t*d, t = [0,1] to the mesh
+  G4double tEnter = 0;
+  G4double tExit  = 1;
+  for (G4int axis = 0; axis < 3; ++axis)
+    {
+      G4double size = 2 * halfSize[axis];
+      if (d[axis] == 0)
+        {
+          if (a[axis] < 0 || a[axis] > size)
+            {return;}
+          continue;
+        }
+      G4double t0 = -a[axis] / d[axis];
+      G4double t1 = (size - a[axis]) / d[axis];
+      if (t0 > t1)
+        {std::swap(t0, t1);}
+      tEnter = std::max(tEnter, t0);
+      tExit  = std::min(tExit,  t1);
+    }
+  if (tExit <= tEnter)
+    {return;}
+
+  // voxel of the entry point and the parametric distance to the next boundary on each axis
+  const G4double infinity = std::numeric_limits<G4double>::infinity();
+  G4int    cell[3];
+  G4int    direction[3];
+  G4double tNextBoundary[3];
+  G4double tDelta[3];
+  for (G4int axis = 0; axis < 3; ++axis)
+    {
+      G4double entry = a[axis] + tEnter * d[axis];
+      cell[axis] = std::max(0, std::min((G4int)std::floor(entry / binWidth[axis]), nBins[axis] - 1));
+      if (d[axis] > 0)
+        {
+          direction[axis]     = 1;
+          tNextBoundary[axis] = ((cell[axis] + 1) * binWidth[axis] - a[axis]) / d[axis];
+          tDelta[axis]        = binWidth[axis] / d[axis];
+        }
+      else if (d[axis] < 0)
+        {
+          direction[axis]     = -1;
+          tNextBoundary[axis] = (cell[axis] * binWidth[axis] - a[axis]) / d[axis];
+          tDelta[axis]        = -binWidth[axis] / d[axis];
+        }
+      else
+        {
+          direction[axis]     = 0;
+          tNextBoundary[axis] = infinity;
+          tDelta[axis]        = infinity;
+        }
+    }
+
+  G4double t = tEnter;
+  while (true)
+    {
+      G4int axis = 0;
+      if (tNextBoundary[1] < tNextBoundary[axis])
+        {axis = 1;}
+      if (tNextBoundary[2] < tNextBoundary[axis])
+        {axis = 2;}
+      G4double tNext = std::min(tNextBoundary[axis], tExit);
+      if (tNext > t)
+        {visit(cell[0], cell[1], cell[2], tNext - t);}
+      if (tNext >= tExit)
+        {break;}
+      t = tNext;
+      cell[axis] += direction[axis];
+      if (cell[axis] < 0 || cell[axis] >= nBins[axis])
+        {break;}
+      tNextBoundary[axis] += tDelta[axis];
+    }
+}
+
+void BDSScoringMeshVirtual::ScoreStep(const G4Step* step)
+{
+  const G4StepPoint* preStepPoint  = step->GetPreStepPoint();
+  const G4StepPoint* postStepPoint = step->GetPostStepPoint();
+
+  // mesh frame with the origin at the low corner
+  G4Point3D preLocal  = globalToLocal * G4Point3D(preStepPoint->GetPosition());
+  G4Point3D postLocal = globalToLocal * G4Point3D(postStepPoint->GetPosition());
+  G4ThreeVector a = G4ThreeVector(preLocal.x(),  preLocal.y(),  preLocal.z())  + halfSize;
+  G4ThreeVector b = G4ThreeVector(postLocal.x(), postLocal.y(), postLocal.z()) + halfSize;
+
+  // quick rejection if both points are beyond the same face
+  for (G4int axis = 0; axis < 3; ++axis)
+    {
+      G4double size = 2 * halfSize[axis];
+      if ((a[axis] < 0 && b[axis] < 0) || (a[axis] > size && b[axis] > size))
+        {return;}
+    }
+
+  std::vector<Quantity*> accepted;
+  for (auto& quantity : quantities)
+    {
+      const G4VSDFilter* filter = quantity.scorer->GetFilter();
+      if (!filter || filter->Accept(step))
+        {accepted.push_back(&quantity);}
+    }
+  if (accepted.empty())
+    {return;}
+
+  G4double weight     = preStepPoint->GetWeight();
+  G4double energy     = step->GetTotalEnergyDeposit();
+  G4double stepLength = step->GetStepLength();
+  G4double density    = preStepPoint->GetMaterial()->GetDensity();
+  G4int    trackID    = step->GetTrack()->GetTrackID();
+
+  // energy bin as BDSPSCellFlux4D
+  G4int l = 0;
+#ifdef USE_BOOST
+  if (mapper->NBinsL() > 1)
+    {
+      double kineticEnergy = postStepPoint->GetKineticEnergy();
+      l = boost::apply_visitor([&kineticEnergy](auto&& one){return (decltype(one)(one))->index(kineticEnergy);}, mapper->GetEnergyAxis()) + 1;
+    }
+#endif
+
+  auto visit = [&](G4int i, G4int j, G4int k, G4double fraction)
+    {
+      G4int index = mapper->GlobalFromIJKLIndex(i, j, k, l);
+      for (auto quantity : accepted)
+        {
+          G4double value = 0;
+          switch (quantity->type.underlying())
+            {
+            case BDSScorerType::depositedenergy:
+            case BDSScorerType::depositedenergy3d:
+              {value = energy * fraction * weight; break;}
+            case BDSScorerType::depositeddose:
+            case BDSScorerType::depositeddose3d:
+              {
+                if (density > 0)
+                  {value = energy * fraction * weight / (density * voxelVolume);}
+                break;
+              }
+            case BDSScorerType::population:
+            case BDSScorerType::population3d:
+              {// count each track once per voxel
+                if (quantity->cellAndTrackIDs.insert(std::make_pair(index, trackID)).second)
+                  {value = weight;}
+                break;
+              }
+            default: // cell flux
+              {value = stepLength * fraction * weight / voxelVolume; break;}
+            }
+          if (value != 0)
+            {quantity->hits->add(index, value);}
+        }
+    };
+  Traverse(a, b, visit);
+}
@@ -16,6 +16,7 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSScoringMeshVirtual.hh"
 #include "BDSSteppingAction.hh"
 #include "BDSUtilities.hh"
 
@@ -32,15 +33,18 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 BDSSteppingAction::BDSSteppingAction():
   verboseStep(false),
   verboseEventStart(false),
-  verboseEventStop(false)
+  verboseEventStop(false),
+  virtualMeshes(nullptr)
 {;}
 
 BDSSteppingAction::BDSSteppingAction(G4bool verboseStepIn,
 				     G4int  verboseEventStartIn,
-				     G4int  verboseEventStopIn):
+				     G4int  verboseEventStopIn,
+				     const std::vector<BDSScoringMeshVirtual*>* virtualMeshesIn):
   verboseStep(verboseStepIn),
   verboseEventStart(verboseEventStartIn),
-  verboseEventStop(verboseEventStopIn)
+  verboseEventStop(verboseEventStopIn),
+  virtualMeshes(virtualMeshesIn)
 {;}
 
 BDSSteppingAction::~BDSSteppingAction()
@@ -48,6 +52,11 @@ BDSSteppingAction::~BDSSteppingAction()
 
 void BDSSteppingAction::UserSteppingAction(const G4Step* step)
 {
+  if (virtualMeshes)
+    {
+      for (auto mesh : *virtualMeshes)
+        {mesh->ScoreStep(step);}
+    }
   if (!verboseStep)
     {return;}
   G4int eventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
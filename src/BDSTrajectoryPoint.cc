@@ -48,6 +48,9 @@ class G4Material;
 
 G4Allocator<BDSTrajectoryPoint> bdsTrajectoryPointAllocator;
 
+G4ThreadLocal std::size_t BDS::trajectoryPointBytes     = 0;
+G4ThreadLocal std::size_t BDS::trajectoryPointBytesPeak = 0;
+
 G4double BDSTrajectoryPoint::dEThresholdForScattering = 1e-8;
 
 // Don't use transform caching in the aux navigator as it's used for all over the geometry here.
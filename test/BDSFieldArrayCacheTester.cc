@@ -0,0 +1,82 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSException.hh"
+#include "BDSFieldArrayCache.hh"
+#include "BDSFieldFormat.hh"
+#include "BDSFieldInfo.hh"
+#include "BDSFieldLoader.hh"
+#include "BDSFieldMag.hh"
+#include "BDSFieldType.hh"
+#include "BDSIntegratorType.hh"
+#include "BDSInterpolatorType.hh"
+
+#include "G4Transform3D.hh"
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+/// Load a field map, delete the field and the field loader as when a model is torn
+/// down (e.g. BDSIMLink), then build the field again. The second build must reuse
+/// the array in BDSFieldArrayCache rather than loading the file again.
+int main(int /*argc*/, char** /*argv*/)
+{
+  const std::string exampleFile2D = "../examples/features/fields/maps_bdsim/2dexample.dat";
+  BDSFieldInfo info(BDSFieldType::bmap2d,
+                    0,
+                    BDSIntegratorType::g4classicalrk4,
+                    nullptr,
+                    false,
+                    G4Transform3D(),
+                    exampleFile2D,
+                    BDSFieldFormat::bdsim2d,
+                    BDSInterpolatorType::linear2d);
+
+  BDSFieldArrayCache* cache = BDSFieldArrayCache::Instance();
+  try
+    {
+      BDSFieldMag* first = BDSFieldLoader::Instance()->LoadMagField(info);
+      delete first;
+      delete BDSFieldLoader::Instance();
+      if (cache->NArrays() != 1)
+        {std::cerr << "array not kept once unused" << std::endl; return 1;}
+
+      BDSFieldMag* second = BDSFieldLoader::Instance()->LoadMagField(info);
+      if (cache->NHits() != 1 || cache->NMisses() != 1)
+        {
+          std::cerr << "second build did not reuse the array: hits " << cache->NHits()
+                    << ", misses " << cache->NMisses() << std::endl;
+          return 1;
+        }
+      delete second;
+      delete BDSFieldLoader::Instance();
+
+      cache->EvictUnusedArrays();
+      if (cache->NArrays() != 0)
+        {std::cerr << "unused array not evicted" << std::endl; return 1;}
+    }
+  catch (const BDSException& e)
+    {std::cerr << e.what() << std::endl; return 1;}
+  catch (const std::exception& e)
+    {std::cerr << e.what() << std::endl; return 1;}
+
+  cache->PrintStatistics();
+  delete cache;
+  return 0;
+}
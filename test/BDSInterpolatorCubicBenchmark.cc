@@ -0,0 +1,177 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray3DCoords.hh"
+#include "BDSArray4DCoords.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3DCubic.hh"
+#include "BDSInterpolator3DCubicCoeff.hh"
+#include "BDSInterpolator4DCubic.hh"
+#include "BDSInterpolatorRoutines.hh"
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/// Microbenchmark comparing the cubic interpolators, which read the data directly
+/// from the array, with the general routine that first copies the points into a
+/// local array through the (virtual) array accessors. The 3D interpolator with
+/// precomputed coefficients is also compared. Checks that all agree.
+
+namespace
+{
+  const G4int nQueries = 2000000;
+  const G4double tolerance = 1e-4;
+
+  void Fill(BDSArray4D& array, std::mt19937& generator)
+  {
+    std::uniform_real_distribution<G4double> dist(-1, 1);
+    for (G4int l = 0; l < array.NT(); l++)
+      {
+        for (G4int k = 0; k < array.NZ(); k++)
+          {
+            for (G4int j = 0; j < array.NY(); j++)
+              {
+                for (G4int i = 0; i < array.NX(); i++)
+                  {array(i,j,k,l) = BDSFieldValue(dist(generator), dist(generator), dist(generator));}
+              }
+          }
+      }
+  }
+
+  G4double Seconds(const std::chrono::high_resolution_clock::time_point& start)
+  {
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<G4double>(stop - start).count();
+  }
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<G4double> coord(-0.9, 0.9);
+  G4int result = 0;
+
+  // 3D
+  BDSArray3DCoords array3d(40, 40, 40, -1, 1, -1, 1, -1, 1);
+  Fill(array3d, generator);
+  BDSInterpolator3DCubic interpolator3d(&array3d);
+
+  std::vector<G4ThreeVector> points(nQueries);
+  for (auto& p : points)
+    {p = G4ThreeVector(coord(generator), coord(generator), coord(generator));}
+
+  G4double sumReference = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (const auto& p : points)
+    {
+      BDSFieldValue localData[4][4][4];
+      G4double xFrac, yFrac, zFrac;
+      array3d.ExtractSection4x4x4(p.x(), p.y(), p.z(), localData, xFrac, yFrac, zFrac);
+      sumReference += BDS::Cubic3D(localData, xFrac, yFrac, zFrac).x();
+    }
+  G4double timeReference = Seconds(start);
+
+  G4double sumDirect = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (const auto& p : points)
+    {sumDirect += interpolator3d.GetInterpolatedValue(p.x(), p.y(), p.z()).x();}
+  G4double timeDirect = Seconds(start);
+
+  G4cout << "3D cubic: general " << timeReference << " s, direct " << timeDirect << " s, speed up x"
+         << timeReference / timeDirect << " (" << sumReference << ", " << sumDirect << ")" << G4endl;
+
+  G4double maxDifference = 0;
+  for (G4int i = 0; i < 10000; i++)
+    {
+      const auto& p = points[i];
+      BDSFieldValue localData[4][4][4];
+      G4double xFrac, yFrac, zFrac;
+      array3d.ExtractSection4x4x4(p.x(), p.y(), p.z(), localData, xFrac, yFrac, zFrac);
+      BDSFieldValue ref = BDS::Cubic3D(localData, xFrac, yFrac, zFrac);
+      G4ThreeVector v = interpolator3d.GetInterpolatedValue(p.x(), p.y(), p.z());
+      G4ThreeVector diff = v - G4ThreeVector(ref.x(), ref.y(), ref.z());
+      maxDifference = std::max(maxDifference, diff.mag());
+    }
+  G4cout << "3D cubic: maximum difference " << maxDifference << G4endl;
+  if (maxDifference > tolerance)
+    {result = 1;}
+
+  // 3D with precomputed coefficients
+  BDSInterpolator3DCubicCoeff interpolator3dCoeff(&array3d);
+  G4double sumCoeff = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (const auto& p : points)
+    {sumCoeff += interpolator3dCoeff.GetInterpolatedValue(p.x(), p.y(), p.z()).x();}
+  G4double timeCoeff = Seconds(start);
+  G4cout << "3D cubic coefficients: " << timeCoeff << " s, speed up x" << timeReference / timeCoeff
+         << " (" << sumCoeff << ")" << G4endl;
+
+  maxDifference = 0;
+  for (G4int i = 0; i < 10000; i++)
+    {
+      const auto& p = points[i];
+      G4ThreeVector diff = interpolator3dCoeff.GetInterpolatedValue(p.x(), p.y(), p.z())
+	- interpolator3d.GetInterpolatedValue(p.x(), p.y(), p.z());
+      maxDifference = std::max(maxDifference, diff.mag());
+    }
+  G4cout << "3D cubic coefficients: maximum difference " << maxDifference << G4endl;
+  if (maxDifference > tolerance)
+    {result = 1;}
+
+  // 4D
+  BDSArray4DCoords array4d(20, 20, 20, 20, -1, 1, -1, 1, -1, 1, -1, 1);
+  Fill(array4d, generator);
+  BDSInterpolator4DCubic interpolator4d(&array4d);
+  std::vector<G4double> times(nQueries / 4);
+  for (auto& t : times)
+    {t = coord(generator);}
+
+  sumReference = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (G4int i = 0; i < (G4int)times.size(); i++)
+    {
+      const auto& p = points[i];
+      BDSFieldValue localData[4][4][4][4];
+      G4double xFrac, yFrac, zFrac, tFrac;
+      array4d.ExtractSection4x4x4x4(p.x(), p.y(), p.z(), times[i], localData, xFrac, yFrac, zFrac, tFrac);
+      sumReference += BDS::Cubic4D(localData, xFrac, yFrac, zFrac, tFrac).x();
+    }
+  timeReference = Seconds(start);
+
+  sumDirect = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (G4int i = 0; i < (G4int)times.size(); i++)
+    {
+      const auto& p = points[i];
+      sumDirect += interpolator4d.GetInterpolatedValue(p.x(), p.y(), p.z(), times[i]).x();
+    }
+  timeDirect = Seconds(start);
+
+  G4cout << "4D cubic: general " << timeReference << " s, direct " << timeDirect << " s, speed up x"
+         << timeReference / timeDirect << " (" << sumReference << ", " << sumDirect << ")" << G4endl;
+  if (std::abs(sumReference - sumDirect) > tolerance * (G4double)times.size())
+    {result = 1;}
+
+  return result;
+}
@@ -0,0 +1,221 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSParticleDefinition.hh"
+#include "BDSPTCOneTurnMap.hh"
+#include "BDSUtilities.hh"
+
+#include "globals.hh"
+#include "G4Proton.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Microbenchmark of the one turn map evaluation. A 12th order map with the
+/// structure of an LHC one turn map (5D, mid-plane symmetric with deltaP unchanged)
+/// is written and loaded. The compiled single particle and batch evaluations are
+/// compared to evaluating each output term by term with std::pow as was done
+/// previously. Checks that all agree.
+
+namespace
+{
+  const G4int order = 12;
+  const G4int nParticles = 2000;
+  const G4double tolerance = 1e-12;
+
+  struct Term
+  {
+    G4double coefficient;
+    std::array<G4int, 5> n;
+  };
+
+  /// Write the map table and keep the terms for each output for the reference evaluation.
+  void WriteMap(const std::string& fileName,
+                std::array<std::vector<Term>, 5>& terms,
+                std::mt19937& generator)
+  {
+    std::uniform_real_distribution<G4double> dist(-1, 1);
+    // betatron rotation for the linear part
+    const G4double mu = 2 * M_PI * 0.31;
+    const G4double linear[4][4] = {{ std::cos(mu), 100*std::sin(mu), 0, 0},
+                                   {-std::sin(mu)/100, std::cos(mu), 0, 0},
+                                   {0, 0,  std::cos(mu), 100*std::sin(mu)},
+                                   {0, 0, -std::sin(mu)/100, std::cos(mu)}};
+    for (G4int nx = 0; nx <= order; nx++)
+      {
+        for (G4int npx = 0; npx <= order - nx; npx++)
+          {
+            for (G4int ny = 0; ny <= order - nx - npx; ny++)
+              {
+                for (G4int npy = 0; npy <= order - nx - npx - ny; npy++)
+                  {
+                    for (G4int nd = 0; nd <= order - nx - npx - ny - npy; nd++)
+                      {
+                        G4int total = nx + npx + ny + npy + nd;
+                        if (total == 0)
+                          {continue;}
+                        std::array<G4int, 5> n = {nx, npx, ny, npy, nd};
+                        G4bool verticalEven = (ny + npy) % 2 == 0;
+                        for (G4int v = 0; v < 4; v++)
+                          {
+                            // x and px only have even powers of the vertical coordinates
+                            if (verticalEven != (v < 2))
+                              {continue;}
+                            G4double c = dist(generator) * std::pow(10.0, total - 1);
+                            if (total == 1)
+                              {
+                                G4int index = nx ? 0 : (npx ? 1 : (ny ? 2 : (npy ? 3 : 4)));
+                                c = index < 4 ? linear[v][index] : 0.1 * dist(generator);
+                                if (!BDS::IsFinite(c))
+                                  {continue;}
+                              }
+                            terms[v].push_back({c, n});
+                          }
+                      }
+                  }
+              }
+          }
+      }
+    terms[4].push_back({1.0, {0, 0, 0, 0, 1}});
+
+    std::ofstream file(fileName);
+    file << "@ NAME             %05s \"MAP\"" << std::endl;
+    file << "* NAME COEF ORDER DIM TOTAL NX NPX NY NPY NDELTAP NT" << std::endl;
+    file << "$ %s %le %d %d %d %d %d %d %d %d %d" << std::endl;
+    file.precision(17);
+    for (G4int v = 0; v < 5; v++)
+      {
+        for (const auto& t : terms[v])
+          {
+            G4int total = t.n[0] + t.n[1] + t.n[2] + t.n[3] + t.n[4];
+            file << " \"MAP\" " << t.coefficient << " " << v + 1 << " 6 " << total;
+            for (auto ni : t.n)
+              {file << " " << ni;}
+            file << " 0" << std::endl;
+          }
+      }
+  }
+
+  G4double Reference(const std::vector<Term>& terms, const std::array<G4double, 5>& c)
+  {
+    G4double result = 0;
+    for (const auto& t : terms)
+      {
+        result += t.coefficient
+          * std::pow(c[0], t.n[0])
+          * std::pow(c[1], t.n[1])
+          * std::pow(c[2], t.n[2])
+          * std::pow(c[3], t.n[3])
+          * std::pow(c[4], t.n[4]);
+      }
+    return result;
+  }
+
+  G4double Seconds(const std::chrono::high_resolution_clock::time_point& start)
+  {
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<G4double>(stop - start).count();
+  }
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+  std::mt19937 generator(1234);
+  G4int result = 0;
+
+  std::array<std::vector<Term>, 5> terms;
+  std::string fileName = BDS::GetCurrentDir() + "/ptc_otm_order12.tfs";
+  WriteMap(fileName, terms, generator);
+  std::size_t nTerms = 0;
+  for (const auto& t : terms)
+    {nTerms += t.size();}
+
+  BDSParticleDefinition designParticle(G4Proton::ProtonDefinition(), 6.5*CLHEP::TeV, 0, 0, 1);
+  BDSPTCOneTurnMap otm(fileName, &designParticle);
+  G4cout << "Order " << otm.MaximumOrder() << " map: " << nTerms << " terms, "
+         << otm.NMonomials() << " unique monomials" << G4endl;
+
+  // halo-like coordinates in PTC units
+  std::normal_distribution<G4double> position(0, 1e-3);
+  std::normal_distribution<G4double> angle(0, 1e-5);
+  std::normal_distribution<G4double> momentum(0, 1e-4);
+  std::vector<std::array<G4double, 5>> particles(nParticles);
+  for (auto& p : particles)
+    {p = {position(generator), angle(generator), position(generator), angle(generator), momentum(generator)};}
+
+  std::vector<std::array<G4double, 5>> reference(nParticles);
+  auto start = std::chrono::high_resolution_clock::now();
+  for (G4int i = 0; i < nParticles; i++)
+    {
+      for (G4int v = 0; v < 5; v++)
+        {reference[i][v] = Reference(terms[v], particles[i]);}
+    }
+  G4double timeReference = Seconds(start);
+
+  std::vector<std::array<G4double, 5>> compiled(nParticles);
+  start = std::chrono::high_resolution_clock::now();
+  for (G4int i = 0; i < nParticles; i++)
+    {otm.Evaluate(particles[i].data(), compiled[i].data());}
+  G4double timeCompiled = Seconds(start);
+
+  std::array<std::vector<G4double>, 5> batch;
+  for (G4int v = 0; v < 5; v++)
+    {
+      batch[v].resize(nParticles);
+      for (G4int i = 0; i < nParticles; i++)
+        {batch[v][i] = particles[i][v];}
+    }
+  start = std::chrono::high_resolution_clock::now();
+  otm.EvaluateBatch(nParticles, batch[0].data(), batch[1].data(), batch[2].data(), batch[3].data(), batch[4].data());
+  G4double timeBatch = Seconds(start);
+
+  G4cout << "Term by term " << timeReference << " s, compiled " << timeCompiled << " s (x"
+         << timeReference / timeCompiled << "), batch " << timeBatch << " s (x"
+         << timeReference / timeBatch << ") for " << nParticles << " particles" << G4endl;
+
+  // compare relative to the largest value of each output as individual values may cancel
+  std::array<G4double, 5> scale = {1e-300, 1e-300, 1e-300, 1e-300, 1e-300};
+  for (const auto& r : reference)
+    {
+      for (G4int v = 0; v < 5; v++)
+        {scale[v] = std::max(scale[v], std::abs(r[v]));}
+    }
+  G4double maxDifference = 0;
+  G4double maxDifferenceBatch = 0;
+  for (G4int i = 0; i < nParticles; i++)
+    {
+      for (G4int v = 0; v < 5; v++)
+        {
+          maxDifference = std::max(maxDifference, std::abs(compiled[i][v] - reference[i][v]) / scale[v]);
+          maxDifferenceBatch = std::max(maxDifferenceBatch, std::abs(batch[v][i] - reference[i][v]) / scale[v]);
+        }
+    }
+  G4cout << "Maximum relative difference: compiled " << maxDifference << ", batch " << maxDifferenceBatch << G4endl;
+  if (maxDifference > tolerance || maxDifferenceBatch > tolerance)
+    {result = 1;}
+
+  return result;
+}